@@ -0,0 +1,323 @@
+/**
+ * @file bench.c
+ * @brief Scheduler and IPC latencies of the POSIX port
+ *
+ * Measures the latency of a context switch, a queue round trip, the hand over
+ * of a mutex, a binary semaphore ping-pong, a task notification and the
+ * jitter of vTaskDelayUntil(). Each sample is timed with CLOCK_MONOTONIC and
+ * the results are written as JSON, to the given file or else to stdout, so
+ * that builds can be compared.
+ * Usage: freertos_bench [iterations] [periods] [file]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "bench_common.h"
+
+#define BENCH_DEFAULT_ITERATIONS 10000
+#define BENCH_DEFAULT_PERIODS 1000
+
+#define BENCH_LOW_PRIORITY (tskIDLE_PRIORITY + 1)
+#define BENCH_HIGH_PRIORITY (tskIDLE_PRIORITY + 2)
+
+static unsigned long ulIterations = BENCH_DEFAULT_ITERATIONS;
+static unsigned long ulPeriods = BENCH_DEFAULT_PERIODS;
+static const char *pcOutput = NULL;
+
+static TaskHandle_t xBenchTask = NULL;
+static TaskHandle_t xHighTask = NULL;
+static QueueHandle_t xRequests = NULL;
+static QueueHandle_t xReplies = NULL;
+static SemaphoreHandle_t xMutex = NULL;
+static SemaphoreHandle_t xPing = NULL;
+static SemaphoreHandle_t xPong = NULL;
+
+/* Samples in nanoseconds, one per iteration of the running benchmark. */
+static unsigned long *pulSamples = NULL;
+static volatile unsigned long ulSample = 0;
+static volatile unsigned long ulStartNs = 0;
+
+/*
+ * Lets the benchmark task know that the calling task is done and waits to be
+ * deleted by it.
+ */
+static void prvFinished(void)
+{
+    xTaskNotifyGive(xBenchTask);
+    vTaskSuspend(NULL);
+}
+
+/*
+ * Two tasks of the same priority yielding to each other, a sample is the time
+ * from one task yielding to the other running.
+ */
+static void vYieldTask(void *pvParameters)
+{
+    while (ulSample < ulIterations) {
+        ulStartNs = ulBenchNowNs();
+        taskYIELD();
+        /* Time slicing must not switch to the other task, which sets a new
+         * start and takes samples as well, while a sample is taken. */
+        taskENTER_CRITICAL();
+        if (ulSample < ulIterations) {
+            pulSamples[ulSample++] = ulBenchNowNs() - ulStartNs;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    prvFinished();
+}
+
+/*
+ * Sends a request to the higher priority echo task and waits for its reply.
+ */
+static void vQueueClientTask(void *pvParameters)
+{
+    unsigned long ulStart, ulMessage;
+
+    for (ulSample = 0; ulSample < ulIterations; ulSample++) {
+        ulMessage = ulSample;
+        ulStart = ulBenchNowNs();
+        xQueueSend(xRequests, &ulMessage, portMAX_DELAY);
+        xQueueReceive(xReplies, &ulMessage, portMAX_DELAY);
+        pulSamples[ulSample] = ulBenchNowNs() - ulStart;
+    }
+
+    prvFinished();
+}
+
+static void vQueueEchoTask(void *pvParameters)
+{
+    unsigned long ulMessage;
+
+    for (;;) {
+        xQueueReceive(xRequests, &ulMessage, portMAX_DELAY);
+        xQueueSend(xReplies, &ulMessage, portMAX_DELAY);
+    }
+}
+
+/*
+ * Holds the mutex while the higher priority task blocks on it, a sample is
+ * the time from giving the mutex to the waiting task running with it.
+ */
+static void vMutexOwnerTask(void *pvParameters)
+{
+    while (ulSample < ulIterations) {
+        xSemaphoreTake(xMutex, portMAX_DELAY);
+        xTaskNotifyGive(xHighTask);
+        ulStartNs = ulBenchNowNs();
+        xSemaphoreGive(xMutex);
+    }
+
+    prvFinished();
+}
+
+static void vMutexWaiterTask(void *pvParameters)
+{
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        xSemaphoreTake(xMutex, portMAX_DELAY);
+        pulSamples[ulSample++] = ulBenchNowNs() - ulStartNs;
+        xSemaphoreGive(xMutex);
+    }
+}
+
+/*
+ * Gives the ping to the higher priority task and takes its pong.
+ */
+static void vPingTask(void *pvParameters)
+{
+    unsigned long ulStart;
+
+    for (ulSample = 0; ulSample < ulIterations; ulSample++) {
+        ulStart = ulBenchNowNs();
+        xSemaphoreGive(xPing);
+        xSemaphoreTake(xPong, portMAX_DELAY);
+        pulSamples[ulSample] = ulBenchNowNs() - ulStart;
+    }
+
+    prvFinished();
+}
+
+static void vPongTask(void *pvParameters)
+{
+    for (;;) {
+        xSemaphoreTake(xPing, portMAX_DELAY);
+        xSemaphoreGive(xPong);
+    }
+}
+
+/*
+ * Notifies the higher priority task, a sample is the time from the
+ * notification to the notified task running.
+ */
+static void vNotifierTask(void *pvParameters)
+{
+    while (ulSample < ulIterations) {
+        ulStartNs = ulBenchNowNs();
+        xTaskNotifyGive(xHighTask);
+    }
+
+    prvFinished();
+}
+
+static void vNotifiedTask(void *pvParameters)
+{
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        pulSamples[ulSample++] = ulBenchNowNs() - ulStartNs;
+    }
+}
+
+/*
+ * Wakes every tick, a sample is how far the time between two wake ups is off
+ * the tick period.
+ */
+static void vPeriodicTask(void *pvParameters)
+{
+    const long lPeriodNs = 1000000000L / configTICK_RATE_HZ;
+    TickType_t xLastWake;
+    unsigned long ulLast, ulNow;
+    long lError;
+
+    vTaskDelay(1);
+    xLastWake = xTaskGetTickCount();
+    ulLast = ulBenchNowNs();
+
+    for (ulSample = 0; ulSample < ulPeriods; ulSample++) {
+        vTaskDelayUntil(&xLastWake, 1);
+        ulNow = ulBenchNowNs();
+        lError = (long)(ulNow - ulLast) - lPeriodNs;
+        pulSamples[ulSample] = (lError < 0) ? -lError : lError;
+        ulLast = ulNow;
+    }
+
+    prvFinished();
+}
+
+static int prvCompareSamples(const void *pvA, const void *pvB)
+{
+    unsigned long ulA = *(const unsigned long *)pvA;
+    unsigned long ulB = *(const unsigned long *)pvB;
+
+    return (ulA > ulB) - (ulA < ulB);
+}
+
+/*
+ * Runs pxLow, and pxHigh at uxHighPriority if given, until pxLow is done and
+ * writes the statistics of its samples as a JSON object.
+ */
+static void prvRun(FILE *pxFile, const char *pcName, TaskFunction_t pxLow,
+                   TaskFunction_t pxHigh, UBaseType_t uxHighPriority,
+                   unsigned long ulCount, const char *pcSeparator)
+{
+    TaskHandle_t xLowTask = NULL;
+    double dSum = 0;
+    unsigned long i;
+
+    ulSample = 0;
+    xHighTask = NULL;
+    if (pxHigh != NULL) {
+        xTaskCreate(pxHigh, "High", configMINIMAL_STACK_SIZE, NULL,
+                    uxHighPriority, &xHighTask);
+    }
+    xTaskCreate(pxLow, "Low", configMINIMAL_STACK_SIZE, NULL,
+                BENCH_LOW_PRIORITY, &xLowTask);
+
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    vTaskDelete(xLowTask);
+    if (xHighTask != NULL) {
+        vTaskDelete(xHighTask);
+    }
+    /* Let the idle task free the deleted tasks. */
+    vTaskDelay(2);
+
+    qsort(pulSamples, ulCount, sizeof(unsigned long), prvCompareSamples);
+    for (i = 0; i < ulCount; i++) {
+        dSum += pulSamples[i];
+    }
+
+    fprintf(pxFile,
+            "    {\"name\": \"%s\", \"unit\": \"ns\", \"samples\": %lu, "
+            "\"min\": %lu, \"mean\": %.1f, \"p50\": %lu, \"p99\": %lu, "
+            "\"max\": %lu}%s\n",
+            pcName, ulCount, pulSamples[0], dSum / ulCount,
+            pulSamples[ulCount / 2], pulSamples[ulCount * 99 / 100],
+            pulSamples[ulCount - 1], pcSeparator);
+}
+
+static void vBenchTask(void *pvParameters)
+{
+    FILE *pxFile = stdout;
+
+    if (pcOutput != NULL) {
+        pxFile = fopen(pcOutput, "w");
+        if (pxFile == NULL) {
+            perror(pcOutput);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    fprintf(pxFile, "{\n");
+#if defined(portGET_CORE_ID)
+    fprintf(pxFile, "  \"port\": \"Posix_SingleThread\",\n");
+#else
+    fprintf(pxFile, "  \"port\": \"Posix\",\n");
+#endif
+    fprintf(pxFile, "  \"cores\": %d,\n", configNUMBER_OF_CORES);
+    fprintf(pxFile, "  \"tick_rate_hz\": %u,\n", (unsigned)configTICK_RATE_HZ);
+    fprintf(pxFile, "  \"results\": [\n");
+
+    prvRun(pxFile, "context_switch", vYieldTask, vYieldTask,
+           BENCH_LOW_PRIORITY, ulIterations, ",");
+    prvRun(pxFile, "queue_round_trip", vQueueClientTask, vQueueEchoTask,
+           BENCH_HIGH_PRIORITY, ulIterations, ",");
+    prvRun(pxFile, "mutex_handover", vMutexOwnerTask, vMutexWaiterTask,
+           BENCH_HIGH_PRIORITY, ulIterations, ",");
+    prvRun(pxFile, "binary_semaphore_ping_pong", vPingTask, vPongTask,
+           BENCH_HIGH_PRIORITY, ulIterations, ",");
+    prvRun(pxFile, "task_notification", vNotifierTask, vNotifiedTask,
+           BENCH_HIGH_PRIORITY, ulIterations, ",");
+    prvRun(pxFile, "delay_until_jitter", vPeriodicTask, NULL, 0, ulPeriods,
+           "");
+
+    fprintf(pxFile, "  ]\n}\n");
+    fclose(pxFile);
+
+    exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1) {
+        ulIterations = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        ulPeriods = strtoul(argv[2], NULL, 10);
+    }
+    if (argc > 3) {
+        pcOutput = argv[3];
+    }
+    if ((ulIterations == 0) || (ulPeriods == 0)) {
+        fprintf(stderr, "Usage: %s [iterations] [periods] [file]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    pulSamples = calloc((ulIterations > ulPeriods) ? ulIterations : ulPeriods,
+                        sizeof(unsigned long));
+    xRequests = xQueueCreate(1, sizeof(unsigned long));
+    xReplies = xQueueCreate(1, sizeof(unsigned long));
+    xMutex = xSemaphoreCreateMutex();
+    xPing = xSemaphoreCreateBinary();
+    xPong = xSemaphoreCreateBinary();
+
+    vBenchStart(vBenchTask, "Bench", configMAX_PRIORITIES - 1, &xBenchTask);
+
+    return EXIT_FAILURE;
+}
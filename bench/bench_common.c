@@ -0,0 +1,43 @@
+/**
+ * @file bench_common.c
+ * @brief Helpers shared by the headless benchmarks in bench/
+ */
+
+#include <time.h>
+
+#include "bench_common.h"
+
+double dBenchNow(void)
+{
+    struct timespec xNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return xNow.tv_sec + xNow.tv_nsec / 1e9;
+}
+
+unsigned long ulBenchNowNs(void)
+{
+    struct timespec xNow;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return xNow.tv_sec * 1000000000UL + xNow.tv_nsec;
+}
+
+void vBenchStart(TaskFunction_t pxBenchTask, const char *pcName,
+                 UBaseType_t uxPriority, TaskHandle_t *pxHandle)
+{
+    if (xTaskCreate(pxBenchTask, pcName, BENCH_STACK_SIZE, NULL, uxPriority,
+                    pxHandle) != pdPASS) {
+        return;
+    }
+
+    vTaskStartScheduler();
+}
+
+void vMainQueueSendPassed(void)
+{
+}
+
+void vApplicationIdleHook(void)
+{
+}
@@ -0,0 +1,30 @@
+/**
+ * @file bench_common.h
+ * @brief Helpers shared by the headless benchmarks in bench/
+ *
+ * Every benchmark links bench_common.c, which provides the host clock, the
+ * application hooks the kernel configuration asks for and the start of the
+ * scheduler around the task that runs the benchmark.
+ */
+
+#ifndef __BENCH_COMMON_H__
+#define __BENCH_COMMON_H__
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Stack depth of the task that runs a benchmark, it formats the results */
+#define BENCH_STACK_SIZE (configMINIMAL_STACK_SIZE * 256)
+
+/* Monotonic host time in seconds */
+double dBenchNow(void);
+
+/* Monotonic host time in nanoseconds */
+unsigned long ulBenchNowNs(void);
+
+/* Creates the task running the benchmark and starts the scheduler, only
+ * returns if either fails */
+void vBenchStart(TaskFunction_t pxBenchTask, const char *pcName,
+                 UBaseType_t uxPriority, TaskHandle_t *pxHandle);
+
+#endif // __BENCH_COMMON_H__
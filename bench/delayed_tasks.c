@@ -0,0 +1,135 @@
+/**
+ * @file delayed_tasks.c
+ * @brief Cost of blocking and waking many periodic tasks
+ *
+ * Runs the given number of tasks that each wake up periodically with
+ * vTaskDelayUntil(), with periods spread over a range of ticks, for the given
+ * number of ticks and reports the run time outside of the idle task per wake
+ * up and how many wake ups were late. Build once with
+ * configUSE_DELAYED_TASK_WHEEL set to 1 and once with it set to 0 to compare
+ * the timing wheel with the sorted delayed task lists.
+ * Usage: freertos_delayed_tasks [tasks] [ticks]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bench_common.h"
+
+#define DELAYED_DEFAULT_TASKS 5000
+#define DELAYED_DEFAULT_TICKS 5000
+
+#define DELAYED_MIN_PERIOD pdMS_TO_TICKS(100)
+#define DELAYED_MAX_PERIOD pdMS_TO_TICKS(1000)
+
+static unsigned long ulTasks = DELAYED_DEFAULT_TASKS;
+static unsigned long ulTicks = DELAYED_DEFAULT_TICKS;
+static volatile unsigned long ulWakeups = 0;
+static volatile unsigned long ulLate = 0;
+static volatile TickType_t xMaxLateness = 0;
+
+static TaskStatus_t *pxStatus = NULL;
+
+/*
+ * Returns the run time in nanoseconds since the scheduler started that was not
+ * spent in the idle task, which polls between ticks.
+ */
+static configRUN_TIME_COUNTER_TYPE prvGetBusyTime(void)
+{
+    configRUN_TIME_COUNTER_TYPE ulTotal, ulBusy;
+    UBaseType_t uxTasks, i;
+
+    uxTasks = uxTaskGetSystemState(pxStatus, ulTasks + 8, &ulTotal);
+    ulBusy = ulTotal;
+    for (i = 0; i < uxTasks; i++) {
+        if (strcmp(pxStatus[i].pcTaskName, "IDLE") == 0) {
+            ulBusy -= pxStatus[i].ulRunTimeCounter;
+        }
+    }
+
+    return ulBusy;
+}
+
+static void vPeriodicTask(void *pvParameters)
+{
+    const TickType_t xPeriod = (TickType_t)(unsigned long)pvParameters;
+    TickType_t xLastWake = xTaskGetTickCount(), xLateness;
+
+    for (;;) {
+        vTaskDelayUntil(&xLastWake, xPeriod);
+        xLateness = xTaskGetTickCount() - xLastWake;
+        ulWakeups++;
+        if (xLateness != 0) {
+            ulLate++;
+            if (xLateness > xMaxLateness) {
+                xMaxLateness = xLateness;
+            }
+        }
+    }
+}
+
+static void vDelayedTask(void *pvParameters)
+{
+    unsigned int uiSeed = 1;
+    unsigned long i, ulWakeupsStart;
+    configRUN_TIME_COUNTER_TYPE ulBusyStart;
+    TickType_t xStart;
+
+    printf("%lu tasks, periods of %u to %u ticks, %s\n", ulTasks,
+           (unsigned)DELAYED_MIN_PERIOD, (unsigned)DELAYED_MAX_PERIOD,
+           configUSE_DELAYED_TASK_WHEEL ? "delayed task wheel"
+           : "sorted delayed task lists");
+
+    for (i = 0; i < ulTasks; i++) {
+        if (xTaskCreate(vPeriodicTask, "Periodic", configMINIMAL_STACK_SIZE,
+                        (void *)(unsigned long)(DELAYED_MIN_PERIOD +
+                                rand_r(&uiSeed) % (DELAYED_MAX_PERIOD -
+                                        DELAYED_MIN_PERIOD + 1)),
+                        tskIDLE_PRIORITY + 1, NULL) != pdPASS) {
+            fprintf(stderr, "Could not create task %lu\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /* Let every task block once before measuring. */
+    vTaskDelay(DELAYED_MAX_PERIOD);
+
+    ulWakeupsStart = ulWakeups;
+    ulLate = 0;
+    xMaxLateness = 0;
+    xStart = xTaskGetTickCount();
+    ulBusyStart = prvGetBusyTime();
+    vTaskDelay(ulTicks);
+    ulBusyStart = prvGetBusyTime() - ulBusyStart;
+    ulWakeupsStart = ulWakeups - ulWakeupsStart;
+
+    printf("%lu wake ups in %u ticks, %.0f ns busy/wake up\n", ulWakeupsStart,
+           (unsigned)(xTaskGetTickCount() - xStart),
+           (double)ulBusyStart / ulWakeupsStart);
+    printf("%lu late wake ups, at most %u ticks late\n", ulLate,
+           (unsigned)xMaxLateness);
+
+    exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1) {
+        ulTasks = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        ulTicks = strtoul(argv[2], NULL, 10);
+    }
+    if ((ulTasks == 0) || (ulTicks == 0)) {
+        fprintf(stderr, "Usage: %s [tasks] [ticks]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    pxStatus = calloc(ulTasks + 8, sizeof(TaskStatus_t));
+    vBenchStart(vDelayedTask, "Delayed", configMAX_PRIORITIES - 1, NULL);
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file heap_alloc.c
+ * @brief Throughput and fragmentation of pvPortMalloc()/vPortFree()
+ *
+ * Runs the given number of tasks that each keep a set of blocks of random
+ * sizes, mostly small ones, and replace a random one of them at every step,
+ * freeing some of them from another task. Reports the allocations and frees
+ * per second and, with configUSE_SIZE_CLASS_HEAP set to 1, the heap statistics
+ * and how fragmented the free memory is. Build once with
+ * configUSE_SIZE_CLASS_HEAP set to 1 and once with it set to 0 to compare the
+ * size class heap with the host's malloc().
+ * Usage: freertos_heap_alloc [tasks] [steps per task]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "bench_common.h"
+
+#define HEAP_DEFAULT_TASKS 4
+#define HEAP_DEFAULT_STEPS 1000000
+#define HEAP_BLOCKS_PER_TASK 256
+#define HEAP_QUEUE_LENGTH 64
+
+static unsigned long ulTasks = HEAP_DEFAULT_TASKS;
+static unsigned long ulSteps = HEAP_DEFAULT_STEPS;
+static QueueHandle_t xForeignFrees = NULL;
+static TaskHandle_t xHeapTask = NULL;
+static volatile unsigned long ulFailures = 0;
+
+/*
+ * Returns a request size, 7 in 8 up to 256 bytes and the rest up to 4 KiB.
+ */
+static size_t prvRandomSize(unsigned int *puiSeed)
+{
+    if (rand_r(puiSeed) % 8 != 0) {
+        return 1 + rand_r(puiSeed) % 256;
+    }
+    return 257 + rand_r(puiSeed) % 3840;
+}
+
+static void vAllocTask(void *pvParameters)
+{
+    unsigned int uiSeed = (unsigned int)(unsigned long)pvParameters + 1;
+    void *pvBlocks[HEAP_BLOCKS_PER_TASK] = { NULL };
+    void *pvBlock;
+    unsigned long i;
+    int iIndex;
+
+    for (i = 0; i < ulSteps; i++) {
+        iIndex = rand_r(&uiSeed) % HEAP_BLOCKS_PER_TASK;
+        if (pvBlocks[iIndex] != NULL) {
+            /* Every eighth block is freed by whichever task comes next. */
+            if ((i % 8 != 0) ||
+                (xQueueSend(xForeignFrees, &pvBlocks[iIndex], 0) != pdPASS)) {
+                vPortFree(pvBlocks[iIndex]);
+            }
+        }
+        pvBlocks[iIndex] = pvPortMalloc(prvRandomSize(&uiSeed));
+        if (pvBlocks[iIndex] == NULL) {
+            ulFailures++;
+        }
+        while (xQueueReceive(xForeignFrees, &pvBlock, 0) == pdPASS) {
+            vPortFree(pvBlock);
+        }
+    }
+
+    for (iIndex = 0; iIndex < HEAP_BLOCKS_PER_TASK; iIndex++) {
+        vPortFree(pvBlocks[iIndex]);
+    }
+
+    xTaskNotifyGive(xHeapTask);
+    vTaskSuspend(NULL);
+}
+
+static void vHeapTask(void *pvParameters)
+{
+    TaskHandle_t *pxTasks = pvPortMalloc(ulTasks * sizeof(TaskHandle_t));
+    unsigned long i;
+    double dStart, dElapsed;
+    void *pvBlock;
+
+    printf("%lu tasks, %lu steps each, %s\n", ulTasks, ulSteps,
+           configUSE_SIZE_CLASS_HEAP ? "size class heap" : "host malloc()");
+
+    dStart = dBenchNow();
+    for (i = 0; i < ulTasks; i++) {
+        xTaskCreate(vAllocTask, "Alloc", configMINIMAL_STACK_SIZE * 256,
+                    (void *)i, tskIDLE_PRIORITY + 1, &pxTasks[i]);
+    }
+    for (i = 0; i < ulTasks; i++) {
+        ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+    }
+    dElapsed = dBenchNow() - dStart;
+    while (xQueueReceive(xForeignFrees, &pvBlock, 0) == pdPASS) {
+        vPortFree(pvBlock);
+    }
+
+    printf("%.0f allocations and frees/s, %lu failed allocations\n",
+           ulTasks * ulSteps / dElapsed, ulFailures);
+
+#if (configUSE_SIZE_CLASS_HEAP == 1)
+    {
+        HeapStats_t xStats;
+
+        vPortGetHeapStats(&xStats);
+        printf("%zu bytes free, %zu of them binned, at least %zu ever\n",
+               xStats.xAvailableHeapSpaceInBytes,
+               xStats.xBytesInSizeClassBins,
+               xStats.xMinimumEverFreeBytesRemaining);
+        printf("%zu free blocks, largest %zu bytes, %.1f %% fragmentation\n",
+               xStats.xNumberOfFreeBlocks,
+               xStats.xSizeOfLargestFreeBlockInBytes,
+               100.0 * (1.0 - (double)xStats.xSizeOfLargestFreeBlockInBytes /
+                        (xStats.xAvailableHeapSpaceInBytes -
+                         xStats.xBytesInSizeClassBins)));
+    }
+#endif
+
+    exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1) {
+        ulTasks = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        ulSteps = strtoul(argv[2], NULL, 10);
+    }
+    if ((ulTasks == 0) || (ulSteps == 0)) {
+        fprintf(stderr, "Usage: %s [tasks] [steps per task]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    xForeignFrees = xQueueCreate(HEAP_QUEUE_LENGTH, sizeof(void *));
+    vBenchStart(vHeapTask, "Heap", configMAX_PRIORITIES - 1, &xHeapTask);
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file object_pools.c
+ * @brief Cost of creating and deleting kernel objects
+ *
+ * Creates and deletes the given number of queues, software timers and tasks,
+ * one at a time, and reports the time per create and delete pair of each and
+ * the high-water marks of the object pools.
+ * Build once with configTASK_POOL_SIZE, configQUEUE_POOL_SIZE and
+ * configTIMER_POOL_SIZE set and once with them set to 0 to compare the pools
+ * with pvPortMalloc().
+ * Usage: freertos_object_pools [objects]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+#include "object_pool.h"
+#include "bench_common.h"
+
+#define POOLS_DEFAULT_OBJECTS 100000
+#define POOLS_QUEUE_LENGTH 8
+#define POOLS_ITEM_SIZE 16
+
+static unsigned long ulObjects = POOLS_DEFAULT_OBJECTS;
+
+static void vIdleTask(void *pvParameters)
+{
+    /* Never runs, it is deleted right after being created. */
+    vTaskSuspend(NULL);
+}
+
+static void vTimerCallback(TimerHandle_t xTimer)
+{
+}
+
+static void prvReport(const char *pcName, eObjectPool ePool, double dElapsed)
+{
+    ObjectPoolStatus_t xStatus;
+
+    vObjectPoolGetStatus(ePool, &xStatus);
+    printf("%-6s %6.0f ns/create and delete, pool of %u, at most %u used, %u "
+           "from the heap\n", pcName, dElapsed * 1e9 / ulObjects,
+           (unsigned)xStatus.uxBlocks, (unsigned)xStatus.uxMaxBlocksInUse,
+           (unsigned)xStatus.uxHeapAllocations);
+}
+
+static void vPoolsTask(void *pvParameters)
+{
+    QueueHandle_t xQueue;
+    TimerHandle_t xTimer;
+    TaskHandle_t xTask;
+    unsigned long i;
+    double dStart;
+
+    printf("%lu objects\n", ulObjects);
+
+    dStart = dBenchNow();
+    for (i = 0; i < ulObjects; i++) {
+        xQueue = xQueueCreate(POOLS_QUEUE_LENGTH, POOLS_ITEM_SIZE);
+        vQueueDelete(xQueue);
+    }
+    prvReport("Queue", eQueuePool, dBenchNow() - dStart);
+
+    /* The timer task frees deleted timers, it runs at the same priority so
+    deletions queue up to configTIMER_QUEUE_LENGTH timers at a time. */
+    dStart = dBenchNow();
+    for (i = 0; i < ulObjects; i++) {
+        xTimer = xTimerCreate("Pool", 1, pdFALSE, NULL, vTimerCallback);
+        xTimerDelete(xTimer, portMAX_DELAY);
+    }
+    prvReport("Timer", eTimerPool, dBenchNow() - dStart);
+
+    dStart = dBenchNow();
+    for (i = 0; i < ulObjects; i++) {
+        xTaskCreate(vIdleTask, "Pool", configMINIMAL_STACK_SIZE, NULL,
+                    tskIDLE_PRIORITY + 1, &xTask);
+        vTaskDelete(xTask);
+    }
+    prvReport("Task", eTaskPool, dBenchNow() - dStart);
+
+    exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1) {
+        ulObjects = strtoul(argv[1], NULL, 10);
+    }
+    if (ulObjects == 0) {
+        fprintf(stderr, "Usage: %s [objects]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    vBenchStart(vPoolsTask, "Pools", configTIMER_TASK_PRIORITY, NULL);
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,160 @@
+/**
+ * @file queue_batch.c
+ * @brief Throughput of batched against per item queue transfers
+ *
+ * Passes the given number of items from a producer to a higher priority
+ * consumer, first one at a time with xQueueSend()/xQueueReceive() and then in
+ * batches with xQueueSendMultiple()/xQueueReceiveMultiple(), and reports the
+ * items per second and the context switches per item of each.
+ * Usage: freertos_queue_batch [items] [batch size]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "bench_common.h"
+
+#define BATCH_DEFAULT_ITEMS 1000000
+#define BATCH_DEFAULT_SIZE 32
+#define BATCH_QUEUE_LENGTH 64
+
+static unsigned long ulItems = BATCH_DEFAULT_ITEMS;
+static unsigned long ulBatch = BATCH_DEFAULT_SIZE;
+static QueueHandle_t xQueue = NULL;
+static TaskHandle_t xBatchTask = NULL;
+static volatile unsigned long ulWakeups = 0;
+static volatile unsigned long ulErrors = 0;
+
+static void vProducerTask(void *pvParameters)
+{
+    unsigned long i;
+
+    for (i = 0; i < ulItems; i++) {
+        xQueueSend(xQueue, &i, portMAX_DELAY);
+    }
+
+    vTaskSuspend(NULL);
+}
+
+static void vConsumerTask(void *pvParameters)
+{
+    unsigned long i, ulItem;
+
+    for (i = 0; i < ulItems; i++) {
+        xQueueReceive(xQueue, &ulItem, portMAX_DELAY);
+        ulWakeups++;
+        if (ulItem != i) {
+            ulErrors++;
+        }
+    }
+
+    xTaskNotifyGive(xBatchTask);
+    vTaskSuspend(NULL);
+}
+
+static void vBatchProducerTask(void *pvParameters)
+{
+    unsigned long *pulItems = pvPortMalloc(ulBatch * sizeof(unsigned long));
+    unsigned long i, ulSent, ulCount;
+
+    for (i = 0; i < ulItems; i += ulCount) {
+        ulCount = (ulItems - i < ulBatch) ? ulItems - i : ulBatch;
+        for (ulSent = 0; ulSent < ulCount; ulSent++) {
+            pulItems[ulSent] = i + ulSent;
+        }
+        for (ulSent = 0; ulSent < ulCount;) {
+            ulSent += xQueueSendMultiple(xQueue, &pulItems[ulSent],
+                                         ulCount - ulSent, portMAX_DELAY);
+        }
+    }
+
+    vPortFree(pulItems);
+    vTaskSuspend(NULL);
+}
+
+static void vBatchConsumerTask(void *pvParameters)
+{
+    unsigned long *pulItems = pvPortMalloc(ulBatch * sizeof(unsigned long));
+    unsigned long i = 0, j, ulCount;
+
+    while (i < ulItems) {
+        ulCount = xQueueReceiveMultiple(xQueue, pulItems, ulBatch,
+                                        portMAX_DELAY);
+        ulWakeups++;
+        for (j = 0; j < ulCount; j++, i++) {
+            if (pulItems[j] != i) {
+                ulErrors++;
+            }
+        }
+    }
+
+    vPortFree(pulItems);
+    xTaskNotifyGive(xBatchTask);
+    vTaskSuspend(NULL);
+}
+
+/*
+ * Runs the producer and the higher priority consumer until all items have
+ * been received and prints the throughput.
+ */
+static void prvRun(const char *pcName, TaskFunction_t pxProducer,
+                   TaskFunction_t pxConsumer)
+{
+    TaskHandle_t xProducer, xConsumer;
+    double dStart, dElapsed;
+
+    ulWakeups = 0;
+    ulErrors = 0;
+    xQueueReset(xQueue);
+
+    dStart = dBenchNow();
+    xTaskCreate(pxConsumer, "Consumer", configMINIMAL_STACK_SIZE, NULL,
+                tskIDLE_PRIORITY + 2, &xConsumer);
+    xTaskCreate(pxProducer, "Producer", configMINIMAL_STACK_SIZE, NULL,
+                tskIDLE_PRIORITY + 1, &xProducer);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    dElapsed = dBenchNow() - dStart;
+
+    vTaskDelete(xProducer);
+    vTaskDelete(xConsumer);
+    vTaskDelay(2);
+
+    printf("%s: %.3f s, %.0f items/s, %.2f consumer wakeups/item, "
+           "%lu errors\n",
+           pcName, dElapsed, ulItems / dElapsed,
+           (double)ulWakeups / ulItems, ulErrors);
+}
+
+static void vBatchTask(void *pvParameters)
+{
+    printf("%lu items, batches of %lu, queue length %d\n", ulItems, ulBatch,
+           BATCH_QUEUE_LENGTH);
+
+    prvRun("per item", vProducerTask, vConsumerTask);
+    prvRun("batched", vBatchProducerTask, vBatchConsumerTask);
+
+    exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1) {
+        ulItems = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        ulBatch = strtoul(argv[2], NULL, 10);
+    }
+    if ((ulItems == 0) || (ulBatch == 0)) {
+        fprintf(stderr, "Usage: %s [items] [batch size]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    xQueue = xQueueCreate(BATCH_QUEUE_LENGTH, sizeof(unsigned long));
+
+    vBenchStart(vBatchTask, "Batch", configMAX_PRIORITIES - 1, &xBatchTask);
+
+    return EXIT_FAILURE;
+}
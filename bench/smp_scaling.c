@@ -0,0 +1,127 @@
+/**
+ * @file smp_scaling.c
+ * @brief Throughput of task sets over the simulated cores
+ *
+ * Runs a set of independent busy tasks and a set of producer/consumer pairs
+ * passing messages through queues, and reports how long each set takes on
+ * configNUMBER_OF_CORES cores. Build with different core counts to compare.
+ * Usage: freertos_smp_scaling [tasks] [iterations in millions]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "bench_common.h"
+
+#define SCALING_DEFAULT_TASKS 8
+#define SCALING_DEFAULT_MILLIONS 50
+#define SCALING_MESSAGES 100000
+#define SCALING_QUEUE_LENGTH 16
+
+static unsigned long ulTasks = SCALING_DEFAULT_TASKS;
+static unsigned long ulIterations = SCALING_DEFAULT_MILLIONS * 1000000UL;
+static SemaphoreHandle_t xDone = NULL;
+
+static void vBusyTask(void *pvParameters)
+{
+    volatile unsigned long ulCount;
+
+    for (ulCount = 0; ulCount < ulIterations; ulCount++) {
+    }
+
+    xSemaphoreGive(xDone);
+    vTaskDelete(NULL);
+}
+
+static void vProducerTask(void *pvParameters)
+{
+    QueueHandle_t xQueue = (QueueHandle_t)pvParameters;
+    unsigned long i;
+
+    for (i = 0; i < SCALING_MESSAGES; i++) {
+        xQueueSend(xQueue, &i, portMAX_DELAY);
+    }
+
+    vTaskDelete(NULL);
+}
+
+static void vConsumerTask(void *pvParameters)
+{
+    QueueHandle_t xQueue = (QueueHandle_t)pvParameters;
+    unsigned long i, ulMessage;
+
+    for (i = 0; i < SCALING_MESSAGES; i++) {
+        xQueueReceive(xQueue, &ulMessage, portMAX_DELAY);
+    }
+
+    xSemaphoreGive(xDone);
+    vTaskDelete(NULL);
+}
+
+/*
+ * Returns the seconds it takes until ulCount tasks have given xDone.
+ */
+static double prvWaitForTasks(double dStart, unsigned long ulCount)
+{
+    while (ulCount-- > 0) {
+        xSemaphoreTake(xDone, portMAX_DELAY);
+    }
+
+    return dBenchNow() - dStart;
+}
+
+static void vScalingTask(void *pvParameters)
+{
+    QueueHandle_t *pxQueues;
+    double dStart, dElapsed;
+    unsigned long i;
+
+    printf("%d cores, %lu tasks\n", configNUMBER_OF_CORES, ulTasks);
+
+    dStart = dBenchNow();
+    for (i = 0; i < ulTasks; i++) {
+        xTaskCreate(vBusyTask, "Busy", configMINIMAL_STACK_SIZE, NULL,
+                    tskIDLE_PRIORITY + 1, NULL);
+    }
+    dElapsed = prvWaitForTasks(dStart, ulTasks);
+    printf("busy: %.3f s, %.1f M iterations/s\n", dElapsed,
+           ulTasks * (ulIterations / 1e6) / dElapsed);
+
+    pxQueues = pvPortMalloc(ulTasks * sizeof(QueueHandle_t));
+    for (i = 0; i < ulTasks; i++) {
+        pxQueues[i] = xQueueCreate(SCALING_QUEUE_LENGTH, sizeof(unsigned long));
+    }
+
+    dStart = dBenchNow();
+    for (i = 0; i < ulTasks; i++) {
+        xTaskCreate(vProducerTask, "Producer", configMINIMAL_STACK_SIZE,
+                    pxQueues[i], tskIDLE_PRIORITY + 1, NULL);
+        xTaskCreate(vConsumerTask, "Consumer", configMINIMAL_STACK_SIZE,
+                    pxQueues[i], tskIDLE_PRIORITY + 1, NULL);
+    }
+    dElapsed = prvWaitForTasks(dStart, ulTasks);
+    printf("queues: %.3f s, %.0f messages/s\n", dElapsed,
+           ulTasks * SCALING_MESSAGES / dElapsed);
+
+    exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1) {
+        ulTasks = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        ulIterations = strtoul(argv[2], NULL, 10) * 1000000UL;
+    }
+
+    xDone = xSemaphoreCreateCounting(ulTasks, 0);
+
+    vBenchStart(vScalingTask, "Scaling", configMAX_PRIORITIES - 1, NULL);
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,208 @@
+/**
+ * @file stream_buffer.c
+ * @brief Throughput of a byte stream through a queue and a stream buffer
+ *
+ * Passes the given number of bytes, written in chunks of the given size, from
+ * a producer to a higher priority consumer, first chopped into fixed-size
+ * queue items and then through a stream buffer, and reports the bytes per
+ * second and the consumer wakeups per chunk of each.
+ * Usage: freertos_stream_buffer [bytes] [chunk size]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+#include "bench_common.h"
+
+#define STREAM_DEFAULT_BYTES 16000000
+#define STREAM_DEFAULT_CHUNK 256
+#define STREAM_ITEM_SIZE 16
+#define STREAM_QUEUE_LENGTH 64
+#define STREAM_BUFFER_SIZE (STREAM_ITEM_SIZE * STREAM_QUEUE_LENGTH)
+
+/* A piece of the stream as a queue item. */
+typedef struct {
+    unsigned char ucLength;
+    unsigned char ucData[STREAM_ITEM_SIZE];
+} StreamItem_t;
+
+static unsigned long ulBytes = STREAM_DEFAULT_BYTES;
+static unsigned long ulChunk = STREAM_DEFAULT_CHUNK;
+static QueueHandle_t xQueue = NULL;
+static StreamBufferHandle_t xStreamBuffer = NULL;
+static TaskHandle_t xStreamTask = NULL;
+static volatile unsigned long ulWakeups = 0;
+static volatile unsigned long ulErrors = 0;
+
+/*
+ * Fills pucChunk with the stream bytes following ulOffset.
+ */
+static void prvFillChunk(unsigned char *pucChunk, unsigned long ulOffset,
+                         unsigned long ulCount)
+{
+    unsigned long i;
+
+    for (i = 0; i < ulCount; i++) {
+        pucChunk[i] = (unsigned char)(ulOffset + i);
+    }
+}
+
+/*
+ * Counts the bytes of pucData that are not the stream bytes following
+ * ulOffset.
+ */
+static void prvCheckBytes(const unsigned char *pucData, unsigned long ulOffset,
+                          unsigned long ulCount)
+{
+    unsigned long i;
+
+    for (i = 0; i < ulCount; i++) {
+        if (pucData[i] != (unsigned char)(ulOffset + i)) {
+            ulErrors++;
+        }
+    }
+}
+
+static void vQueueProducerTask(void *pvParameters)
+{
+    unsigned char *pucChunk = pvPortMalloc(ulChunk);
+    unsigned long i, j, ulCount;
+    StreamItem_t xItem;
+
+    for (i = 0; i < ulBytes; i += ulCount) {
+        ulCount = (ulBytes - i < ulChunk) ? ulBytes - i : ulChunk;
+        prvFillChunk(pucChunk, i, ulCount);
+
+        /* Chop the chunk into items. */
+        for (j = 0; j < ulCount; j += xItem.ucLength) {
+            xItem.ucLength = (ulCount - j < STREAM_ITEM_SIZE)
+                                 ? ulCount - j
+                                 : STREAM_ITEM_SIZE;
+            memcpy(xItem.ucData, &pucChunk[j], xItem.ucLength);
+            xQueueSend(xQueue, &xItem, portMAX_DELAY);
+        }
+    }
+
+    vPortFree(pucChunk);
+    vTaskSuspend(NULL);
+}
+
+static void vQueueConsumerTask(void *pvParameters)
+{
+    unsigned long i = 0;
+    StreamItem_t xItem;
+
+    while (i < ulBytes) {
+        xQueueReceive(xQueue, &xItem, portMAX_DELAY);
+        ulWakeups++;
+        prvCheckBytes(xItem.ucData, i, xItem.ucLength);
+        i += xItem.ucLength;
+    }
+
+    xTaskNotifyGive(xStreamTask);
+    vTaskSuspend(NULL);
+}
+
+static void vStreamProducerTask(void *pvParameters)
+{
+    unsigned char *pucChunk = pvPortMalloc(ulChunk);
+    unsigned long i, ulSent, ulCount;
+
+    for (i = 0; i < ulBytes; i += ulCount) {
+        ulCount = (ulBytes - i < ulChunk) ? ulBytes - i : ulChunk;
+        prvFillChunk(pucChunk, i, ulCount);
+        for (ulSent = 0; ulSent < ulCount;) {
+            ulSent += xStreamBufferSend(xStreamBuffer, &pucChunk[ulSent],
+                                        ulCount - ulSent, portMAX_DELAY);
+        }
+    }
+
+    vPortFree(pucChunk);
+    vTaskSuspend(NULL);
+}
+
+static void vStreamConsumerTask(void *pvParameters)
+{
+    unsigned char *pucData = pvPortMalloc(STREAM_BUFFER_SIZE);
+    unsigned long i = 0, ulCount;
+
+    while (i < ulBytes) {
+        ulCount = xStreamBufferReceive(xStreamBuffer, pucData,
+                                       STREAM_BUFFER_SIZE, portMAX_DELAY);
+        ulWakeups++;
+        prvCheckBytes(pucData, i, ulCount);
+        i += ulCount;
+    }
+
+    vPortFree(pucData);
+    xTaskNotifyGive(xStreamTask);
+    vTaskSuspend(NULL);
+}
+
+/*
+ * Runs the producer and the higher priority consumer until all bytes have
+ * been received and prints the throughput.
+ */
+static void prvRun(const char *pcName, TaskFunction_t pxProducer,
+                   TaskFunction_t pxConsumer)
+{
+    TaskHandle_t xProducer, xConsumer;
+    double dStart, dElapsed;
+
+    ulWakeups = 0;
+    ulErrors = 0;
+
+    dStart = dBenchNow();
+    xTaskCreate(pxConsumer, "Consumer", configMINIMAL_STACK_SIZE, NULL,
+                tskIDLE_PRIORITY + 2, &xConsumer);
+    xTaskCreate(pxProducer, "Producer", configMINIMAL_STACK_SIZE, NULL,
+                tskIDLE_PRIORITY + 1, &xProducer);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    dElapsed = dBenchNow() - dStart;
+
+    vTaskDelete(xProducer);
+    vTaskDelete(xConsumer);
+    vTaskDelay(2);
+
+    printf("%s: %.3f s, %.1f MB/s, %.2f consumer wakeups/chunk, "
+           "%lu errors\n",
+           pcName, dElapsed, ulBytes / dElapsed / 1e6,
+           (double)ulWakeups * ulChunk / ulBytes, ulErrors);
+}
+
+static void vStreamTask(void *pvParameters)
+{
+    printf("%lu bytes, chunks of %lu, %d byte queue items, %d byte buffers\n",
+           ulBytes, ulChunk, STREAM_ITEM_SIZE, STREAM_BUFFER_SIZE);
+
+    prvRun("queue", vQueueProducerTask, vQueueConsumerTask);
+    prvRun("stream buffer", vStreamProducerTask, vStreamConsumerTask);
+
+    exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1) {
+        ulBytes = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        ulChunk = strtoul(argv[2], NULL, 10);
+    }
+    if ((ulBytes == 0) || (ulChunk == 0)) {
+        fprintf(stderr, "Usage: %s [bytes] [chunk size]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    xQueue = xQueueCreate(STREAM_QUEUE_LENGTH, sizeof(StreamItem_t));
+    xStreamBuffer = xStreamBufferCreate(STREAM_BUFFER_SIZE, 1);
+
+    vBenchStart(vStreamTask, "Stream", configMAX_PRIORITIES - 1, &xStreamTask);
+
+    return EXIT_FAILURE;
+}
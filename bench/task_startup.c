@@ -0,0 +1,76 @@
+/**
+ * @file task_startup.c
+ * @brief Task creation throughput of the POSIX port at start-up
+ *
+ * Creates a number of tasks before the scheduler is started, as applications
+ * typically do, and reports how long creating them took, how much CPU time it
+ * used and how long it took until every task had run once.
+ * Usage: freertos_task_startup [tasks]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bench_common.h"
+
+#define STARTUP_DEFAULT_TASKS 500
+
+static unsigned long ulTasks = STARTUP_DEFAULT_TASKS;
+static volatile unsigned long ulStarted = 0;
+static double dStart;
+
+static double prvCPUTime(void)
+{
+    struct rusage xUsage;
+
+    getrusage(RUSAGE_SELF, &xUsage);
+    return xUsage.ru_utime.tv_sec + xUsage.ru_utime.tv_usec / 1e6 +
+           xUsage.ru_stime.tv_sec + xUsage.ru_stime.tv_usec / 1e6;
+}
+
+static void vStartupTask(void *pvParameters)
+{
+    ulStarted++;
+    vTaskSuspend(NULL);
+}
+
+static void vReportTask(void *pvParameters)
+{
+    /* Runs once all of the higher priority start-up tasks have suspended */
+    printf("all %lu tasks ran after %.3f s, %.3f s CPU time in total\n",
+           ulStarted, dBenchNow() - dStart, prvCPUTime());
+
+    exit(ulStarted == ulTasks ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long i;
+    double dCreated, dCPU;
+
+    if (argc > 1) {
+        ulTasks = strtoul(argv[1], NULL, 10);
+    }
+
+    dStart = dBenchNow();
+    dCPU = prvCPUTime();
+
+    for (i = 0; i < ulTasks; i++) {
+        if (xTaskCreate(vStartupTask, "Startup", configMINIMAL_STACK_SIZE,
+                        NULL, tskIDLE_PRIORITY + 2, NULL) != pdPASS) {
+            printf("Task creation failed after %lu tasks\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+
+    dCreated = dBenchNow() - dStart;
+    printf("created %lu tasks in %.3f s (%.0f tasks/s), %.3f s CPU time\n",
+           ulTasks, dCreated, ulTasks / dCreated, prvCPUTime() - dCPU);
+
+    vBenchStart(vReportTask, "Report", tskIDLE_PRIORITY + 1, NULL);
+
+    return EXIT_FAILURE;
+}
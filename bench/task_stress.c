@@ -0,0 +1,119 @@
+/**
+ * @file task_stress.c
+ * @brief Stress test for the number of tasks the POSIX port can host
+ *
+ * Creates and deletes a large number of tasks in several rounds and reports
+ * the creation/deletion latency as well as the host memory used per task.
+ * Usage: freertos_task_stress [tasks per round] [rounds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bench_common.h"
+
+#define STRESS_DEFAULT_TASKS 1000
+#define STRESS_DEFAULT_ROUNDS 3
+
+static unsigned long ulTasks = STRESS_DEFAULT_TASKS;
+static unsigned long ulRounds = STRESS_DEFAULT_ROUNDS;
+static TaskHandle_t *pxHandles = NULL;
+
+/* Returns virtual and resident size of the process in bytes */
+static void prvGetMemory(double *pdVirtual, double *pdResident)
+{
+    unsigned long ulSize = 0, ulResident = 0;
+    long lPage = sysconf(_SC_PAGESIZE);
+    FILE *fp = fopen("/proc/self/statm", "r");
+
+    if (fp) {
+        if (fscanf(fp, "%lu %lu", &ulSize, &ulResident) != 2) {
+            ulSize = ulResident = 0;
+        }
+        fclose(fp);
+    }
+
+    *pdVirtual = (double)ulSize * lPage;
+    *pdResident = (double)ulResident * lPage;
+}
+
+static void vIdleTask(void *pvParameters)
+{
+    for (;;) {
+        vTaskSuspend(NULL);
+    }
+}
+
+static void vStressTask(void *pvParameters)
+{
+    unsigned long ulRound, i;
+    double dStart, dElapsed, dCreateMax, dCreateSum, dDeleteSum;
+    double dVirtualBefore, dResidentBefore, dVirtualAfter, dResidentAfter;
+
+    for (ulRound = 0; ulRound < ulRounds; ulRound++) {
+        dCreateMax = dCreateSum = 0;
+
+        prvGetMemory(&dVirtualBefore, &dResidentBefore);
+
+        for (i = 0; i < ulTasks; i++) {
+            dStart = dBenchNow();
+            if (xTaskCreate(vIdleTask, "Stress", configMINIMAL_STACK_SIZE,
+                            NULL, tskIDLE_PRIORITY + 1,
+                            &pxHandles[i]) != pdPASS) {
+                printf("Task creation failed after %lu tasks\n", i);
+                exit(EXIT_FAILURE);
+            }
+            dElapsed = (dBenchNow() - dStart) * 1e6;
+            dCreateSum += dElapsed;
+            if (dElapsed > dCreateMax) {
+                dCreateMax = dElapsed;
+            }
+        }
+
+        prvGetMemory(&dVirtualAfter, &dResidentAfter);
+
+        dStart = dBenchNow();
+        for (i = 0; i < ulTasks; i++) {
+            vTaskDelete(pxHandles[i]);
+        }
+        dDeleteSum = (dBenchNow() - dStart) * 1e6;
+
+        /* Let the idle task reclaim the deleted tasks */
+        vTaskDelay(pdMS_TO_TICKS(100));
+
+        printf("round %lu: %lu tasks, create avg %.2f us max %.2f us, "
+               "delete avg %.2f us, per task %.1f KiB resident "
+               "%.1f KiB virtual\n",
+               ulRound, ulTasks, dCreateSum / ulTasks, dCreateMax,
+               dDeleteSum / ulTasks,
+               (dResidentAfter - dResidentBefore) / ulTasks / 1024,
+               (dVirtualAfter - dVirtualBefore) / ulTasks / 1024);
+    }
+
+    exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1) {
+        ulTasks = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        ulRounds = strtoul(argv[2], NULL, 10);
+    }
+    if (ulTasks == 0) {
+        ulTasks = STRESS_DEFAULT_TASKS;
+    }
+
+    pxHandles = malloc(sizeof(TaskHandle_t) * ulTasks);
+    if (pxHandles == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    vBenchStart(vStressTask, "Stress", configMAX_PRIORITIES - 1, NULL);
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file tick_jitter.c
+ * @brief Accuracy of the POSIX port's tick
+ *
+ * Runs busy and periodic tasks for a number of seconds and compares the
+ * kernel's tick count against the wall clock, then prints the tick thread's
+ * jitter histogram.
+ * Usage: freertos_tick_jitter [seconds]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bench_common.h"
+
+#define JITTER_DEFAULT_SECONDS 5
+
+static unsigned long ulSeconds = JITTER_DEFAULT_SECONDS;
+
+static void vBusyTask(void *pvParameters)
+{
+    volatile unsigned long ulCount = 0;
+
+    for (;;) {
+        ulCount++;
+    }
+}
+
+static void vPeriodicTask(void *pvParameters)
+{
+    TickType_t xLastWake = xTaskGetTickCount();
+
+    for (;;) {
+        vTaskDelayUntil(&xLastWake, 1);
+    }
+}
+
+static void vJitterTask(void *pvParameters)
+{
+    xPortTickStats xStats;
+    TickType_t xStartTick;
+    double dStart, dElapsed;
+    unsigned long ulLower = 0;
+    int i;
+
+    vTaskDelay(1);
+    vPortResetTickStats();
+    xStartTick = xTaskGetTickCount();
+    dStart = dBenchNow();
+
+    vTaskDelay(pdMS_TO_TICKS(ulSeconds * 1000));
+
+    dElapsed = dBenchNow() - dStart;
+    vPortGetTickStats(&xStats);
+
+    printf("tick rate %u Hz, %.3f s elapsed, expected %.0f ticks, "
+           "kernel counted %lu\n", (unsigned)configTICK_RATE_HZ, dElapsed,
+           dElapsed * configTICK_RATE_HZ,
+           (unsigned long)(xTaskGetTickCount() - xStartTick));
+    printf("tick thread raised %lu ticks, %lu missed, max lateness %lu us\n",
+           xStats.ulTicks, xStats.ulMissedTicks,
+           xStats.ulMaxLatenessNs / 1000);
+
+    for (i = 0; i < portTICK_JITTER_BUCKETS; i++) {
+        if (i == portTICK_JITTER_BUCKETS - 1) {
+            printf("  >= %6lu us: %lu\n", ulLower, xStats.ulJitterHistogram[i]);
+        }
+        else {
+            printf("  <  %6lu us: %lu\n", 1UL << i,
+                   xStats.ulJitterHistogram[i]);
+        }
+        ulLower = 1UL << i;
+    }
+
+    exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1) {
+        ulSeconds = strtoul(argv[1], NULL, 10);
+    }
+
+    xTaskCreate(vBusyTask, "Busy", configMINIMAL_STACK_SIZE, NULL,
+                tskIDLE_PRIORITY + 1, NULL);
+    xTaskCreate(vPeriodicTask, "Periodic", configMINIMAL_STACK_SIZE, NULL,
+                tskIDLE_PRIORITY + 2, NULL);
+    vBenchStart(vJitterTask, "Jitter", configMAX_PRIORITIES - 1, NULL);
+
+    return EXIT_FAILURE;
+}
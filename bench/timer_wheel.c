@@ -0,0 +1,127 @@
+/**
+ * @file timer_wheel.c
+ * @brief Cost of restarting and expiring many software timers
+ *
+ * Restarts randomly chosen timers out of the given number of active timers
+ * with xTimerReset(), then starts as many one shot timers that all expire on
+ * the same tick, and reports the time per restart, per start and per expiry.
+ * Build once with configUSE_TIMER_WHEEL set to 1 and once with it set to 0 to
+ * compare the timer wheel with the sorted timer lists.
+ * Usage: freertos_timer_wheel [timers] [restarts]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "bench_common.h"
+
+#define WHEEL_DEFAULT_TIMERS 5000
+#define WHEEL_DEFAULT_RESTARTS 200000
+
+/* The restarted timers expire between one and two minutes out, so none of
+them expires during the benchmark. */
+#define WHEEL_MIN_PERIOD pdMS_TO_TICKS(60000)
+#define WHEEL_EXPIRY_DELAY pdMS_TO_TICKS(100)
+
+static unsigned long ulTimers = WHEEL_DEFAULT_TIMERS;
+static unsigned long ulRestarts = WHEEL_DEFAULT_RESTARTS;
+static TimerHandle_t *pxRestarted = NULL;
+static TimerHandle_t *pxExpiring = NULL;
+static TaskHandle_t xWheelTask = NULL;
+static volatile unsigned long ulExpired = 0;
+static double dFirstExpiry, dLastExpiry;
+
+static void prvRestartedCallback(TimerHandle_t xTimer)
+{
+    fprintf(stderr, "A restarted timer expired, use fewer restarts\n");
+}
+
+static void prvExpiringCallback(TimerHandle_t xTimer)
+{
+    if (ulExpired == 0) {
+        dFirstExpiry = dBenchNow();
+    }
+    if (++ulExpired == ulTimers) {
+        dLastExpiry = dBenchNow();
+        xTaskNotifyGive(xWheelTask);
+    }
+}
+
+static void vWheelTask(void *pvParameters)
+{
+    unsigned int uiSeed = 1;
+    unsigned long i;
+    TickType_t xStart;
+    double dStart, dRestart, dExpiryStart;
+
+    printf("%lu timers, %lu restarts, %s\n", ulTimers, ulRestarts,
+           configUSE_TIMER_WHEEL ? "timer wheel" : "sorted timer lists");
+
+    for (i = 0; i < ulTimers; i++) {
+        xTimerStart(pxRestarted[i], portMAX_DELAY);
+    }
+
+    /* Every command preempts this task, so each restart is timed including
+    the timer service task processing it. */
+    dStart = dBenchNow();
+    for (i = 0; i < ulRestarts; i++) {
+        xTimerReset(pxRestarted[rand_r(&uiSeed) % ulTimers], portMAX_DELAY);
+    }
+    dRestart = dBenchNow() - dStart;
+
+    for (i = 0; i < ulTimers; i++) {
+        xTimerStop(pxRestarted[i], portMAX_DELAY);
+    }
+
+    /* Start the one shot timers with the same command time, so they all
+    expire on the same tick. */
+    xStart = xTaskGetTickCount();
+    dStart = dBenchNow();
+    for (i = 0; i < ulTimers; i++) {
+        xTimerGenericCommand(pxExpiring[i], tmrCOMMAND_START, xStart, NULL,
+                             portMAX_DELAY);
+    }
+    dExpiryStart = dBenchNow() - dStart;
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    printf("restart: %.0f ns/timer\n", dRestart / ulRestarts * 1e9);
+    printf("start: %.0f ns/timer\n", dExpiryStart / ulTimers * 1e9);
+    printf("expiry: %.0f ns/timer\n",
+           (dLastExpiry - dFirstExpiry) / ulTimers * 1e9);
+
+    exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int uiSeed = 2;
+    unsigned long i;
+
+    if (argc > 1) {
+        ulTimers = strtoul(argv[1], NULL, 10);
+    }
+    if (argc > 2) {
+        ulRestarts = strtoul(argv[2], NULL, 10);
+    }
+    if ((ulTimers == 0) || (ulRestarts == 0)) {
+        fprintf(stderr, "Usage: %s [timers] [restarts]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    pxRestarted = calloc(ulTimers, sizeof(TimerHandle_t));
+    pxExpiring = calloc(ulTimers, sizeof(TimerHandle_t));
+    for (i = 0; i < ulTimers; i++) {
+        pxRestarted[i] = xTimerCreate("Restarted", WHEEL_MIN_PERIOD +
+                                      rand_r(&uiSeed) % WHEEL_MIN_PERIOD,
+                                      pdFALSE, NULL, prvRestartedCallback);
+        pxExpiring[i] = xTimerCreate("Expiring", WHEEL_EXPIRY_DELAY, pdFALSE,
+                                     NULL, prvExpiringCallback);
+    }
+
+    vBenchStart(vWheelTask, "Wheel", tskIDLE_PRIORITY + 1, &xWheelTask);
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,61 @@
+# ------------------------------------------------------------------------------
+# Benchmarks
+# ------------------------------------------------------------------------------
+
+# Headless benchmarks of the FreeRTOS POSIX port. They only link against the
+# kernel and are not built by default, e.g. `make freertos_task_stress`.
+
+SET(BENCH_LIBRARIES
+    m
+    ${CMAKE_THREAD_LIBS_INIT}
+    rt
+)
+
+SET(BENCH_SOURCES
+    ${PROJECT_SOURCE_DIR}/bench/bench_common.c
+    ${FREERTOS_SOURCES}
+)
+
+add_executable(freertos_task_stress EXCLUDE_FROM_ALL
+    ${PROJECT_SOURCE_DIR}/bench/task_stress.c ${BENCH_SOURCES})
+target_link_libraries(freertos_task_stress ${BENCH_LIBRARIES})
+
+add_executable(freertos_tick_jitter EXCLUDE_FROM_ALL
+    ${PROJECT_SOURCE_DIR}/bench/tick_jitter.c ${BENCH_SOURCES})
+target_link_libraries(freertos_tick_jitter ${BENCH_LIBRARIES})
+
+add_executable(freertos_task_startup EXCLUDE_FROM_ALL
+    ${PROJECT_SOURCE_DIR}/bench/task_startup.c ${BENCH_SOURCES})
+target_link_libraries(freertos_task_startup ${BENCH_LIBRARIES})
+
+add_executable(freertos_smp_scaling EXCLUDE_FROM_ALL
+    ${PROJECT_SOURCE_DIR}/bench/smp_scaling.c ${BENCH_SOURCES})
+target_link_libraries(freertos_smp_scaling ${BENCH_LIBRARIES})
+
+add_executable(freertos_bench EXCLUDE_FROM_ALL
+    ${PROJECT_SOURCE_DIR}/bench/bench.c ${BENCH_SOURCES})
+target_link_libraries(freertos_bench ${BENCH_LIBRARIES})
+
+add_executable(freertos_queue_batch EXCLUDE_FROM_ALL
+    ${PROJECT_SOURCE_DIR}/bench/queue_batch.c ${BENCH_SOURCES})
+target_link_libraries(freertos_queue_batch ${BENCH_LIBRARIES})
+
+add_executable(freertos_stream_buffer EXCLUDE_FROM_ALL
+    ${PROJECT_SOURCE_DIR}/bench/stream_buffer.c ${BENCH_SOURCES})
+target_link_libraries(freertos_stream_buffer ${BENCH_LIBRARIES})
+
+add_executable(freertos_timer_wheel EXCLUDE_FROM_ALL
+    ${PROJECT_SOURCE_DIR}/bench/timer_wheel.c ${BENCH_SOURCES})
+target_link_libraries(freertos_timer_wheel ${BENCH_LIBRARIES})
+
+add_executable(freertos_delayed_tasks EXCLUDE_FROM_ALL
+    ${PROJECT_SOURCE_DIR}/bench/delayed_tasks.c ${BENCH_SOURCES})
+target_link_libraries(freertos_delayed_tasks ${BENCH_LIBRARIES})
+
+add_executable(freertos_heap_alloc EXCLUDE_FROM_ALL
+    ${PROJECT_SOURCE_DIR}/bench/heap_alloc.c ${BENCH_SOURCES})
+target_link_libraries(freertos_heap_alloc ${BENCH_LIBRARIES})
+
+add_executable(freertos_object_pools EXCLUDE_FROM_ALL
+    ${PROJECT_SOURCE_DIR}/bench/object_pools.c ${BENCH_SOURCES})
+target_link_libraries(freertos_object_pools ${BENCH_LIBRARIES})
@@ -71,11 +71,12 @@
 #define configUSE_TICK_HOOK             0
 #define configTICK_RATE_HZ              ( ( TickType_t ) 1000 )
 #define configMINIMAL_STACK_SIZE        ( ( unsigned short ) 4 ) /* This can be made smaller if required. */
-#define configTOTAL_HEAP_SIZE           ( ( size_t ) ( 32 * 1024 ) )
+#define configTOTAL_HEAP_SIZE           ( ( size_t ) ( 16 * 1024 * 1024 ) ) /* Only used by the size class heap. */
 #define configMAX_TASK_NAME_LEN         ( 16 )
 #define configUSE_TRACE_FACILITY        1
 #define configUSE_STATS_FORMATTING_FUNCTIONS 1
 #define configGENERATE_RUN_TIME_STATS   1
+#define configRUN_TIME_COUNTER_TYPE     uint64_t /* Nanoseconds on the PC port. */
 #define configUSE_16_BIT_TICKS          0
 #define configIDLE_SHOULD_YIELD         1
 #define configUSE_CO_ROUTINES           1
@@ -88,10 +89,42 @@
 #define configUSE_APPLICATION_TASK_TAG  1
 #define configQUEUE_REGISTRY_SIZE       0
 #define configMAX_SYSCALL_INTERRUPT_PRIORITY    1
+#define configUSE_FUTEX_CONTEXT_SWITCH  1 /* Set to 0 to switch tasks using SIG_SUSPEND/SIG_RESUME. */
+#define configFUTEX_SPIN_NS             20000 /* Spin of a switched out thread before it sleeps, multi-core hosts only. */
+#define configTHREAD_POOL_SIZE          16 /* Host threads kept for reuse by new tasks. */
+#define configTHREAD_POOL_STACK_DEPTH   5120 /* Stack depth of pooled threads, as for the demo tasks. */
+#define configMAX_STATIC_TASKS          48 /* Tasks at a time with static thread states, the limit without pvPortMalloc(). */
+#define configHOST_STACK_SCALE          16 /* Host thread stack per byte of task stack. */
+#define configUSE_TICK_THREAD           1 /* Set to 0 to generate the tick with setitimer(). */
+#define configUSE_TICKLESS_IDLE         1 /* Requires configUSE_TICK_THREAD. */
+#define configUSE_VIRTUAL_TIME          0 /* Set to 1 to simulate faster than real time. */
+#define configVIRTUAL_TICK_BUDGET_US    100 /* Real time per tick while tasks are runnable. */
+#define configNUMBER_OF_CORES           1 /* Above 1 needs SINGLE_THREAD_PORT and no tickless idle. */
+#define configUSE_DELAYED_TASK_WHEEL    1 /* O(1) blocking with many delayed tasks. */
+#define configUSE_SIZE_CLASS_HEAP       0 /* Set to 1 to allocate from configTOTAL_HEAP_SIZE with heap_6.c. */
+#define configTASK_POOL_SIZE            64 /* TCBs and stacks created without the heap, see object_pool.h. */
+#define configTASK_POOL_STACK_DEPTH     256
+#define configQUEUE_POOL_SIZE           64
+#define configQUEUE_POOL_STORAGE_SIZE   256 /* Bytes of items per pooled queue. */
+#define configTIMER_POOL_SIZE           64
+#define configSUPPORT_STATIC_ALLOCATION 1 /* The TUM libraries then create their objects statically. */
+#ifdef STATIC_ALLOCATION_ONLY
+#define configSUPPORT_DYNAMIC_ALLOCATION 0 /* Set by STATIC_ALLOCATION_ONLY=ON, which links no heap. */
+#else
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#endif
+#define configKERNEL_PROVIDED_STATIC_MEMORY 1 /* Set to 0 to provide the idle and timer task memory in the application. */
+#define configSTREAM_BUFFER_INTERRUPT   30 /* Wakes stream buffer readers for host threads, TUM_Print uses 31. */
 
 #define configMAX_PRIORITIES        ( 10 )
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
 
+#define configUSE_TIMERS                1 /* The daemon also runs the deferred FromISR event group calls. */
+#define configTIMER_TASK_PRIORITY       ( 2 ) /* Above the drawing tasks and benchmarks, below the demo services at configMAX_PRIORITIES - 1. */
+#define configTIMER_QUEUE_LENGTH        16
+#define configTIMER_TASK_STACK_DEPTH    5120 /* As for the demo tasks. */
+#define configUSE_TIMER_WHEEL           1 /* O(1) timer start, reset and expiry for many timers. */
+
 /* Set the following definitions to 1 to include the API function, or zero
  to exclude the API function. */
 
@@ -102,8 +135,9 @@
 #define INCLUDE_vTaskSuspend                1
 #define INCLUDE_vTaskDelayUntil             1
 #define INCLUDE_vTaskDelay                  1
-#define INCLUDE_uxTaskGetStackHighWaterMark 0 /* Do not use this option on the PC port. */
+#define INCLUDE_uxTaskGetStackHighWaterMark 1 /* Measures the host stacks, see portmacro.h. */
 #define INCLUDE_xTaskGetSchedulerState      1
+#define INCLUDE_xTimerPendFunctionCall      1
 
 extern void vMainQueueSendPassed(void);
 #define traceQUEUE_SEND( pxQueue ) vMainQueueSendPassed()
@@ -37,6 +37,9 @@
 #include <string.h>
 #include <pthread.h>
 
+#include "FreeRTOS.h"
+#include "stream_buffer.h"
+
 #include "AsyncIO.h"
 
 #define PRINT_CHECK                                                            \
@@ -697,3 +700,13 @@ error_IO:
     PRINT_CHECK;
     return NULL;
 }
+
+void aIOStreamBufferCallback(size_t recv_size, char *buffer, void *args)
+{
+    StreamBufferHandle_t stream = (StreamBufferHandle_t)args;
+
+    if (stream && recv_size) {
+        // Callbacks run on host threads, which must not enter the kernel
+        xStreamBufferSendFromHost(stream, buffer, recv_size);
+    }
+}
@@ -157,5 +157,22 @@ aIO_handle_t aIOOpenUDPSocket(char *s_addr, in_port_t port, size_t buffer_size,
 aIO_handle_t aIOOpenTCPSocket(char *s_addr, in_port_t port, size_t buffer_size,
                               aIO_callback_t callback, void *args);
 
+/**
+ * @brief Callback that streams the received data into a FreeRTOS stream or
+ * message buffer
+ *
+ * Pass it as the callback of a connection, and the StreamBufferHandle_t or
+ * MessageBufferHandle_t as its args, to have a single task receive the
+ * connection's data with xStreamBufferReceive() or xMessageBufferReceive()
+ * instead of handling it in the callback. Stream buffers take what fits of
+ * the data, message buffers take each received chunk, eg. a UDP datagram, as
+ * one message if it fits whole. Data that does not fit is dropped.
+ *
+ * @param recv_size The number of bytes received
+ * @param buffer Buffer containing the received data
+ * @param args The stream or message buffer the data is written to
+ */
+void aIOStreamBufferCallback(size_t recv_size, char *buffer, void *args);
+
 /** @} */
 #endif
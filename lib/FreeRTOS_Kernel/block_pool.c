@@ -0,0 +1,283 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <stddef.h>
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "block_pool.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* The blocks follow the pool structure, at the next aligned address. */
+#define poolHEADER_SIZE                                                         \
+    ((sizeof(BlockPool_t) + portBYTE_ALIGNMENT_MASK) &                         \
+     ~((size_t)portBYTE_ALIGNMENT_MASK))
+
+/*
+ * Asserts that pvBlock is the start of one of the pool's blocks.
+ */
+#define poolASSERT_BLOCK(pxPool, pvBlock)                                      \
+    configASSERT(((uint8_t *)(pvBlock) >= (pxPool)->pucBlocks) &&              \
+                 ((size_t)((uint8_t *)(pvBlock) - (pxPool)->pucBlocks) <       \
+                  (pxPool)->xBlockSize * (size_t)(pxPool)->uxBlockCount) &&    \
+                 (((size_t)((uint8_t *)(pvBlock) - (pxPool)->pucBlocks) %      \
+                   (pxPool)->xBlockSize) == 0))
+
+/* The free blocks are kept as pointers in a queue, so that a task can block
+on the queue until a block is freed and interrupts can free blocks. */
+typedef struct BlockPoolDefinition {
+    QueueHandle_t xFreeBlocks; /*< Holds a pointer to each free block. */
+    uint8_t *pucBlocks;        /*< Points to the first block. */
+    size_t xBlockSize;         /*< The size of each block, aligned. */
+    UBaseType_t uxBlockCount;  /*< The number of blocks in the pool. */
+    uint8_t ucStaticallyAllocated; /*< pdTRUE if the memory is not freed. */
+} BlockPool_t;
+
+/*
+ * Points the pool at its blocks and queues each of them as free.
+ */
+static void prvInitialiseNewBlockPool(BlockPool_t *const pxPool, uint8_t *const pucBlocks, size_t xBlockSize, UBaseType_t uxBlockCount) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+
+BlockPoolHandle_t xBlockPoolCreate(size_t xBlockSize, UBaseType_t uxBlockCount)
+{
+    BlockPool_t *pxPool;
+
+    configASSERT(xBlockSize > (size_t)0);
+    configASSERT(uxBlockCount > (UBaseType_t)0);
+
+    xBlockSize = (xBlockSize + portBYTE_ALIGNMENT_MASK) &
+                 ~((size_t)portBYTE_ALIGNMENT_MASK);
+
+    pxPool = (BlockPool_t *)pvPortMalloc(poolHEADER_SIZE +
+                                         (xBlockSize * (size_t)uxBlockCount));
+    if (pxPool == NULL) {
+        return NULL;
+    }
+
+    pxPool->xFreeBlocks = xQueueCreate(uxBlockCount, sizeof(void *));
+    if (pxPool->xFreeBlocks == NULL) {
+        vPortFree(pxPool);
+        return NULL;
+    }
+
+    pxPool->ucStaticallyAllocated = pdFALSE;
+    prvInitialiseNewBlockPool(pxPool, ((uint8_t *)pxPool) + poolHEADER_SIZE,
+                              xBlockSize, uxBlockCount);
+
+    return (BlockPoolHandle_t)pxPool;
+}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+BlockPoolHandle_t xBlockPoolCreateStatic(size_t xBlockSize,
+                                         UBaseType_t uxBlockCount,
+                                         uint8_t *pucPoolStorage,
+                                         StaticBlockPool_t *pxStaticBlockPool)
+{
+    BlockPool_t *const pxPool = (BlockPool_t *)pxStaticBlockPool;
+
+    configASSERT(xBlockSize > (size_t)0);
+    configASSERT(uxBlockCount > (UBaseType_t)0);
+    configASSERT(((size_t)pucPoolStorage & portBYTE_ALIGNMENT_MASK) == 0);
+
+    /* The dummy structure must hold the real one ahead of the queue. */
+    configASSERT(sizeof(BlockPool_t) <=
+                 offsetof(StaticBlockPool_t, xDummy5));
+
+    if ((pucPoolStorage == NULL) || (pxStaticBlockPool == NULL)) {
+        return NULL;
+    }
+
+    xBlockSize = (xBlockSize + portBYTE_ALIGNMENT_MASK) &
+                 ~((size_t)portBYTE_ALIGNMENT_MASK);
+
+    /* The pointers to the free blocks are stored after the blocks. */
+    pxPool->xFreeBlocks = xQueueCreateStatic(
+                              uxBlockCount, sizeof(void *),
+                              pucPoolStorage + (xBlockSize * (size_t)uxBlockCount),
+                              &pxStaticBlockPool->xDummy5);
+
+    pxPool->ucStaticallyAllocated = pdTRUE;
+    prvInitialiseNewBlockPool(pxPool, pucPoolStorage, xBlockSize,
+                              uxBlockCount);
+
+    return (BlockPoolHandle_t)pxPool;
+}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewBlockPool(BlockPool_t *const pxPool,
+                                      uint8_t *const pucBlocks,
+                                      size_t xBlockSize,
+                                      UBaseType_t uxBlockCount)
+{
+    uint8_t *pucBlock;
+    UBaseType_t x;
+
+    pxPool->pucBlocks = pucBlocks;
+    pxPool->xBlockSize = xBlockSize;
+    pxPool->uxBlockCount = uxBlockCount;
+
+    for (x = 0; x < uxBlockCount; x++) {
+        pucBlock = pxPool->pucBlocks + (x * xBlockSize);
+        (void)xQueueSend(pxPool->xFreeBlocks, &pucBlock, 0);
+    }
+}
+/*-----------------------------------------------------------*/
+
+void *pvBlockPoolAllocate(BlockPoolHandle_t xPool, TickType_t xTicksToWait)
+{
+    BlockPool_t *const pxPool = (BlockPool_t *)xPool;
+    void *pvBlock;
+
+    configASSERT(pxPool);
+
+    if (xQueueReceive(pxPool->xFreeBlocks, &pvBlock, xTicksToWait) !=
+        pdPASS) {
+        return NULL;
+    }
+
+    return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vBlockPoolFree(BlockPoolHandle_t xPool, void *pvBlock)
+{
+    BlockPool_t *const pxPool = (BlockPool_t *)xPool;
+
+    configASSERT(pxPool);
+    poolASSERT_BLOCK(pxPool, pvBlock);
+
+    /* There is always room, as only blocks of this pool are queued. */
+    (void)xQueueSend(pxPool->xFreeBlocks, &pvBlock, 0);
+}
+/*-----------------------------------------------------------*/
+
+void vBlockPoolFreeFromISR(BlockPoolHandle_t xPool, void *pvBlock,
+                           BaseType_t *const pxHigherPriorityTaskWoken)
+{
+    BlockPool_t *const pxPool = (BlockPool_t *)xPool;
+
+    configASSERT(pxPool);
+    poolASSERT_BLOCK(pxPool, pvBlock);
+
+    (void)xQueueSendFromISR(pxPool->xFreeBlocks, &pvBlock,
+                            pxHigherPriorityTaskWoken);
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxBlockPoolGetFree(BlockPoolHandle_t xPool)
+{
+    BlockPool_t *const pxPool = (BlockPool_t *)xPool;
+
+    configASSERT(pxPool);
+
+    return uxQueueMessagesWaiting(pxPool->xFreeBlocks);
+}
+/*-----------------------------------------------------------*/
+
+void vBlockPoolDelete(BlockPoolHandle_t xPool)
+{
+    BlockPool_t *const pxPool = (BlockPool_t *)xPool;
+
+    configASSERT(pxPool);
+
+    vQueueDelete(pxPool->xFreeBlocks);
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    if (pxPool->ucStaticallyAllocated == pdFALSE) {
+        vPortFree(pxPool);
+    }
+    else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
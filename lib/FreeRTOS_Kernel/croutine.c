@@ -141,6 +141,9 @@ static void prvCheckDelayedList(void);
 
 /*-----------------------------------------------------------*/
 
+/* Co-routine control blocks only come from the heap. */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
 BaseType_t xCoRoutineCreate(crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPriority, UBaseType_t uxIndex)
 {
     BaseType_t xReturn;
@@ -192,6 +195,8 @@ BaseType_t xCoRoutineCreate(crCOROUTINE_CODE pxCoRoutineCode, UBaseType_t uxPrio
 
     return xReturn;
 }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
 void vCoRoutineAddToDelayedList(TickType_t xTicksToDelay, List_t *pxEventList)
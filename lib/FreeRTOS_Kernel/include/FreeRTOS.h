@@ -294,6 +294,12 @@ extern "C" {
 #error If configUSE_TIMERS is set to 1 then configTIMER_TASK_STACK_DEPTH must also be defined.
 #endif /* configTIMER_TASK_STACK_DEPTH */
 
+#ifndef configUSE_TIMER_WHEEL
+/* Set to 1 to keep the active timers in a hierarchical timer wheel rather than
+in sorted lists. */
+#define configUSE_TIMER_WHEEL 0
+#endif /* configUSE_TIMER_WHEEL */
+
 #endif /* configUSE_TIMERS */
 
 #ifndef portSET_INTERRUPT_MASK_FROM_ISR
@@ -316,6 +322,27 @@ extern "C" {
 #define portSETUP_TCB( pxTCB ) ( void ) pxTCB
 #endif
 
+#ifndef portHAS_STACK_OVERFLOW_CHECKING
+#define portHAS_STACK_OVERFLOW_CHECKING 0
+#endif
+
+#ifndef configNUMBER_OF_CORES
+#define configNUMBER_OF_CORES 1
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+/* Ports that run tasks on more than one core say which core the caller runs
+on, make another core select a task to run, provide the lock held while the
+scheduler is suspended and mask the interrupts of the calling core only. */
+#if !defined( portGET_CORE_ID ) || !defined( portYIELD_CORE ) || !defined( portGET_TASK_LOCK ) || !defined( portRELEASE_TASK_LOCK )
+#error The port does not support configNUMBER_OF_CORES greater than 1
+#endif
+#endif
+
+#ifndef portWAIT_FOR_INTERRUPT
+#define portWAIT_FOR_INTERRUPT()
+#endif
+
 #ifndef configQUEUE_REGISTRY_SIZE
 #define configQUEUE_REGISTRY_SIZE 0U
 #endif
@@ -680,6 +707,12 @@ task that attempted the write. */
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #endif
 
+#ifndef configRUN_TIME_COUNTER_TYPE
+/* Defaults to uint32_t for backward compatibility, ports with a fast run time
+stats clock can use a uint64_t counter to avoid overflows. */
+#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
 #ifndef configUSE_MALLOC_FAILED_HOOK
 #define configUSE_MALLOC_FAILED_HOOK 0
 #endif
@@ -708,6 +741,44 @@ task that attempted the write. */
 #define configUSE_TICKLESS_IDLE 0
 #endif
 
+#ifndef configUSE_DELAYED_TASK_WHEEL
+/* Set to 1 to reference delayed tasks from a hierarchical timing wheel rather
+than from sorted lists. */
+#define configUSE_DELAYED_TASK_WHEEL 0
+#endif
+
+#ifndef configUSE_SIZE_CLASS_HEAP
+/* Set to 1 to allocate from the configTOTAL_HEAP_SIZE array with heap_6.c
+rather than from the host with heap_3.c. */
+#define configUSE_SIZE_CLASS_HEAP 0
+#endif
+
+#ifndef configTASK_POOL_SIZE
+/* The number of TCBs, and of stacks of up to configTASK_POOL_STACK_DEPTH words,
+object_pool.c keeps for dynamically created tasks.  0 allocates them all with
+pvPortMalloc(). */
+#define configTASK_POOL_SIZE 0
+#endif
+
+#ifndef configTASK_POOL_STACK_DEPTH
+#define configTASK_POOL_STACK_DEPTH configMINIMAL_STACK_SIZE
+#endif
+
+#ifndef configQUEUE_POOL_SIZE
+/* Likewise for queues, semaphores and mutexes with up to
+configQUEUE_POOL_STORAGE_SIZE bytes of items. */
+#define configQUEUE_POOL_SIZE 0
+#endif
+
+#ifndef configQUEUE_POOL_STORAGE_SIZE
+#define configQUEUE_POOL_STORAGE_SIZE 0
+#endif
+
+#ifndef configTIMER_POOL_SIZE
+/* Likewise for software timers. */
+#define configTIMER_POOL_SIZE 0
+#endif
+
 #ifndef configPRE_SLEEP_PROCESSING
 #define configPRE_SLEEP_PROCESSING( x )
 #endif
@@ -772,6 +843,16 @@ task that attempted the write. */
 #define portTICK_TYPE_IS_ATOMIC 0
 #endif
 
+#ifndef configMESSAGE_BUFFER_LENGTH_TYPE
+#define configMESSAGE_BUFFER_LENGTH_TYPE size_t
+#endif
+
+#ifndef configSTREAM_BUFFER_INTERRUPT
+/* The simulated interrupt that wakes readers of stream buffers written by host
+threads. */
+#define configSTREAM_BUFFER_INTERRUPT 30
+#endif
+
 #ifndef configSUPPORT_STATIC_ALLOCATION
 /* Defaults to 0 for backward compatibility. */
 #define configSUPPORT_STATIC_ALLOCATION 0
@@ -782,6 +863,13 @@ task that attempted the write. */
 #define configSUPPORT_DYNAMIC_ALLOCATION 1
 #endif
 
+#ifndef configKERNEL_PROVIDED_STATIC_MEMORY
+/* Set to 1 for tasks.c and timers.c to define the vApplicationGet...Memory()
+callbacks with buffers of configMINIMAL_STACK_SIZE and
+configTIMER_TASK_STACK_DEPTH words, otherwise the application defines them. */
+#define configKERNEL_PROVIDED_STATIC_MEMORY 0
+#endif
+
 /* Sanity check the configuration. */
 #if( configUSE_TICKLESS_IDLE != 0 )
 #if( INCLUDE_vTaskSuspend != 1 )
@@ -793,6 +881,15 @@ task that attempted the write. */
 #error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
 
+#if( configNUMBER_OF_CORES > 1 )
+#if( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 )
+#error configUSE_PORT_OPTIMISED_TASK_SELECTION must be 0 if configNUMBER_OF_CORES is greater than 1
+#endif
+#if( configUSE_TICKLESS_IDLE != 0 )
+#error configUSE_TICKLESS_IDLE must be 0 if configNUMBER_OF_CORES is greater than 1
+#endif
+#endif /* configNUMBER_OF_CORES */
+
 #if( ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
 #error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
@@ -912,6 +1009,9 @@ typedef struct xSTATIC_TCB {
 #endif
     StaticListItem_t    xDummy3[ 2 ];
     UBaseType_t         uxDummy5;
+#if ( configNUMBER_OF_CORES > 1 )
+    BaseType_t          xDummy23;
+#endif
     void                *pxDummy6;
     uint8_t             ucDummy7[ configMAX_TASK_NAME_LEN ];
 #if ( portSTACK_GROWTH > 0 )
@@ -933,7 +1033,7 @@ typedef struct xSTATIC_TCB {
     void            *pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 #endif
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
-    uint32_t        ulDummy16;
+    configRUN_TIME_COUNTER_TYPE ulDummy16;
 #endif
 #if ( configUSE_NEWLIB_REENTRANT == 1 )
     struct  _reent  xDummy17;
@@ -945,6 +1045,9 @@ typedef struct xSTATIC_TCB {
 #if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
     uint8_t         uxDummy20;
 #endif
+#if( INCLUDE_xTaskAbortDelay == 1 )
+    uint8_t         ucDummy21;
+#endif
 
 } StaticTask_t;
 
@@ -1048,6 +1151,29 @@ typedef struct xSTATIC_TIMER {
 
 } StaticTimer_t;
 
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the stream buffer structure used
+ * internally by FreeRTOS is not accessible to application code.  However, if
+ * the application writer wants to statically allocate the memory required to
+ * create a stream buffer or message buffer then the size of the stream buffer
+ * object needs to be know.  The StaticStreamBuffer_t structure below is
+ * provided for this purpose.  Its size and alignment requirements are
+ * guaranteed to match those of the genuine structure, no matter which
+ * architecture is being used, and no matter how the values in FreeRTOSConfig.h
+ * are set.  Its contents are somewhat obfuscated in the hope users will
+ * recognise that it would be unwise to make direct use of the structure
+ * members.
+ */
+typedef struct xSTATIC_STREAM_BUFFER {
+    size_t              uxDummy1[ 4 ];
+    void                *pvDummy2[ 3 ];
+    uint8_t             ucDummy3;
+    void                *pvDummy4;
+} StaticStreamBuffer_t;
+typedef StaticStreamBuffer_t StaticMessageBuffer_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,266 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+#ifndef BLOCK_POOL_H
+#define BLOCK_POOL_H
+
+#ifndef INC_FREERTOS_H
+#error "include FreeRTOS.h must appear in source files before include block_pool.h"
+#endif
+
+#include "queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * block_pool.h
+ *
+ * Type by which block pools are referenced.  A block pool hands out blocks of
+ * one fixed size from storage allocated when the pool is created, so
+ * allocating and freeing a block never touches the heap.  Together with the
+ * by-reference queue functions in queue.h, e.g. xQueueSendReference(), a task
+ * can fill a block and pass the pointer to another task, which frees the block
+ * once done with it, without the contents ever being copied.
+ *
+ * \defgroup BlockPoolHandle_t BlockPoolHandle_t
+ * \ingroup BlockPool
+ */
+typedef void *BlockPoolHandle_t;
+
+/*
+ * The size and alignment of the pool structure, followed by the queue that
+ * holds the free blocks, for pools created with xBlockPoolCreateStatic().  Its
+ * contents are obfuscated as they must not be accessed directly.
+ */
+typedef struct xSTATIC_BLOCK_POOL {
+    void *pvDummy1[ 2 ];
+    size_t xDummy2;
+    UBaseType_t uxDummy3;
+    uint8_t ucDummy4;
+    StaticQueue_t xDummy5;
+} StaticBlockPool_t;
+
+/*
+ * The number of bytes of storage xBlockPoolCreateStatic() needs for
+ * uxBlockCount blocks of xBlockSize bytes, the blocks followed by a pointer to
+ * each free block.
+ */
+#define poolSTORAGE_SIZE_BYTES( xBlockSize, uxBlockCount ) ( ( ( ( ( size_t ) ( xBlockSize ) + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) ) + sizeof( void * ) ) * ( size_t ) ( uxBlockCount ) )
+
+/**
+ * block_pool.h
+ * <pre>
+ BlockPoolHandle_t xBlockPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount );
+ * </pre>
+ *
+ * Creates a pool of uxBlockCount blocks of xBlockSize bytes each, rounded up
+ * to portBYTE_ALIGNMENT.  The blocks and the pool are allocated in one go
+ * with pvPortMalloc().
+ *
+ * @param xBlockSize The size of each block in bytes.
+ *
+ * @param uxBlockCount The number of blocks in the pool.
+ *
+ * @return A handle to the pool, or NULL if it could not be allocated.
+ *
+ * \defgroup xBlockPoolCreate xBlockPoolCreate
+ * \ingroup BlockPool
+ */
+BlockPoolHandle_t xBlockPoolCreate(size_t xBlockSize, UBaseType_t uxBlockCount) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>
+ BlockPoolHandle_t xBlockPoolCreateStatic( size_t xBlockSize, UBaseType_t uxBlockCount, uint8_t *pucPoolStorage, StaticBlockPool_t *pxStaticBlockPool );
+ * </pre>
+ *
+ * Creates a pool like xBlockPoolCreate(), in memory provided by the caller.
+ * vBlockPoolDelete() does not free the memory.
+ *
+ * @param pucPoolStorage At least poolSTORAGE_SIZE_BYTES( xBlockSize,
+ * uxBlockCount ) bytes aligned to portBYTE_ALIGNMENT, which hold the blocks.
+ *
+ * @param pxStaticBlockPool Holds the pool's structure.
+ *
+ * @return A handle to the pool, or NULL if either buffer is NULL.
+ *
+ * Example usage:
+   <pre>
+ #define FRAME_SIZE 1024
+ #define FRAME_COUNT 4
+
+ static uint8_t ucFrameStorage[ poolSTORAGE_SIZE_BYTES( FRAME_SIZE, FRAME_COUNT ) ] __attribute__((aligned(portBYTE_ALIGNMENT)));
+ static StaticBlockPool_t xFramePoolBuffer;
+
+    xFramePool = xBlockPoolCreateStatic( FRAME_SIZE, FRAME_COUNT, ucFrameStorage, &xFramePoolBuffer );
+ </pre>
+ * \defgroup xBlockPoolCreateStatic xBlockPoolCreateStatic
+ * \ingroup BlockPool
+ */
+BlockPoolHandle_t xBlockPoolCreateStatic(size_t xBlockSize, UBaseType_t uxBlockCount, uint8_t *pucPoolStorage, StaticBlockPool_t *pxStaticBlockPool) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>
+ void *pvBlockPoolAllocate( BlockPoolHandle_t xPool, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Takes a block from the pool, blocking for up to xTicksToWait if all blocks
+ * are allocated.  The contents of the block are undefined.
+ *
+ * @param xPool The pool to allocate from.
+ *
+ * @param xTicksToWait The maximum amount of time to wait for a block to be
+ * freed, should none be left.
+ *
+ * @return The block, or NULL if none was freed in time.
+ *
+ * Example usage:
+   <pre>
+ // Pass a 1 KiB frame to another task without copying it.
+ uint8_t *pucFrame = pvBlockPoolAllocate( xFramePool, portMAX_DELAY );
+
+    vFillFrame( pucFrame );
+    xQueueSendReference( xFrameQueue, pucFrame, portMAX_DELAY );
+
+ // In the receiving task.
+    pucFrame = pvQueueReceiveReference( xFrameQueue, portMAX_DELAY );
+    vDrawFrame( pucFrame );
+    vBlockPoolFree( xFramePool, pucFrame );
+ </pre>
+ * \defgroup pvBlockPoolAllocate pvBlockPoolAllocate
+ * \ingroup BlockPool
+ */
+void *pvBlockPoolAllocate(BlockPoolHandle_t xPool, TickType_t xTicksToWait) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>
+ void vBlockPoolFree( BlockPoolHandle_t xPool, void *pvBlock );
+ * </pre>
+ *
+ * Returns a block allocated from xPool, waking a task waiting for one.
+ *
+ * \defgroup vBlockPoolFree vBlockPoolFree
+ * \ingroup BlockPool
+ */
+void vBlockPoolFree(BlockPoolHandle_t xPool, void *pvBlock) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>
+ void vBlockPoolFreeFromISR( BlockPoolHandle_t xPool, void *pvBlock, BaseType_t *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * A version of vBlockPoolFree() that can be called from an interrupt service
+ * routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if freeing the block woke a
+ * task of a higher priority than the interrupted one.
+ *
+ * \defgroup vBlockPoolFreeFromISR vBlockPoolFreeFromISR
+ * \ingroup BlockPool
+ */
+void vBlockPoolFreeFromISR(BlockPoolHandle_t xPool, void *pvBlock, BaseType_t *const pxHigherPriorityTaskWoken) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>
+ UBaseType_t uxBlockPoolGetFree( BlockPoolHandle_t xPool );
+ * </pre>
+ *
+ * @return The number of blocks that are not allocated.
+ *
+ * \defgroup uxBlockPoolGetFree uxBlockPoolGetFree
+ * \ingroup BlockPool
+ */
+UBaseType_t uxBlockPoolGetFree(BlockPoolHandle_t xPool) PRIVILEGED_FUNCTION;
+
+/**
+ * block_pool.h
+ * <pre>
+ void vBlockPoolDelete( BlockPoolHandle_t xPool );
+ * </pre>
+ *
+ * Frees the pool and with it all its blocks, which must no longer be in use.
+ * The memory of a pool created with xBlockPoolCreateStatic() is not freed.
+ *
+ * \defgroup vBlockPoolDelete vBlockPoolDelete
+ * \ingroup BlockPool
+ */
+void vBlockPoolDelete(BlockPoolHandle_t xPool) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLOCK_POOL_H */
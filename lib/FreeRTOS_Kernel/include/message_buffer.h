@@ -0,0 +1,254 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * Message buffers pass variable length messages from a single writer to a
+ * single reader.  They are stream buffers that store the length of each
+ * message, as a configMESSAGE_BUFFER_LENGTH_TYPE, in front of it, and that
+ * write and read whole messages only.  The same rules as for stream buffers
+ * apply, see stream_buffer.h.
+ */
+
+#ifndef MESSAGE_BUFFER_H
+#define MESSAGE_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+#error "include FreeRTOS.h must appear in source files before include message_buffer.h"
+#endif
+
+/* Message buffers are built on stream buffers. */
+#include "stream_buffer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * message_buffer.h
+ *
+ * Type by which message buffers are referenced.
+ */
+typedef void *MessageBufferHandle_t;
+
+/**
+ * message_buffer.h
+ * <pre>
+ MessageBufferHandle_t xMessageBufferCreate( size_t xBufferSizeBytes );
+ * </pre>
+ *
+ * Creates a message buffer of xBufferSizeBytes bytes, which includes the
+ * sizeof( configMESSAGE_BUFFER_LENGTH_TYPE ) bytes stored with each message.
+ *
+ * @return A handle to the message buffer, or NULL if it could not be
+ * allocated.
+ *
+ * \defgroup xMessageBufferCreate xMessageBufferCreate
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCreate( xBufferSizeBytes ) ( MessageBufferHandle_t ) xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, pdTRUE )
+
+/**
+ * message_buffer.h
+ * <pre>
+ MessageBufferHandle_t xMessageBufferCreateStatic( size_t xBufferSizeBytes, uint8_t *pucMessageBufferStorageArea, StaticMessageBuffer_t *pxStaticMessageBuffer );
+ * </pre>
+ *
+ * Creates a message buffer like xMessageBufferCreate(), in memory provided by
+ * the caller.  vMessageBufferDelete() does not free the memory.
+ *
+ * @param pucMessageBufferStorageArea At least xBufferSizeBytes + 1 bytes, which
+ * hold the messages.
+ *
+ * @param pxStaticMessageBuffer Holds the message buffer's structure.
+ *
+ * @return A handle to the message buffer, or NULL if either buffer is NULL.
+ *
+ * \defgroup xMessageBufferCreateStatic xMessageBufferCreateStatic
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCreateStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( size_t ) 0, pdTRUE, ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ) )
+
+/**
+ * message_buffer.h
+ * <pre>
+ size_t xMessageBufferSend( MessageBufferHandle_t xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Copies a message into a message buffer, blocking for up to xTicksToWait
+ * for space for all of it.  A message is either written whole or not at all.
+ *
+ * @return The length of the message if it was written, otherwise 0.
+ *
+ * Example usage:
+   <pre>
+ void vSendLine( MessageBufferHandle_t xMessageBuffer, const char *pcLine )
+ {
+    // Each line is received as one message, however long it is.
+    if( xMessageBufferSend( xMessageBuffer, pcLine, strlen( pcLine ), portMAX_DELAY ) == 0 )
+    {
+        // The line is longer than the message buffer can ever hold.
+    }
+ }
+ </pre>
+ * \defgroup xMessageBufferSend xMessageBufferSend
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSend( xMessageBuffer, pvTxData, xDataLengthBytes, xTicksToWait ) xStreamBufferSend( ( StreamBufferHandle_t ) ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( xTicksToWait ) )
+
+/**
+ * message_buffer.h
+ * <pre>
+ size_t xMessageBufferSendFromISR( MessageBufferHandle_t xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * A version of xMessageBufferSend() that can be called from an interrupt
+ * service routine, it does not block.
+ *
+ * \defgroup xMessageBufferSendFromISR xMessageBufferSendFromISR
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendFromISR( xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferSendFromISR( ( StreamBufferHandle_t ) ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ * <pre>
+ size_t xMessageBufferSendFromHost( MessageBufferHandle_t xMessageBuffer, const void *pvTxData, size_t xDataLengthBytes );
+ * </pre>
+ *
+ * A version of xMessageBufferSend() for host threads that are not tasks, see
+ * xStreamBufferSendFromHost().
+ *
+ * \defgroup xMessageBufferSendFromHost xMessageBufferSendFromHost
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendFromHost( xMessageBuffer, pvTxData, xDataLengthBytes ) xStreamBufferSendFromHost( ( StreamBufferHandle_t ) ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ) )
+
+/**
+ * message_buffer.h
+ * <pre>
+ size_t xMessageBufferReceive( MessageBufferHandle_t xMessageBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Copies the next message out of a message buffer, blocking for up to
+ * xTicksToWait for one to arrive.  A message longer than xBufferLengthBytes
+ * is left in the message buffer.
+ *
+ * @return The length of the message received, or 0 if there was none or it
+ * did not fit pvRxData.
+ *
+ * \defgroup xMessageBufferReceive xMessageBufferReceive
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceive( xMessageBuffer, pvRxData, xBufferLengthBytes, xTicksToWait ) xStreamBufferReceive( ( StreamBufferHandle_t ) ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( xTicksToWait ) )
+
+/**
+ * message_buffer.h
+ * <pre>
+ size_t xMessageBufferReceiveFromISR( MessageBufferHandle_t xMessageBuffer, void *pvRxData, size_t xBufferLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * A version of xMessageBufferReceive() that can be called from an interrupt
+ * service routine, it does not block.
+ *
+ * \defgroup xMessageBufferReceiveFromISR xMessageBufferReceiveFromISR
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveFromISR( xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferReceiveFromISR( ( StreamBufferHandle_t ) ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ * <pre>
+ size_t xMessageBufferNextLengthBytes( MessageBufferHandle_t xMessageBuffer );
+ * </pre>
+ *
+ * @return The length of the next message, or 0 if the message buffer is
+ * empty.
+ *
+ * \defgroup xMessageBufferNextLengthBytes xMessageBufferNextLengthBytes
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferNextLengthBytes( xMessageBuffer ) xStreamBufferNextMessageLengthBytes( ( StreamBufferHandle_t ) ( xMessageBuffer ) )
+
+/**
+ * message_buffer.h
+ *
+ * The remaining functions are those of stream buffers.
+ */
+#define vMessageBufferDelete( xMessageBuffer ) vStreamBufferDelete( ( StreamBufferHandle_t ) ( xMessageBuffer ) )
+#define xMessageBufferIsFull( xMessageBuffer ) xStreamBufferIsFull( ( StreamBufferHandle_t ) ( xMessageBuffer ) )
+#define xMessageBufferIsEmpty( xMessageBuffer ) xStreamBufferIsEmpty( ( StreamBufferHandle_t ) ( xMessageBuffer ) )
+#define xMessageBufferReset( xMessageBuffer ) xStreamBufferReset( ( StreamBufferHandle_t ) ( xMessageBuffer ) )
+#define xMessageBufferSpaceAvailable( xMessageBuffer ) xStreamBufferSpacesAvailable( ( StreamBufferHandle_t ) ( xMessageBuffer ) )
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MESSAGE_BUFFER_H */
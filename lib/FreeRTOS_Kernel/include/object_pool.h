@@ -0,0 +1,162 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#ifndef INC_FREERTOS_H
+#error "include FreeRTOS.h must appear in source files before include object_pool.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * object_pool.h
+ *
+ * The pools the kernel takes its objects from when they are created
+ * dynamically.  Each pool is a static array of configTASK_POOL_SIZE,
+ * configQUEUE_POOL_SIZE or configTIMER_POOL_SIZE blocks, so creating and
+ * deleting an object that fits a block takes constant time and leaves the heap
+ * alone.  Objects that do not fit, or that find their pool empty, are
+ * allocated with pvPortMalloc() as before.
+ *
+ * \defgroup eObjectPool eObjectPool
+ * \ingroup ObjectPool
+ */
+typedef enum {
+    eTaskPool = 0,          /* TCBs. */
+    eStackPool,             /* Task stacks of up to configTASK_POOL_STACK_DEPTH words. */
+    eQueuePool,             /* Queues, semaphores and mutexes with up to configQUEUE_POOL_STORAGE_SIZE bytes of items. */
+    eTimerPool,             /* Software timers. */
+    eNumberOfObjectPools
+} eObjectPool;
+
+/**
+ * object_pool.h
+ *
+ * Used to pass information about a pool out of vObjectPoolGetStatus().
+ *
+ * \defgroup ObjectPoolStatus_t ObjectPoolStatus_t
+ * \ingroup ObjectPool
+ */
+typedef struct xOBJECT_POOL_STATUS {
+    size_t xBlockSize;              /* The size of each block in bytes. */
+    UBaseType_t uxBlocks;           /* The number of blocks in the pool, 0 if it is not used. */
+    UBaseType_t uxBlocksInUse;      /* The number of blocks currently allocated. */
+    UBaseType_t uxMaxBlocksInUse;   /* The most blocks that have been allocated at once, the high-water mark. */
+    UBaseType_t uxHeapAllocations;  /* The number of objects allocated with pvPortMalloc() instead, as they did not fit or the pool was empty. */
+} ObjectPoolStatus_t;
+
+/*
+ * Allocates xSize bytes for an object of the pool's type, from the pool if the
+ * object fits a block and a block is free, otherwise with pvPortMalloc().
+ * Only intended for use by the kernel.
+ */
+void *pvObjectPoolAllocate(eObjectPool ePool, size_t xSize) PRIVILEGED_FUNCTION;
+
+/*
+ * Frees memory allocated with pvObjectPoolAllocate() for the same pool.  Only
+ * intended for use by the kernel.
+ */
+void vObjectPoolFree(eObjectPool ePool, void *pv) PRIVILEGED_FUNCTION;
+
+/**
+ * object_pool.h
+ * <pre>
+ void vObjectPoolGetStatus( eObjectPool ePool, ObjectPoolStatus_t *pxStatus );
+ * </pre>
+ *
+ * Reports how many blocks of a pool are in use and have been at most, which
+ * tells whether the pool is sized right for the application.
+ *
+ * @param ePool The pool to report on.
+ *
+ * @param pxStatus Filled in with the status of the pool.
+ *
+ * Example usage:
+   <pre>
+ ObjectPoolStatus_t xStatus;
+
+    vObjectPoolGetStatus( eTaskPool, &xStatus );
+    printf( "%u of %u TCBs used at most, %u from the heap\n",
+            ( unsigned ) xStatus.uxMaxBlocksInUse, ( unsigned ) xStatus.uxBlocks,
+            ( unsigned ) xStatus.uxHeapAllocations );
+ </pre>
+ * \defgroup vObjectPoolGetStatus vObjectPoolGetStatus
+ * \ingroup ObjectPool
+ */
+void vObjectPoolGetStatus(eObjectPool ePool, ObjectPoolStatus_t *pxStatus) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OBJECT_POOL_H */
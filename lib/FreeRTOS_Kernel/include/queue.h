@@ -1012,6 +1012,199 @@ BaseType_t xQueuePeekFromISR(QueueHandle_t xQueue, void *const pvBuffer) PRIVILE
  */
 BaseType_t xQueueGenericReceive(QueueHandle_t xQueue, void *const pvBuffer, TickType_t xTicksToWait, const BaseType_t xJustPeek) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendMultiple(
+                                QueueHandle_t xQueue,
+                                const void *pvItems,
+                                UBaseType_t uxItemCount,
+                                TickType_t xTicksToWait
+                            );
+ * </pre>
+ *
+ * Post up to uxItemCount items to the back of a queue.  The items are copied
+ * under a single critical section, and the tasks waiting to receive them are
+ * woken with at most one context switch, rather than once per item as with
+ * repeated calls to xQueueSend().  If the queue is full the calling task
+ * blocks until there is room for at least one item, then posts as many as
+ * fit.  Cannot be used with semaphores or mutexes, nor from an interrupt
+ * service routine.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to uxItemCount items stored one after the other,
+ * each the item size the queue was created with.
+ *
+ * @param uxItemCount The number of items at pvItems.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it be full.
+ *
+ * @return The number of items posted, 0 if the queue stayed full.
+ *
+ * Example usage:
+   <pre>
+ uint32_t ulSamples[ 32 ];
+ UBaseType_t uxSent = 0;
+
+    // Post all samples, blocking whenever the queue is full.
+    while( uxSent < 32 )
+    {
+        uxSent += xQueueSendMultiple( xQueue, &( ulSamples[ uxSent ] ), 32 - uxSent, portMAX_DELAY );
+    }
+ </pre>
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultiple(QueueHandle_t xQueue, const void *const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueReceiveMultiple(
+                                QueueHandle_t xQueue,
+                                void *pvBuffer,
+                                UBaseType_t uxBufferCount,
+                                TickType_t xTicksToWait
+                            );
+ * </pre>
+ *
+ * Receive up to uxBufferCount items from a queue.  The items are copied under
+ * a single critical section, and the tasks waiting for space are woken with
+ * at most one context switch.  If the queue is empty the calling task blocks
+ * until at least one item is available, then receives as many as are
+ * waiting.  Cannot be used with semaphores or mutexes, nor from an interrupt
+ * service routine.
+ *
+ * @param xQueue The handle to the queue from which the items are received.
+ *
+ * @param pvBuffer Pointer to a buffer with room for uxBufferCount items, into
+ * which they are copied in the order they were posted.
+ *
+ * @param uxBufferCount The number of items pvBuffer can hold.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item, should the queue be empty.
+ *
+ * @return The number of items received, 0 if the queue stayed empty.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultiple(QueueHandle_t xQueue, void *const pvBuffer, const UBaseType_t uxBufferCount, TickType_t xTicksToWait) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ QueueHandle_t xQueueCreateByReference(
+                                UBaseType_t uxQueueLength
+                            );
+ * </pre>
+ *
+ * Creates a queue that passes blocks by reference, typically blocks of a
+ * pool created with xBlockPoolCreate().  Only the pointer to a block is copied
+ * into and out of the queue, whatever the block's size, and sending a block
+ * hands it over to the task that receives it, which frees it once done.
+ *
+ * Blocks are sent with xQueueSendReference() or pvQueueOverwriteReference()
+ * and received with pvQueueReceiveReference().
+ *
+ * @param uxQueueLength The maximum number of blocks the queue can hold.
+ *
+ * @return A handle to the queue, or NULL if it could not be created.
+ *
+ * \defgroup xQueueCreateByReference xQueueCreateByReference
+ * \ingroup QueueManagement
+ */
+#define xQueueCreateByReference( uxQueueLength ) xQueueGenericCreate( ( uxQueueLength ), sizeof( void * ), queueQUEUE_TYPE_BASE )
+
+/**
+ * queue. h
+ * <pre>
+ QueueHandle_t xQueueCreateByReferenceStatic(
+                                UBaseType_t uxQueueLength,
+                                uint8_t *pucQueueStorageBuffer,
+                                StaticQueue_t *pxQueueBuffer
+                            );
+ * </pre>
+ *
+ * Creates a queue like xQueueCreateByReference(), in memory provided by the
+ * caller.
+ *
+ * @param pucQueueStorageBuffer At least uxQueueLength * sizeof( void * )
+ * bytes, which hold the pointers to the queued blocks.
+ *
+ * @param pxQueueBuffer Holds the queue's structure.
+ *
+ * @return A handle to the queue, or NULL if pxQueueBuffer is NULL.
+ *
+ * \defgroup xQueueCreateByReferenceStatic xQueueCreateByReferenceStatic
+ * \ingroup QueueManagement
+ */
+#define xQueueCreateByReferenceStatic( uxQueueLength, pucQueueStorageBuffer, pxQueueBuffer ) xQueueGenericCreateStatic( ( uxQueueLength ), sizeof( void * ), ( pucQueueStorageBuffer ), ( pxQueueBuffer ), queueQUEUE_TYPE_BASE )
+
+/**
+ * queue. h
+ * <pre>
+ BaseType_t xQueueSendReference(
+                                QueueHandle_t xQueue,
+                                void *pvBlock,
+                                TickType_t xTicksToWait
+                            );
+ * </pre>
+ *
+ * Posts a block to the back of a queue created with
+ * xQueueCreateByReference().  The caller must not touch the block once it has
+ * been posted.
+ *
+ * @return pdPASS if the block was posted, otherwise errQUEUE_FULL, in which
+ * case the caller still owns the block.
+ *
+ * \defgroup xQueueSendReference xQueueSendReference
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendReference(QueueHandle_t xQueue, void *const pvBlock, TickType_t xTicksToWait) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ void *pvQueueReceiveReference(
+                                QueueHandle_t xQueue,
+                                TickType_t xTicksToWait
+                            );
+ * </pre>
+ *
+ * Receives a block from a queue created with xQueueCreateByReference().  The
+ * caller then owns the block.
+ *
+ * @return The block, or NULL if the queue stayed empty.
+ *
+ * \defgroup pvQueueReceiveReference pvQueueReceiveReference
+ * \ingroup QueueManagement
+ */
+void *pvQueueReceiveReference(QueueHandle_t xQueue, TickType_t xTicksToWait) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ void *pvQueueOverwriteReference(
+                                QueueHandle_t xQueue,
+                                void *pvBlock
+                            );
+ * </pre>
+ *
+ * The by-reference counterpart of xQueueOverwrite(), for queues created with
+ * xQueueCreateByReference( 1 ).  Posts pvBlock, replacing the block still held
+ * by the queue, which is handed back to the caller to free.
+ *
+ * @return The block that was replaced, or NULL if the queue was empty.
+ *
+ * \defgroup pvQueueOverwriteReference pvQueueOverwriteReference
+ * \ingroup QueueManagement
+ */
+void *pvQueueOverwriteReference(QueueHandle_t xQueue, void *const pvBlock) PRIVILEGED_FUNCTION;
+
 /**
  * queue. h
  * <pre>UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue );</pre>
@@ -0,0 +1,382 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/*
+ * Stream buffers pass a stream of bytes from a single writer, a task, an
+ * interrupt or a host thread, to a single reader task or interrupt.  The bytes
+ * are copied into and out of a circular buffer without a lock, the kernel is
+ * only entered to block the reader or the writer and to wake it again, so a
+ * stream of any chunk size crosses with one copy in and one copy out.
+ *
+ * There may only be one writer and one reader at a time.  If several tasks or
+ * interrupts write to the same stream buffer, or read from it, the writes, or
+ * reads, must be serialised, e.g. with a mutex or a critical section.
+ *
+ * A task blocked on a stream buffer waits on its task notification state, so
+ * it must not expect a direct to task notification at the same time.
+ *
+ * Message buffers, see message_buffer.h, are built on stream buffers.
+ */
+
+#ifndef STREAM_BUFFER_H
+#define STREAM_BUFFER_H
+
+#ifndef INC_FREERTOS_H
+#error "include FreeRTOS.h must appear in source files before include stream_buffer.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * stream_buffer.h
+ *
+ * Type by which stream buffers are referenced.  For example, a call to
+ * xStreamBufferCreate() returns a StreamBufferHandle_t that can then be used
+ * as a parameter to xStreamBufferSend(), xStreamBufferReceive(), etc.
+ */
+typedef void *StreamBufferHandle_t;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ StreamBufferHandle_t xStreamBufferCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+ * </pre>
+ *
+ * Creates a stream buffer that holds up to xBufferSizeBytes bytes.
+ *
+ * @param xBufferSizeBytes The number of bytes the stream buffer can hold.
+ *
+ * @param xTriggerLevelBytes The number of bytes that must be in the stream
+ * buffer before a task blocked waiting for data is woken, 1 to wake it on any
+ * data.  The task also wakes when its block time expires, receiving what is
+ * there.
+ *
+ * @return A handle to the stream buffer, or NULL if it could not be allocated.
+ *
+ * \defgroup xStreamBufferCreate xStreamBufferCreate
+ * \ingroup StreamBufferManagement
+ */
+#define xStreamBufferCreate( xBufferSizeBytes, xTriggerLevelBytes ) xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE )
+
+/**
+ * stream_buffer.h
+ * <pre>
+ StreamBufferHandle_t xStreamBufferCreateStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, uint8_t *pucStreamBufferStorageArea, StaticStreamBuffer_t *pxStaticStreamBuffer );
+ * </pre>
+ *
+ * Creates a stream buffer like xStreamBufferCreate(), in memory provided by the
+ * caller.  vStreamBufferDelete() does not free the memory.
+ *
+ * @param pucStreamBufferStorageArea At least xBufferSizeBytes + 1 bytes, which
+ * hold the data.
+ *
+ * @param pxStaticStreamBuffer Holds the stream buffer's structure.
+ *
+ * @return A handle to the stream buffer, or NULL if either buffer is NULL.
+ *
+ * \defgroup xStreamBufferCreateStatic xStreamBufferCreateStatic
+ * \ingroup StreamBufferManagement
+ */
+#define xStreamBufferCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ) )
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Copies bytes into a stream buffer.  If there is not enough space for all
+ * of them the calling task blocks for up to xTicksToWait for enough space to
+ * become available, and then writes as many bytes as fit.
+ *
+ * @param xStreamBuffer The stream buffer to write to.
+ *
+ * @param pvTxData The bytes to copy into the stream buffer.
+ *
+ * @param xDataLengthBytes The number of bytes at pvTxData.
+ *
+ * @param xTicksToWait The maximum amount of time to wait for space.
+ *
+ * @return The number of bytes written.
+ *
+ * Example usage:
+   <pre>
+ void vSampler( StreamBufferHandle_t xStreamBuffer )
+ {
+ uint8_t ucSamples[ 64 ];
+ size_t xSent;
+
+    vReadSamples( ucSamples, sizeof( ucSamples ) );
+
+    // Wait up to 10 ticks for room for all the samples.
+    xSent = xStreamBufferSend( xStreamBuffer, ucSamples, sizeof( ucSamples ), 10 );
+    if( xSent != sizeof( ucSamples ) )
+    {
+        // Only xSent bytes fit before the block time expired.
+    }
+ }
+ </pre>
+ * \defgroup xStreamBufferSend xStreamBufferSend
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSend(StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, TickType_t xTicksToWait) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * A version of xStreamBufferSend() that can be called from an interrupt
+ * service routine.  Writes as many bytes as fit without blocking.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the write woke a task of
+ * a higher priority than the interrupted one, in which case a context switch
+ * should be requested before the interrupt is exited.
+ *
+ * @return The number of bytes written.
+ *
+ * \defgroup xStreamBufferSendFromISR xStreamBufferSendFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendFromISR(StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes, BaseType_t *const pxHigherPriorityTaskWoken) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferSendFromHost( StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes );
+ * </pre>
+ *
+ * A version of xStreamBufferSend() for host threads that are not tasks, such
+ * as the threads that run AsyncIO callbacks.  Writes as many bytes as fit
+ * without entering the kernel and, if that wakes the reader, raises the
+ * simulated interrupt configSTREAM_BUFFER_INTERRUPT to wake it.
+ *
+ * @return The number of bytes written.
+ *
+ * \defgroup xStreamBufferSendFromHost xStreamBufferSendFromHost
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendFromHost(StreamBufferHandle_t xStreamBuffer, const void *pvTxData, size_t xDataLengthBytes) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Copies up to xBufferLengthBytes bytes out of a stream buffer.  If the
+ * stream buffer is empty the calling task blocks for up to xTicksToWait until
+ * the trigger level is reached, or the block time expires, and then receives
+ * what is there.
+ *
+ * @param xStreamBuffer The stream buffer to read from.
+ *
+ * @param pvRxData The buffer the bytes are copied to.
+ *
+ * @param xBufferLengthBytes The size of pvRxData in bytes.
+ *
+ * @param xTicksToWait The maximum amount of time to wait for data.
+ *
+ * @return The number of bytes received.
+ *
+ * \defgroup xStreamBufferReceive xStreamBufferReceive
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceive(StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, TickType_t xTicksToWait) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, BaseType_t *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * A version of xStreamBufferReceive() that can be called from an interrupt
+ * service routine.  Receives what is there without blocking.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if making space woke a task
+ * of a higher priority than the interrupted one.
+ *
+ * @return The number of bytes received.
+ *
+ * \defgroup xStreamBufferReceiveFromISR xStreamBufferReceiveFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferReceiveFromISR(StreamBufferHandle_t xStreamBuffer, void *pvRxData, size_t xBufferLengthBytes, BaseType_t *const pxHigherPriorityTaskWoken) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer );
+ * </pre>
+ *
+ * Deletes a stream buffer that no task is blocked on.
+ *
+ * \defgroup vStreamBufferDelete vStreamBufferDelete
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferDelete(StreamBufferHandle_t xStreamBuffer) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer );
+ * </pre>
+ *
+ * @return pdTRUE if the stream buffer has no space left, otherwise pdFALSE.
+ *
+ * \defgroup xStreamBufferIsFull xStreamBufferIsFull
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferIsFull(StreamBufferHandle_t xStreamBuffer) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer );
+ * </pre>
+ *
+ * @return pdTRUE if the stream buffer holds no data, otherwise pdFALSE.
+ *
+ * \defgroup xStreamBufferIsEmpty xStreamBufferIsEmpty
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferIsEmpty(StreamBufferHandle_t xStreamBuffer) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer );
+ * </pre>
+ *
+ * Empties a stream buffer.  Only possible while no task is blocked on it.
+ *
+ * @return pdPASS if the stream buffer was reset, otherwise pdFAIL.
+ *
+ * \defgroup xStreamBufferReset xStreamBufferReset
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferReset(StreamBufferHandle_t xStreamBuffer) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer );
+ * </pre>
+ *
+ * @return The number of bytes that can be written before the stream buffer
+ * is full.
+ *
+ * \defgroup xStreamBufferSpacesAvailable xStreamBufferSpacesAvailable
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSpacesAvailable(StreamBufferHandle_t xStreamBuffer) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer );
+ * </pre>
+ *
+ * @return The number of bytes that can be read from the stream buffer.
+ *
+ * \defgroup xStreamBufferBytesAvailable xStreamBufferBytesAvailable
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferBytesAvailable(StreamBufferHandle_t xStreamBuffer) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ * <pre>
+ BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel );
+ * </pre>
+ *
+ * Changes the trigger level of a stream buffer, see xStreamBufferCreate().
+ *
+ * @return pdPASS if the trigger level is not larger than the stream buffer,
+ * otherwise pdFAIL.
+ *
+ * \defgroup xStreamBufferSetTriggerLevel xStreamBufferSetTriggerLevel
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferSetTriggerLevel(StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel) PRIVILEGED_FUNCTION;
+
+/* Functions below here are not part of the public API. */
+StreamBufferHandle_t xStreamBufferGenericCreate(size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer) PRIVILEGED_FUNCTION;
+StreamBufferHandle_t xStreamBufferGenericCreateStatic(size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer, uint8_t *const pucStreamBufferStorageArea, StaticStreamBuffer_t *const pxStaticStreamBuffer) PRIVILEGED_FUNCTION;
+size_t xStreamBufferNextMessageLengthBytes(StreamBufferHandle_t xStreamBuffer) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STREAM_BUFFER_H */
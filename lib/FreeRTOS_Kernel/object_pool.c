@@ -0,0 +1,233 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "object_pool.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+
+/* The pools are not built on the block pools of block_pool.c, which keep their
+free blocks in a queue, as queues are allocated from a pool themselves. */
+typedef struct ObjectPoolDefinition {
+    uint8_t *const pucBlocks;       /*< Points to the first block. */
+    const size_t xBlockSize;        /*< The size of each block. */
+    const UBaseType_t uxBlocks;     /*< The number of blocks in the pool. */
+    void *pvFreeBlocks;             /*< Freed blocks, each holding a pointer to the next. */
+    UBaseType_t uxNextUnusedBlock;  /*< The blocks from this one on were never allocated. */
+    UBaseType_t uxBlocksInUse;
+    UBaseType_t uxMaxBlocksInUse;
+    UBaseType_t uxHeapAllocations;
+} ObjectPool_t;
+
+#if (configTASK_POOL_SIZE > 0)
+static StaticTask_t xTaskPoolBlocks[configTASK_POOL_SIZE];
+static StackType_t xStackPoolBlocks[configTASK_POOL_SIZE]
+[configTASK_POOL_STACK_DEPTH];
+#define poolTASK_BLOCKS ((uint8_t *)xTaskPoolBlocks)
+#define poolSTACK_BLOCKS ((uint8_t *)xStackPoolBlocks)
+#else
+#define poolTASK_BLOCKS NULL
+#define poolSTACK_BLOCKS NULL
+#endif
+
+/* A queue block holds the queue structure followed by its items, aligned as
+the queue structure. */
+typedef union {
+    StaticQueue_t xQueue;
+    uint8_t ucBlock[sizeof(StaticQueue_t) + configQUEUE_POOL_STORAGE_SIZE];
+} PoolQueueBlock_t;
+
+#if (configQUEUE_POOL_SIZE > 0)
+static PoolQueueBlock_t xQueuePoolBlocks[configQUEUE_POOL_SIZE];
+#define poolQUEUE_BLOCKS ((uint8_t *)xQueuePoolBlocks)
+#else
+#define poolQUEUE_BLOCKS NULL
+#endif
+
+#if ((configUSE_TIMERS == 1) && (configTIMER_POOL_SIZE > 0))
+static StaticTimer_t xTimerPoolBlocks[configTIMER_POOL_SIZE];
+#define poolTIMER_BLOCKS ((uint8_t *)xTimerPoolBlocks)
+#define poolTIMER_POOL_SIZE configTIMER_POOL_SIZE
+#else
+#define poolTIMER_BLOCKS NULL
+#define poolTIMER_POOL_SIZE 0
+#endif
+
+/* Indexed by eObjectPool. */
+static ObjectPool_t xObjectPools[eNumberOfObjectPools] = {
+    { poolTASK_BLOCKS, sizeof(StaticTask_t), configTASK_POOL_SIZE },
+    {
+        poolSTACK_BLOCKS, configTASK_POOL_STACK_DEPTH * sizeof(StackType_t),
+        configTASK_POOL_SIZE
+    },
+    { poolQUEUE_BLOCKS, sizeof(PoolQueueBlock_t), configQUEUE_POOL_SIZE },
+    { poolTIMER_BLOCKS, sizeof(StaticTimer_t), poolTIMER_POOL_SIZE },
+};
+
+/*-----------------------------------------------------------*/
+
+void *pvObjectPoolAllocate(eObjectPool ePool, size_t xSize)
+{
+    ObjectPool_t *const pxPool = &xObjectPools[ePool];
+    void *pvReturn = NULL;
+
+    if (pxPool->uxBlocks > (UBaseType_t)0) {
+        taskENTER_CRITICAL();
+        {
+            if (xSize > pxPool->xBlockSize) {
+                mtCOVERAGE_TEST_MARKER();
+            }
+            else if (pxPool->pvFreeBlocks != NULL) {
+                pvReturn = pxPool->pvFreeBlocks;
+                pxPool->pvFreeBlocks = *((void **)pvReturn);
+            }
+            else if (pxPool->uxNextUnusedBlock < pxPool->uxBlocks) {
+                /* Blocks are only linked once freed, so the pool needs no
+                initialisation. */
+                pvReturn = pxPool->pucBlocks +
+                           (pxPool->xBlockSize * (size_t)pxPool->uxNextUnusedBlock);
+                pxPool->uxNextUnusedBlock++;
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if (pvReturn != NULL) {
+                pxPool->uxBlocksInUse++;
+                if (pxPool->uxBlocksInUse > pxPool->uxMaxBlocksInUse) {
+                    pxPool->uxMaxBlocksInUse = pxPool->uxBlocksInUse;
+                }
+            }
+            else {
+                pxPool->uxHeapAllocations++;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    if (pvReturn == NULL) {
+        pvReturn = pvPortMalloc(xSize);
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vObjectPoolFree(eObjectPool ePool, void *pv)
+{
+    ObjectPool_t *const pxPool = &xObjectPools[ePool];
+
+    if ((pxPool->uxBlocks > (UBaseType_t)0) &&
+        ((uint8_t *)pv >= pxPool->pucBlocks) &&
+        ((uint8_t *)pv < pxPool->pucBlocks +
+         (pxPool->xBlockSize * (size_t)pxPool->uxBlocks))) {
+        taskENTER_CRITICAL();
+        {
+            *((void **)pv) = pxPool->pvFreeBlocks;
+            pxPool->pvFreeBlocks = pv;
+            pxPool->uxBlocksInUse--;
+        }
+        taskEXIT_CRITICAL();
+    }
+    else {
+        vPortFree(pv);
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vObjectPoolGetStatus(eObjectPool ePool, ObjectPoolStatus_t *pxStatus)
+{
+    ObjectPool_t *const pxPool = &xObjectPools[ePool];
+
+    taskENTER_CRITICAL();
+    {
+        pxStatus->xBlockSize = pxPool->xBlockSize;
+        pxStatus->uxBlocks = pxPool->uxBlocks;
+        pxStatus->uxBlocksInUse = pxPool->uxBlocksInUse;
+        pxStatus->uxMaxBlocksInUse = pxPool->uxMaxBlocksInUse;
+        pxStatus->uxHeapAllocations = pxPool->uxHeapAllocations;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
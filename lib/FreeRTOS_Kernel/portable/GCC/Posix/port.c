@@ -54,73 +54,224 @@
  * Implementation of functions defined in portable.h for the Posix port.
  *----------------------------------------------------------*/
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include <pthread.h>
 #include <sched.h>
+#include <setjmp.h>
 #include <signal.h>
 #include <errno.h>
 #include <sys/time.h>
 #include <time.h>
-#include <sys/times.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include <limits.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "task.h"
 /*-----------------------------------------------------------*/
 
-#define MAX_NUMBER_OF_TASKS (_POSIX_THREAD_THREADS_MAX)
-/*-----------------------------------------------------------*/
+/* Thread states in the static first block, see configMAX_STATIC_TASKS. */
+#define STATIC_THREAD_STATES (configTHREAD_POOL_SIZE + configMAX_STATIC_TASKS)
+/* Thread states are allocated this many at a time once the static ones are
+ * used up. */
+#define THREAD_STATE_BLOCK_SIZE (64)
+
+/* Pages whose residency is looked up at once while scanning a stack. */
+#define STACK_SCAN_PAGES (64)
+/* Bytes below its own frame that a thread leaves alone when zeroing its
+ * stack, for the frames of the functions doing so. */
+#define STACK_PAINT_MARGIN (1024)
+/* Polls of its futex word between two readings of the clock while a parked
+ * thread spins. */
+#define FUTEX_SPIN_POLLS (64)
+
+#if defined(__x86_64__) || defined(__i386__)
+#define prvSpinWaitHint() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define prvSpinWaitHint() __asm__ volatile("yield")
+#else
+#define prvSpinWaitHint()
+#endif
 
-/* Parameters to pass to the newly created pthread. */
-typedef struct XPARAMS {
-    pdTASK_CODE pxCode;
-    void *pvParams;
-} xParams;
+#if defined(configNUMBER_OF_CORES) && (configNUMBER_OF_CORES > 1)
+#error Multiple cores are only simulated by the single thread port
+#endif
 
-/* Each task maintains its own interrupt status in the critical nesting variable. */
+#if (configUSE_VIRTUAL_TIME == 1)
+#if (configUSE_TICK_THREAD == 0) || (configUSE_TICKLESS_IDLE == 0)
+#error configUSE_VIRTUAL_TIME requires configUSE_TICK_THREAD and configUSE_TICKLESS_IDLE
+#endif
+/* Ticks are raised after each budget of real time while tasks are runnable,
+ * and skipped entirely while all tasks are blocked. */
+#define TICK_PERIOD_NS ((long long)configVIRTUAL_TICK_BUDGET_US * 1000LL)
+#else
+#define TICK_PERIOD_NS (1000000000LL / configTICK_RATE_HZ)
+#endif
+/*-----------------------------------------------------------*/
+
+/* Each task maintains its own interrupt status in the critical nesting variable.
+ * When switching with futexes each thread additionally parks on its own futex
+ * word, which is set to THREAD_RUN by whoever wants the thread to run again, or
+ * to THREAD_END_TASK when the task has been deleted and the thread should jump
+ * back to xTaskExit to either wait in the pool or exit. */
 typedef struct THREAD_SUSPENSIONS {
     pthread_t hThread;
     xTaskHandle hTask;
+    pdTASK_CODE pxCode;
+    void *pvParams;
     unsigned portBASE_TYPE uxCriticalNesting;
+    volatile int iWakeFutex;
+    size_t xStackSize;
+    /* The host stack runs from the limit up to the base, where the thread
+     * started, and stands in for a task stack of uxStackDepth words. */
+    unsigned char *pucStackLimit;
+    unsigned char *pucStackBase;
+    unsigned portBASE_TYPE uxStackDepth;
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+    sigjmp_buf xTaskExit;
+#endif
+    struct THREAD_SUSPENSIONS *pxNextFree;
 } xThreadState;
+
+/* Values of a thread's futex word. A parked thread first spins on
+ * THREAD_PARKED, on a host with more than one CPU, and then sleeps in the
+ * kernel on THREAD_SLEEPING, only then does waking it take a system call. */
+#define THREAD_PARKED (0)
+#define THREAD_RUN (1)
+#define THREAD_END_TASK (2)
+#define THREAD_SLEEPING (3)
+
+/* Blocks are chained together and never moved, so a task's pointer to its
+ * thread state stays valid while the table grows. */
+typedef struct THREAD_STATE_BLOCK {
+    struct THREAD_STATE_BLOCK *pxNext;
+    portLONG lThreads;
+    xThreadState *pxThreads;
+} xThreadStateBlock;
+
+/* The port's context of a task is its thread state. pxPortInitialiseStack()
+ * returns it so that the kernel stores it in pxTopOfStack, the first member
+ * of the TCB, which makes the lookup from a task handle constant time. */
+#define prvGetThreadState(hTask)                                               \
+    (((hTask) == NULL) ? (xThreadState *)NULL : *(xThreadState **)(hTask))
 /*-----------------------------------------------------------*/
 
-static xThreadState *pxThreads;
+/* The first block is static, so that a build without
+ * configSUPPORT_DYNAMIC_ALLOCATION runs up to configMAX_STATIC_TASKS tasks at
+ * a time next to the pooled threads without pvPortMalloc(). */
+static xThreadState xStaticThreads[STATIC_THREAD_STATES];
+static xThreadStateBlock xFirstThreadBlock = {
+    NULL, STATIC_THREAD_STATES, xStaticThreads
+};
+static xThreadStateBlock *pxThreadBlocks = NULL;
+static xThreadState *pxFreeThreads = NULL;
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+/* Threads whose task was deleted, parked until they are given a new task. */
+static xThreadState *pxPooledThreads = NULL;
+static unsigned portBASE_TYPE uxPooledThreads = 0;
+/* Set if the process may run on more than one CPU, where a thread that was
+ * just switched out is often switched back in before it would have slept. */
+static portBASE_TYPE xSpinWhenParked = pdFALSE;
+#endif
+static pthread_mutex_t xThreadTableMutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_once_t hSigSetupThread = PTHREAD_ONCE_INIT;
-static pthread_attr_t xThreadAttributes;
 static pthread_mutex_t xSuspendResumeThreadMutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t xSingleThreadMutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_t hMainThread = (pthread_t)NULL;
 /*-----------------------------------------------------------*/
 
-static volatile portBASE_TYPE xSentinel = 0;
+/* Futex word set once a new or suspending thread has released the CPU. */
+static volatile int iSentinel = 0;
 static volatile portBASE_TYPE xSchedulerEnd = pdFALSE;
 static volatile portBASE_TYPE xInterruptsEnabled = pdTRUE;
 static volatile portBASE_TYPE xServicingTick = pdFALSE;
 static volatile portBASE_TYPE xPendYield = pdFALSE;
-static volatile portLONG lIndexOfLastAddedTask = 0;
 static volatile unsigned portBASE_TYPE uxCriticalNesting;
+/* Ticks raised but not yet passed to the kernel, for instance because
+ * interrupts were disabled when they occurred. */
+static volatile unsigned portBASE_TYPE uxTicksToService = 0;
+/* Simulated interrupts raised but not yet serviced, one bit each, and the
+ * handlers the running thread runs for them. */
+static volatile uint32_t ulPendingInterrupts = 0;
+static uint32_t (*volatile pvInterruptHandlers[portMAX_INTERRUPTS])(void);
+static struct timespec xRunTimeStart;
+/*-----------------------------------------------------------*/
+
+#if (configUSE_TICK_THREAD == 1)
+static pthread_t hTickThread = (pthread_t)NULL;
+static xPortTickStats xTickStats;
+static volatile unsigned long ulTicksRaised = 0;
+/* Bumped to wake the tick thread early, see prvWakeTickThread(). */
+static volatile int iTickThreadFutex = 0;
+#if (configUSE_TICKLESS_IDLE == 1)
+/* Set by the idle task to the number of ticks the tick thread should sleep
+ * for, the tick thread reports the ticks that passed and sets the futex. */
+static volatile TickType_t xTicklessIdleTicks = 0;
+static volatile unsigned long ulTicklessRequestTick = 0;
+static volatile TickType_t xTicklessTicksSlept = 0;
+static volatile int iTicklessFutex = 0;
+#endif
+#endif
 /*-----------------------------------------------------------*/
 
 /*
  * Setup the timer to generate the tick interrupts.
  */
 static void prvSetupTimerInterrupt(void);
+static void prvSetSentinel(void);
+static void prvWaitForSentinel(void);
 static void *prvWaitForStart(void *pvParams);
+static void prvSetupSignalsAndSchedulerPolicy(void);
+static portBASE_TYPE prvRunInterruptHandlers(void);
+static void prvResumeThread(xThreadState *pxThreadState);
+static xThreadState *prvGetFreeThreadState(void);
+static void prvReleaseThreadState(xThreadState *pxThreadState);
+static size_t prvGetHostStackSize(size_t xStackDepth);
+#if (INCLUDE_uxTaskGetStackHighWaterMark == 1)
+static unsigned char *prvScanStack(unsigned char *pucLow,
+                                   unsigned char *pucHigh,
+                                   portBASE_TYPE xClear);
+static void prvPaintStack(xThreadState *pxThreadState)
+__attribute__((noinline));
+#endif
+static int prvSpawnThread(xThreadState *pxThreadState);
+static portBASE_TYPE prvCreateThread(xThreadState *pxThreadState);
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+static xThreadState *prvGetPooledThread(size_t xStackSize);
+static portBASE_TYPE prvPoolThread(xThreadState *pxThreadState);
+#endif
+static void prvDeleteThread(void *pxThreadState);
+static void prvCancelThread(xThreadState *pxThreadState);
+static void prvSwitchThread(xThreadState *pxThreadToSuspend,
+                            xThreadState *pxThreadToResume);
+#if (configUSE_TICK_THREAD == 1)
+static void *prvTickThread(void *pvParams);
+static portBASE_TYPE prvTickThreadSleep(const struct timespec *pxDeadline,
+                                        portBASE_TYPE xWakeForIdle);
+static void prvRecordTick(long long llLatenessNs, unsigned long ulMissed);
+#if (configUSE_TICKLESS_IDLE == 1)
+static void prvWakeTickThread(void);
+static void prvTicklessSleep(struct timespec *pxDeadline, long long llPeriodNs);
+#endif
+#endif
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+static void prvSpinWhileParked(xThreadState *pxThreadState);
+static void prvParkThread(xThreadState *pxThreadState);
+static void prvUnparkThread(xThreadState *pxThreadState);
+#else
 static void prvSuspendSignalHandler(int sig);
 static void prvResumeSignalHandler(int sig);
-static void prvSetupSignalsAndSchedulerPolicy(void);
-static void prvSuspendThread(pthread_t xThreadId);
-static void prvResumeThread(pthread_t xThreadId);
-static pthread_t prvGetThreadHandle(xTaskHandle hTask);
-static portLONG prvGetFreeThreadState(void);
-static void prvSetTaskCriticalNesting(pthread_t xThreadId,
-                                      unsigned portBASE_TYPE uxNesting);
-static unsigned portBASE_TYPE prvGetTaskCriticalNesting(pthread_t xThreadId);
-static void prvDeleteThread(void *xThreadId);
+static void prvSuspendThread(xThreadState *pxThreadState);
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -139,10 +290,12 @@ void vPortStartFirstTask(void);
  * See header file for description.
  */
 portSTACK_TYPE *pxPortInitialiseStack(portSTACK_TYPE *pxTopOfStack,
+                                      portSTACK_TYPE *pxEndOfStack,
                                       pdTASK_CODE pxCode, void *pvParameters)
 {
-    /* Should actually keep this struct on the stack. */
-    xParams *pxThisThreadParams = pvPortMalloc(sizeof(xParams));
+    xThreadState *pxThreadState;
+    size_t xStackDepth = (size_t)(pxTopOfStack - pxEndOfStack) + 1;
+    size_t xStackSize = prvGetHostStackSize(xStackDepth);
 
     (void)pthread_once(&hSigSetupThread, prvSetupSignalsAndSchedulerPolicy);
 
@@ -150,38 +303,199 @@ portSTACK_TYPE *pxPortInitialiseStack(portSTACK_TYPE *pxTopOfStack,
         hMainThread = pthread_self();
     }
 
-    /* No need to join the threads. */
-    pthread_attr_init(&xThreadAttributes);
-    pthread_attr_setdetachstate(&xThreadAttributes,
-                                PTHREAD_CREATE_DETACHED);
+    vPortEnterCritical();
 
-    /* Add the task parameters. */
-    pxThisThreadParams->pxCode = pxCode;
-    pxThisThreadParams->pvParams = pvParameters;
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+    /* A pooled thread is already parked and only needs its new task. */
+    pxThreadState = prvGetPooledThread(xStackSize);
+    if (NULL != pxThreadState) {
+        pxThreadState->pxCode = pxCode;
+        pxThreadState->pvParams = pvParameters;
+        pxThreadState->uxCriticalNesting = 0;
+        pxThreadState->uxStackDepth = xStackDepth;
+        vPortExitCritical();
+        return (portSTACK_TYPE *)pxThreadState;
+    }
+#endif
 
-    vPortEnterCritical();
+    pxThreadState = prvGetFreeThreadState();
+    if (NULL == pxThreadState) {
+        vPortExitCritical();
+        return 0;
+    }
+    pxThreadState->pxCode = pxCode;
+    pxThreadState->pvParams = pvParameters;
+    pxThreadState->uxCriticalNesting = 0;
+    pxThreadState->iWakeFutex = THREAD_PARKED;
+    pxThreadState->xStackSize = xStackSize;
+    pxThreadState->uxStackDepth = xStackDepth;
+
+    /* The thread state becomes the task's context, see prvGetThreadState(). */
+    pxTopOfStack = (portSTACK_TYPE *)pxThreadState;
+
+    if (pdFALSE == prvCreateThread(pxThreadState)) {
+        pxThreadState->hThread = (pthread_t)NULL;
+        prvReleaseThreadState(pxThreadState);
+        pxTopOfStack = 0;
+    }
+    vPortExitCritical();
+
+    return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
 
-    lIndexOfLastAddedTask = prvGetFreeThreadState();
+/*
+ * Returns the size of the host stack for a task stack of xStackDepth words.
+ */
+size_t prvGetHostStackSize(size_t xStackDepth)
+{
+    size_t xPageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t xStackSize =
+        xStackDepth * sizeof(portSTACK_TYPE) * configHOST_STACK_SCALE;
+
+    if (xStackSize < configMINIMAL_HOST_STACK_SIZE) {
+        xStackSize = configMINIMAL_HOST_STACK_SIZE;
+    }
+    if (xStackSize < (size_t)PTHREAD_STACK_MIN) {
+        xStackSize = (size_t)PTHREAD_STACK_MIN;
+    }
+
+    return (xStackSize + xPageSize - 1) & ~(xPageSize - 1);
+}
+/*-----------------------------------------------------------*/
+
+#if (INCLUDE_uxTaskGetStackHighWaterMark == 1)
+/*
+ * Returns the lowest byte in [pucLow, pucHigh) that is not zero, or pucHigh,
+ * or zeroes the range if xClear is set. Pages that have never been touched
+ * are not resident and read as zero, so they are skipped without reading
+ * them, which would commit them.
+ */
+unsigned char *prvScanStack(unsigned char *pucLow, unsigned char *pucHigh,
+                            portBASE_TYPE xClear)
+{
+    size_t xPageSize = (size_t)sysconf(_SC_PAGESIZE);
+    unsigned char ucResident[STACK_SCAN_PAGES];
+    unsigned char *pucPage, *pucByte, *pucEnd;
+    size_t xPages, x;
+
+    pucPage = (unsigned char *)((uintptr_t)pucLow & ~(uintptr_t)(xPageSize - 1));
+    while (pucPage < pucHigh) {
+        xPages = ((size_t)(pucHigh - pucPage) + xPageSize - 1) / xPageSize;
+        if (xPages > STACK_SCAN_PAGES) {
+            xPages = STACK_SCAN_PAGES;
+        }
+        if (0 != mincore(pucPage, xPages * xPageSize, ucResident)) {
+            memset(ucResident, 1, xPages);
+        }
+
+        for (x = 0; x < xPages; x++, pucPage += xPageSize) {
+            if (0 == (ucResident[x] & 1)) {
+                continue;
+            }
+            pucByte = (pucPage < pucLow) ? pucLow : pucPage;
+            pucEnd = (pucPage + xPageSize < pucHigh) ? pucPage + xPageSize
+                     : pucHigh;
+            if (pdTRUE == xClear) {
+                memset(pucByte, 0, (size_t)(pucEnd - pucByte));
+                continue;
+            }
+            for (; pucByte < pucEnd; pucByte++) {
+                if (0 != *pucByte) {
+                    return pucByte;
+                }
+            }
+        }
+    }
+
+    return pucHigh;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Zeroes the calling thread's stack below its own frame before the thread
+ * runs a task. The stack may be reused from an earlier thread or task.
+ */
+void prvPaintStack(xThreadState *pxThreadState)
+{
+    unsigned char *pucFrame = __builtin_frame_address(0);
+
+    if (NULL != pxThreadState->pucStackLimit) {
+        (void)prvScanStack(pxThreadState->pucStackLimit,
+                           pucFrame - STACK_PAINT_MARGIN, pdTRUE);
+    }
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxPortGetStackHighWaterMark(portSTACK_TYPE *pxTopOfStack)
+{
+    xThreadState *pxThreadState = (xThreadState *)pxTopOfStack;
+    size_t xUsed;
+
+    if ((NULL == pxThreadState) || (NULL == pxThreadState->pucStackLimit)) {
+        return 0;
+    }
+
+    xUsed = (size_t)(pxThreadState->pucStackBase -
+                     prvScanStack(pxThreadState->pucStackLimit,
+                                  pxThreadState->pucStackBase, pdFALSE));
+    xUsed = (xUsed + sizeof(portSTACK_TYPE) * configHOST_STACK_SCALE - 1) /
+            (sizeof(portSTACK_TYPE) * configHOST_STACK_SCALE);
+
+    return (xUsed < pxThreadState->uxStackDepth) ?
+           pxThreadState->uxStackDepth - xUsed : 0;
+}
+/*-----------------------------------------------------------*/
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+
+/*
+ * Starts a detached thread with a stack of the thread state's size. The
+ * stack is mapped and unmapped by the threads library, which keeps a guard
+ * page below it.
+ */
+int prvSpawnThread(xThreadState *pxThreadState)
+{
+    pthread_attr_t xAttributes;
+    int iResult;
+
+    /* No need to join the threads. */
+    pthread_attr_init(&xAttributes);
+    pthread_attr_setdetachstate(&xAttributes, PTHREAD_CREATE_DETACHED);
+    pthread_attr_setguardsize(&xAttributes, (size_t)sysconf(_SC_PAGESIZE));
+
+    iResult = pthread_attr_setstacksize(&xAttributes,
+                                        pxThreadState->xStackSize);
+    if (0 == iResult) {
+        iResult = pthread_create(&(pxThreadState->hThread), &xAttributes,
+                                 prvWaitForStart, (void *)pxThreadState);
+    }
+
+    pthread_attr_destroy(&xAttributes);
+    return iResult;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Starts the thread of a thread state and waits until it has parked.
+ */
+portBASE_TYPE prvCreateThread(xThreadState *pxThreadState)
+{
+    portBASE_TYPE xReturn = pdTRUE;
 
-    /* Create the new pThread. */
     if (0 == pthread_mutex_lock(&xSingleThreadMutex)) {
-        xSentinel = 0;
-        if (0 !=
-            pthread_create(&(pxThreads[lIndexOfLastAddedTask].hThread),
-                           &xThreadAttributes, prvWaitForStart,
-                           (void *)pxThisThreadParams)) {
+        iSentinel = 0;
+        if (0 != prvSpawnThread(pxThreadState)) {
             /* Thread create failed, signal the failure */
-            pxTopOfStack = 0;
+            xReturn = pdFALSE;
+            iSentinel = 1;
         }
 
         /* Wait until the task suspends. */
         (void)pthread_mutex_unlock(&xSingleThreadMutex);
-        while (xSentinel == 0)
-            ;
-        vPortExitCritical();
+        prvWaitForSentinel();
     }
 
-    return pxTopOfStack;
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
@@ -194,7 +508,7 @@ void vPortStartFirstTask(void)
     vPortEnableInterrupts();
 
     /* Start the first task. */
-    prvResumeThread(prvGetThreadHandle(xTaskGetCurrentTaskHandle()));
+    prvResumeThread(prvGetThreadState(xTaskGetCurrentTaskHandle()));
 }
 /*-----------------------------------------------------------*/
 
@@ -208,7 +522,7 @@ portBASE_TYPE xPortStartScheduler(void)
     sigset_t xSignals;
     sigset_t xSignalToBlock;
     sigset_t xSignalsBlocked;
-    portLONG lIndex;
+    xThreadStateBlock *pxBlock;
 
     /* Establish the signals to block before they are needed. */
     sigfillset(&xSignalToBlock);
@@ -216,10 +530,6 @@ portBASE_TYPE xPortStartScheduler(void)
     /* Block until the end */
     (void)pthread_sigmask(SIG_SETMASK, &xSignalToBlock, &xSignalsBlocked);
 
-    for (lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++) {
-        pxThreads[lIndex].uxCriticalNesting = 0;
-    }
-
     /* Start the timer that generates the tick ISR.  Interrupts are disabled
     here already. */
     prvSetupTimerInterrupt();
@@ -243,7 +553,15 @@ portBASE_TYPE xPortStartScheduler(void)
     pthread_mutex_destroy(&xSuspendResumeThreadMutex);
     /** xResult = pthread_mutex_destroy( &xSingleThreadMutex ); */
     pthread_mutex_destroy(&xSingleThreadMutex);
-    vPortFree((void *)pxThreads);
+    while (NULL != pxThreadBlocks) {
+        pxBlock = pxThreadBlocks;
+        pxThreadBlocks = pxBlock->pxNext;
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+        if (&xFirstThreadBlock != pxBlock) {
+            vPortFree((void *)pxBlock);
+        }
+#endif
+    }
 
     /* Should not get here! */
     return 0;
@@ -252,14 +570,28 @@ portBASE_TYPE xPortStartScheduler(void)
 
 void vPortEndScheduler(void)
 {
-    portBASE_TYPE xNumberOfThreads;
+    xThreadStateBlock *pxBlock;
+    xThreadState *pxThread;
+    portLONG lIndex;
     /** portBASE_TYPE xResult; */
-    for (xNumberOfThreads = 0; xNumberOfThreads < MAX_NUMBER_OF_TASKS;
-         xNumberOfThreads++) {
-        if ((pthread_t)NULL != pxThreads[xNumberOfThreads].hThread) {
-            /* Kill all of the threads, they are in the detached state. */
-            pthread_cancel(pxThreads[xNumberOfThreads].hThread);
-            /** xResult = pthread_cancel( pxThreads[ xNumberOfThreads ].hThread ); */
+#if (configUSE_TICK_THREAD == 1)
+    if ((pthread_t)NULL != hTickThread) {
+        pthread_cancel(hTickThread);
+    }
+#endif
+    for (pxBlock = pxThreadBlocks; NULL != pxBlock; pxBlock = pxBlock->pxNext) {
+        for (lIndex = 0; lIndex < pxBlock->lThreads; lIndex++) {
+            pxThread = &pxBlock->pxThreads[lIndex];
+            if ((pthread_t)NULL != pxThread->hThread) {
+                /* Kill all of the threads, they are in the detached state. */
+                pthread_cancel(pxThread->hThread);
+                /** xResult = pthread_cancel( pxThread->hThread ); */
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+                if (pthread_self() != pxThread->hThread) {
+                    prvUnparkThread(pxThread);
+                }
+#endif
+            }
         }
     }
 
@@ -276,6 +608,15 @@ void vPortYieldFromISR(void)
      * simply indicate that a yield is required soon.
      */
     xPendYield = pdTRUE;
+
+#if (configUSE_TICK_THREAD == 1) && (configUSE_TICKLESS_IDLE == 1)
+    /* Like an interrupt waking the processor, end a tickless idle period so
+     * the task that was woken gets to run. */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (0 != __atomic_load_n(&xTicklessIdleTicks, __ATOMIC_RELAXED)) {
+        prvWakeTickThread();
+    }
+#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -301,33 +642,108 @@ void vPortExitCritical(void)
             vPortYield();
         }
         vPortEnableInterrupts();
+
+        /* Simulated interrupts raised meanwhile are taken now. */
+        if (0 != __atomic_load_n(&ulPendingInterrupts, __ATOMIC_RELAXED)) {
+            (void)pthread_kill(pthread_self(), SIG_INTERRUPT);
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetInterruptHandler(uint32_t ulInterruptNumber,
+                              uint32_t (*pvHandler)(void))
+{
+    if (ulInterruptNumber < portMAX_INTERRUPTS) {
+        __atomic_store_n(&pvInterruptHandlers[ulInterruptNumber], pvHandler,
+                         __ATOMIC_RELEASE);
     }
 }
 /*-----------------------------------------------------------*/
 
+void vPortGenerateSimulatedInterrupt(uint32_t ulInterruptNumber)
+{
+    xThreadState *pxRunningThread;
+    uint32_t ulBit;
+
+    if (ulInterruptNumber >= portMAX_INTERRUPTS) {
+        return;
+    }
+
+    /* Whoever set the bit has already interrupted the running thread. */
+    ulBit = (uint32_t)1 << ulInterruptNumber;
+    if (0 != (__atomic_fetch_or(&ulPendingInterrupts, ulBit,
+                                __ATOMIC_RELEASE) & ulBit)) {
+        return;
+    }
+
+    /* As for the tick, the interrupt is seen by the thread switched in or the
+     * thread signalled below is that thread. */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+#if (configUSE_TICK_THREAD == 1) && (configUSE_TICKLESS_IDLE == 1)
+    /* The idle task takes the interrupt once the tickless period ends. */
+    if (0 != __atomic_load_n(&xTicklessIdleTicks, __ATOMIC_RELAXED)) {
+        prvWakeTickThread();
+    }
+#endif
+
+    /* Serviced like the tick, by the thread of the running task. A thread
+     * interrupted as it is switched out passes the signal on. */
+    pxRunningThread = prvGetThreadState(xTaskGetCurrentTaskHandle());
+    if ((pdTRUE != xSchedulerEnd) && (NULL != pxRunningThread) &&
+        ((pthread_t)NULL != pxRunningThread->hThread)) {
+        (void)pthread_kill(pxRunningThread->hThread, SIG_INTERRUPT);
+    }
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the handlers of the simulated interrupts pending, called by the
+ * running thread while it services the tick. Returns pdTRUE if a handler
+ * requires a switch.
+ */
+portBASE_TYPE prvRunInterruptHandlers(void)
+{
+    uint32_t ulPending = __atomic_exchange_n(&ulPendingInterrupts, 0,
+                                             __ATOMIC_ACQUIRE);
+    uint32_t (*pvHandler)(void);
+    portBASE_TYPE xSwitchRequired = pdFALSE;
+    int iInterrupt;
+
+    /* Lower numbers first, as with a prioritised interrupt controller. */
+    while (0 != ulPending) {
+        iInterrupt = __builtin_ctz(ulPending);
+        ulPending &= ulPending - 1;
+        pvHandler = __atomic_load_n(&pvInterruptHandlers[iInterrupt],
+                                    __ATOMIC_ACQUIRE);
+        if ((NULL != pvHandler) && (0 != pvHandler())) {
+            xSwitchRequired = pdTRUE;
+        }
+    }
+
+    return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
 void vPortYield(void)
 {
-    pthread_t xTaskToSuspend;
-    pthread_t xTaskToResume = 0;
+    xThreadState *pxTaskToSuspend;
+    xThreadState *pxTaskToResume;
 
     if (0 == pthread_mutex_lock(&xSingleThreadMutex)) {
-        xTaskToSuspend =
-            prvGetThreadHandle(xTaskGetCurrentTaskHandle());
+        pxTaskToSuspend =
+            prvGetThreadState(xTaskGetCurrentTaskHandle());
 
         vTaskSwitchContext();
 
-        TaskHandle_t task_handle = xTaskGetCurrentTaskHandle();
-        xTaskToResume = prvGetThreadHandle(task_handle);
-        /** xTaskToResume = prvGetThreadHandle( xTaskGetCurrentTaskHandle() ); */
-        if (xTaskToSuspend != xTaskToResume && xTaskToResume) {
+        pxTaskToResume = prvGetThreadState(xTaskGetCurrentTaskHandle());
+        if (pxTaskToSuspend != pxTaskToResume && pxTaskToResume) {
             /* Remember and switch the critical nesting. */
-            prvSetTaskCriticalNesting(xTaskToSuspend,
-                                      uxCriticalNesting);
-            uxCriticalNesting =
-                prvGetTaskCriticalNesting(xTaskToResume);
+            pxTaskToSuspend->uxCriticalNesting = uxCriticalNesting;
+            uxCriticalNesting = pxTaskToResume->uxCriticalNesting;
             /* Switch tasks. */
-            prvResumeThread(xTaskToResume);
-            prvSuspendThread(xTaskToSuspend);
+            prvSwitchThread(pxTaskToSuspend, pxTaskToResume);
         }
         else {
             /* Yielding to self */
@@ -369,6 +785,23 @@ void vPortClearInterruptMask(portBASE_TYPE xMask)
  */
 void prvSetupTimerInterrupt(void)
 {
+#if (configUSE_TICK_THREAD == 1)
+    struct sched_param xParam;
+
+    vPortResetTickStats();
+
+    /* The thread inherits the main thread's mask, which blocks all signals. */
+    if (0 != pthread_create(&hTickThread, NULL, prvTickThread, NULL)) {
+        printf("Tick thread problem.\n");
+        return;
+    }
+    (void)pthread_detach(hTickThread);
+
+    /* A real-time policy keeps the tick accurate on a loaded host, it is
+     * only granted to privileged processes so failing is fine. */
+    xParam.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    (void)pthread_setschedparam(hTickThread, SCHED_FIFO, &xParam);
+#else
     struct itimerval itimer, oitimer;
     portTickType xMicroSeconds = portTICK_RATE_MICROSECONDS;
 
@@ -390,41 +823,388 @@ void prvSetupTimerInterrupt(void)
     else {
         printf("Get Timer problem.\n");
     }
+#endif
+}
+/*-----------------------------------------------------------*/
+
+#if (configUSE_TICK_THREAD == 1)
+static void prvTimespecAdd(struct timespec *pxTime, long long llNs)
+{
+    llNs += pxTime->tv_nsec;
+    pxTime->tv_sec += llNs / 1000000000LL;
+    pxTime->tv_nsec = llNs % 1000000000LL;
+}
+/*-----------------------------------------------------------*/
+
+void *prvTickThread(void *pvParams)
+{
+    const long long llPeriodNs = TICK_PERIOD_NS;
+    struct timespec xDeadline, xNow;
+    long long llLatenessNs;
+    unsigned long ulMissed;
+    xThreadState *pxRunningThread;
+
+    (void)pvParams;
+
+    /* Sleeping to absolute deadlines keeps the tick from drifting. */
+    clock_gettime(CLOCK_MONOTONIC, &xDeadline);
+    prvTimespecAdd(&xDeadline, llPeriodNs);
+
+    while (pdTRUE != xSchedulerEnd) {
+        pthread_testcancel();
+
+        if (pdFALSE == prvTickThreadSleep(&xDeadline, pdTRUE)) {
+#if (configUSE_TICKLESS_IDLE == 1)
+            /* The idle task has asked for the tick to be suppressed. */
+            prvTicklessSleep(&xDeadline, llPeriodNs);
+#endif
+            continue;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &xNow);
+
+        llLatenessNs = (xNow.tv_sec - xDeadline.tv_sec) * 1000000000LL +
+                       (xNow.tv_nsec - xDeadline.tv_nsec);
+
+        /* Whole periods that were overslept are raised together with this
+         * tick, the kernel folds them into its pended ticks if the
+         * scheduler is suspended. */
+        ulMissed = 0;
+        if (llLatenessNs >= llPeriodNs) {
+            ulMissed = llLatenessNs / llPeriodNs;
+        }
+        prvTimespecAdd(&xDeadline, (1 + ulMissed) * llPeriodNs);
+        prvRecordTick(llLatenessNs, ulMissed);
+
+        __atomic_add_fetch(&uxTicksToService, 1 + ulMissed, __ATOMIC_RELEASE);
+        __atomic_store_n(&ulTicksRaised, ulTicksRaised + 1 + ulMissed,
+                         __ATOMIC_RELEASE);
+
+        /* Pairs with the fence in prvParkThread(), either the thread switched
+         * in sees the ticks or it is the thread signalled here. */
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        pxRunningThread = prvGetThreadState(xTaskGetCurrentTaskHandle());
+        if ((NULL != pxRunningThread) &&
+            ((pthread_t)NULL != pxRunningThread->hThread)) {
+            (void)pthread_kill(pxRunningThread->hThread, SIG_TICK);
+        }
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns pdTRUE once the deadline has passed. Returns pdFALSE early when the
+ * idle task asks for a tickless period if xWakeForIdle is set, otherwise
+ * whenever the thread is woken by prvWakeTickThread().
+ */
+portBASE_TYPE prvTickThreadSleep(const struct timespec *pxDeadline,
+                                 portBASE_TYPE xWakeForIdle)
+{
+    int iSeen;
+
+    for (;;) {
+        iSeen = __atomic_load_n(&iTickThreadFutex, __ATOMIC_ACQUIRE);
+#if (configUSE_TICKLESS_IDLE == 1)
+        if ((pdTRUE == xWakeForIdle) &&
+            (0 != __atomic_load_n(&xTicklessIdleTicks, __ATOMIC_ACQUIRE))) {
+            return pdFALSE;
+        }
+#endif
+        /* The timeout of FUTEX_WAIT_BITSET is absolute on CLOCK_MONOTONIC. */
+        if (0 == syscall(SYS_futex, &iTickThreadFutex,
+                         FUTEX_WAIT_BITSET_PRIVATE, iSeen, pxDeadline, NULL,
+                         FUTEX_BITSET_MATCH_ANY)) {
+            if (pdTRUE != xWakeForIdle) {
+                return pdFALSE;
+            }
+        }
+        else if (ETIMEDOUT == errno) {
+            return pdTRUE;
+        }
+        else if ((EAGAIN == errno) && (pdTRUE != xWakeForIdle)) {
+            return pdFALSE;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if (configUSE_TICKLESS_IDLE == 1)
+void prvWakeTickThread(void)
+{
+    __atomic_add_fetch(&iTickThreadFutex, 1, __ATOMIC_RELEASE);
+    (void)syscall(SYS_futex, &iTickThreadFutex, FUTEX_WAKE_PRIVATE, 1, NULL,
+                  NULL, 0);
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Sleeps through the idle period requested by the idle task, or until woken
+ * early, and reports the ticks that passed. On return pxDeadline is the
+ * first tick that is still to come.
+ */
+void prvTicklessSleep(struct timespec *pxDeadline, long long llPeriodNs)
+{
+    TickType_t xIdleTicks = __atomic_load_n(&xTicklessIdleTicks,
+                                            __ATOMIC_ACQUIRE);
+    /* Ticks raised after the request was made already count towards it. */
+    unsigned long ulRaised = ulTicksRaised - ulTicklessRequestTick;
+    struct timespec xWake = *pxDeadline, xNow;
+    long long llElapsedNs;
+    TickType_t xSlept = 0;
+
+    if (ulRaised < xIdleTicks) {
+        /* The last tick of the period is raised at the deadline after
+         * pxDeadline, which is itself the first tick of the period. */
+        prvTimespecAdd(&xWake, (long long)(xIdleTicks - 1 - ulRaised) *
+                       llPeriodNs);
+        (void)prvTickThreadSleep(&xWake, pdFALSE);
+
+        clock_gettime(CLOCK_MONOTONIC, &xNow);
+        llElapsedNs = (xNow.tv_sec - pxDeadline->tv_sec) * 1000000000LL +
+                      (xNow.tv_nsec - pxDeadline->tv_nsec);
+        if (llElapsedNs >= 0) {
+            xSlept = llElapsedNs / llPeriodNs + 1;
+            prvTimespecAdd(pxDeadline, (long long)xSlept * llPeriodNs);
+        }
+    }
+
+    __atomic_store_n(&xTickStats.ulTicks, xTickStats.ulTicks + xSlept,
+                     __ATOMIC_RELAXED);
+
+    xTicklessTicksSlept = xSlept;
+    __atomic_store_n(&xTicklessIdleTicks, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&iTicklessFutex, 1, __ATOMIC_RELEASE);
+    (void)syscall(SYS_futex, &iTicklessFutex, FUTEX_WAKE_PRIVATE, 1, NULL,
+                  NULL, 0);
+}
+/*-----------------------------------------------------------*/
+#endif /* configUSE_TICKLESS_IDLE */
+
+void prvRecordTick(long long llLatenessNs, unsigned long ulMissed)
+{
+    unsigned long ulLatenessUs = llLatenessNs / 1000;
+    int iBucket = 0;
+
+    while ((ulLatenessUs > 0) && (iBucket < portTICK_JITTER_BUCKETS - 1)) {
+        ulLatenessUs >>= 1;
+        iBucket++;
+    }
+
+    /* Only written by the tick thread, readers take a relaxed snapshot. */
+    __atomic_store_n(&xTickStats.ulTicks, xTickStats.ulTicks + 1 + ulMissed,
+                     __ATOMIC_RELAXED);
+    __atomic_store_n(&xTickStats.ulMissedTicks,
+                     xTickStats.ulMissedTicks + ulMissed, __ATOMIC_RELAXED);
+    __atomic_store_n(&xTickStats.ulJitterHistogram[iBucket],
+                     xTickStats.ulJitterHistogram[iBucket] + 1,
+                     __ATOMIC_RELAXED);
+    if ((unsigned long)llLatenessNs > xTickStats.ulMaxLatenessNs) {
+        __atomic_store_n(&xTickStats.ulMaxLatenessNs,
+                         (unsigned long)llLatenessNs, __ATOMIC_RELAXED);
+    }
+}
+/*-----------------------------------------------------------*/
+#endif /* configUSE_TICK_THREAD */
+
+#if (configUSE_TICKLESS_IDLE == 1)
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
+{
+#if (configUSE_TICK_THREAD == 1)
+    TickType_t xModifiableIdleTime = xExpectedIdleTime;
+    TickType_t xSlept = 0;
+    TickType_t xStep;
+    unsigned portBASE_TYPE uxTicks;
+    eSleepModeStatus eSleepStatus;
+
+    /* Called by the idle task with the scheduler suspended. Ticks raised
+     * while interrupts are disabled are kept until they are enabled again. */
+    vPortEnterCritical();
+
+    eSleepStatus = eTaskConfirmSleepModeStatus();
+    if (eAbortSleep == eSleepStatus) {
+        vPortExitCritical();
+        return;
+    }
+
+    configPRE_SLEEP_PROCESSING(xModifiableIdleTime);
+
+#if (configUSE_VIRTUAL_TIME == 1)
+    /* Nothing can run before the next task unblocks, so time jumps straight
+     * there. Without a timeout to wait for, sleep until woken from outside. */
+    if (eStandardSleep == eSleepStatus) {
+        xSlept = xModifiableIdleTime;
+        xModifiableIdleTime = 0;
+    }
+#else
+    (void)eSleepStatus;
+#endif
+
+    if (xModifiableIdleTime > 0) {
+        /* Let the tick thread sleep through the idle period in place of
+         * this thread, which waits for it to report back. */
+        __atomic_store_n(&iTicklessFutex, 0, __ATOMIC_RELAXED);
+        ulTicklessRequestTick = __atomic_load_n(&ulTicksRaised,
+                                                __ATOMIC_ACQUIRE);
+        __atomic_store_n(&xTicklessIdleTicks, xModifiableIdleTime,
+                         __ATOMIC_SEQ_CST);
+        prvWakeTickThread();
+
+        /* A task readied from outside the kernel before the request was
+         * visible would not have ended the period, check again. */
+        if (eAbortSleep == eTaskConfirmSleepModeStatus()) {
+            prvWakeTickThread();
+        }
+
+        while (0 == __atomic_load_n(&iTicklessFutex, __ATOMIC_ACQUIRE)) {
+            (void)syscall(SYS_futex, &iTicklessFutex, FUTEX_WAIT_PRIVATE, 0,
+                          NULL, NULL, 0);
+        }
+        xSlept = xTicklessTicksSlept;
+    }
+
+    configPOST_SLEEP_PROCESSING(xExpectedIdleTime);
+
+    /* Ticks raised before the tick thread started sleeping. */
+    uxTicks = __atomic_exchange_n(&uxTicksToService, 0, __ATOMIC_ACQUIRE);
+    while (uxTicks-- > 0) {
+        xTaskIncrementTick();
+    }
+
+    /* The tick count may only be stepped up to the tick before the next
+     * unblock time, any further ticks are pended like any other tick. */
+    xStep = (xSlept < xExpectedIdleTime) ? xSlept : xExpectedIdleTime - 1;
+    vTaskStepTick(xStep);
+    while (xSlept-- > xStep) {
+        xTaskIncrementTick();
+    }
+
+    vPortExitCritical();
+#else
+    /* The interval timer cannot be stopped for a tickless period. */
+    (void)xExpectedIdleTime;
+#endif
+}
+/*-----------------------------------------------------------*/
+#endif /* configUSE_TICKLESS_IDLE */
+
+void vPortGetTickStats(xPortTickStats *pxStats)
+{
+#if (configUSE_TICK_THREAD == 1)
+    int iBucket;
+
+    pxStats->ulTicks = __atomic_load_n(&xTickStats.ulTicks, __ATOMIC_RELAXED);
+    pxStats->ulMissedTicks =
+        __atomic_load_n(&xTickStats.ulMissedTicks, __ATOMIC_RELAXED);
+    pxStats->ulMaxLatenessNs =
+        __atomic_load_n(&xTickStats.ulMaxLatenessNs, __ATOMIC_RELAXED);
+    for (iBucket = 0; iBucket < portTICK_JITTER_BUCKETS; iBucket++) {
+        pxStats->ulJitterHistogram[iBucket] = __atomic_load_n(
+                &xTickStats.ulJitterHistogram[iBucket], __ATOMIC_RELAXED);
+    }
+#else
+    /* The interval timer does not report when its ticks are raised. */
+    memset(pxStats, 0, sizeof(xPortTickStats));
+#endif
+}
+/*-----------------------------------------------------------*/
+
+void vPortResetTickStats(void)
+{
+#if (configUSE_TICK_THREAD == 1)
+    int iBucket;
+
+    __atomic_store_n(&xTickStats.ulTicks, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&xTickStats.ulMissedTicks, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&xTickStats.ulMaxLatenessNs, 0, __ATOMIC_RELAXED);
+    for (iBucket = 0; iBucket < portTICK_JITTER_BUCKETS; iBucket++) {
+        __atomic_store_n(&xTickStats.ulJitterHistogram[iBucket], 0,
+                         __ATOMIC_RELAXED);
+    }
+#endif
 }
 /*-----------------------------------------------------------*/
 
 void vPortSystemTickHandler(int sig)
 {
-    pthread_t xTaskToSuspend;
-    pthread_t xTaskToResume;
+    xThreadState *pxTaskToSuspend;
+    xThreadState *pxTaskToResume;
+    unsigned portBASE_TYPE uxTicks;
+
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+    xThreadState *pxRunningThread =
+        prvGetThreadState(xTaskGetCurrentTaskHandle());
+    int iWake;
+
+    if (NULL != pxRunningThread) {
+        if (pthread_self() != pxRunningThread->hThread) {
+#if (configUSE_TICK_THREAD == 0)
+            /* The interval timer signals any thread, the tick is passed on
+             * to the thread that is actually running and handled there. */
+            (void)pthread_kill(pxRunningThread->hThread, sig);
+#endif
+            /* Otherwise the signal was sent to a thread while it was being
+             * switched out, the thread switched in takes the pending ticks
+             * and interrupts as it leaves prvParkThread(). */
+            return;
+        }
+
+        /* The task has been selected but its thread has not been woken yet. */
+        iWake = __atomic_load_n(&pxRunningThread->iWakeFutex, __ATOMIC_ACQUIRE);
+        if ((THREAD_PARKED == iWake) || (THREAD_SLEEPING == iWake)) {
+            xPendYield = pdTRUE;
+            return;
+        }
+    }
+#endif
+
+#if (configUSE_TICK_THREAD == 0)
+    /* Every interval timer signal is a single tick. */
+    if (SIG_TICK == sig) {
+        __atomic_add_fetch(&uxTicksToService, 1, __ATOMIC_RELEASE);
+    }
+#endif
 
     if ((pdTRUE == xInterruptsEnabled) && (pdTRUE != xServicingTick)) {
         if (0 == pthread_mutex_trylock(&xSingleThreadMutex)) {
             xServicingTick = pdTRUE;
 
-            xTaskToSuspend =
-                prvGetThreadHandle(xTaskGetCurrentTaskHandle());
-            /* Tick Increment. */
-            xTaskIncrementTick();
+            pxTaskToSuspend =
+                prvGetThreadState(xTaskGetCurrentTaskHandle());
+            /* Tick Increment, including any ticks that could not be
+             * serviced while interrupts were disabled. */
+            uxTicks = __atomic_exchange_n(&uxTicksToService, 0,
+                                          __ATOMIC_ACQUIRE);
+            while (uxTicks-- > 0) {
+                xTaskIncrementTick();
+            }
+
+            /* Simulated interrupts, a switch they require is made below or
+             * at the end of the next critical section. */
+            if (pdFALSE != prvRunInterruptHandlers()) {
+                xPendYield = pdTRUE;
+            }
 
             /* Select Next Task. */
 #if (configUSE_PREEMPTION == 1)
+            xPendYield = pdFALSE;
             vTaskSwitchContext();
 #endif
-            xTaskToResume =
-                prvGetThreadHandle(xTaskGetCurrentTaskHandle());
+            pxTaskToResume =
+                prvGetThreadState(xTaskGetCurrentTaskHandle());
 
             /* The only thread that can process this tick is the running thread. */
-            if (xTaskToSuspend != xTaskToResume) {
+            if (pxTaskToSuspend != pxTaskToResume) {
                 /* Remember and switch the critical nesting. */
-                prvSetTaskCriticalNesting(xTaskToSuspend,
-                                          uxCriticalNesting);
-                uxCriticalNesting = prvGetTaskCriticalNesting(
-                                        xTaskToResume);
-                /* Resume next task. */
-                prvResumeThread(xTaskToResume);
-                /* Suspend the current task. */
-                prvSuspendThread(xTaskToSuspend);
+                pxTaskToSuspend->uxCriticalNesting = uxCriticalNesting;
+                uxCriticalNesting = pxTaskToResume->uxCriticalNesting;
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+                /* The handler runs on the thread being switched out, which
+                 * stays parked in here until it is scheduled again. */
+                xServicingTick = pdFALSE;
+#endif
+                /* Resume next task and suspend the current task. */
+                prvSwitchThread(pxTaskToSuspend, pxTaskToResume);
             }
             else {
                 /* Release the lock as we are Resuming. */
@@ -445,67 +1225,150 @@ void vPortSystemTickHandler(int sig)
 void vPortForciblyEndThread(void *pxTaskToDelete)
 {
     xTaskHandle hTaskToDelete = (xTaskHandle)pxTaskToDelete;
-    pthread_t xTaskToDelete;
-    pthread_t xTaskToResume;
-    /** portBASE_TYPE xResult; */
+    xThreadState *pxThreadToDelete;
+    xThreadState *pxTaskToResume;
+
+    /* A task deleted by another task has already been freed by the time this
+     * hook runs, its thread was cancelled from vPortCleanUpTCB(). */
+    if (hTaskToDelete != xTaskGetCurrentTaskHandle()) {
+        return;
+    }
 
     if (0 == pthread_mutex_lock(&xSingleThreadMutex)) {
-        xTaskToDelete = prvGetThreadHandle(hTaskToDelete);
-        xTaskToResume = prvGetThreadHandle(xTaskGetCurrentTaskHandle());
+        pxThreadToDelete = prvGetThreadState(hTaskToDelete);
 
-        if (xTaskToResume == xTaskToDelete) {
-            /* This is a suicidal thread, need to select a different task to run. */
-            vTaskSwitchContext();
-            xTaskToResume =
-                prvGetThreadHandle(xTaskGetCurrentTaskHandle());
-        }
+        /* This is a suicidal thread, need to select a different task to run. */
+        vTaskSwitchContext();
+        pxTaskToResume = prvGetThreadState(xTaskGetCurrentTaskHandle());
 
-        if (pthread_self() != xTaskToDelete) {
+        /* The TCB is freed later by the idle task, which must not cancel
+         * this thread's state slot again. */
+        pxThreadToDelete->hTask = (xTaskHandle)NULL;
+
+        if (pthread_self() != pxThreadToDelete->hThread) {
             /* Cancelling a thread that is not me. */
-            if (xTaskToDelete != (pthread_t)NULL) {
-                /* Send a signal to wake the task so that it definitely cancels. */
-                pthread_testcancel();
-                pthread_cancel(xTaskToDelete);
-                /** xResult = pthread_cancel( xTaskToDelete ); */
-                /* Pthread Clean-up function will note the cancellation. */
-            }
+            prvCancelThread(pxThreadToDelete);
             (void)pthread_mutex_unlock(&xSingleThreadMutex);
         }
         else {
             /* Resume the other thread. */
-            prvResumeThread(xTaskToResume);
+            prvResumeThread(pxTaskToResume);
             /* Pthread Clean-up function will note the cancellation. */
             /* Release the execution. */
             uxCriticalNesting = 0;
             vPortEnableInterrupts();
             (void)pthread_mutex_unlock(&xSingleThreadMutex);
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+            /* Unwind the task, the thread is pooled or exits from there. */
+            siglongjmp(pxThreadToDelete->xTaskExit, 1);
+#else
             /* Commit suicide */
             pthread_exit((void *)1);
+#endif
         }
     }
 }
 /*-----------------------------------------------------------*/
 
+void vPortCleanUpTCB(void *pxTCB)
+{
+    xThreadState *pxThreadState = prvGetThreadState(pxTCB);
+
+    /* Only threads still owned by the task need cancelling, a task that
+     * deleted itself has already released its thread. */
+    if ((NULL != pxThreadState) && (pxThreadState->hTask == pxTCB)) {
+        if (0 == pthread_mutex_lock(&xSingleThreadMutex)) {
+            prvCancelThread(pxThreadState);
+            (void)pthread_mutex_unlock(&xSingleThreadMutex);
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void prvCancelThread(xThreadState *pxThreadState)
+{
+    /** portBASE_TYPE xResult; */
+    if ((pxThreadState->hThread != (pthread_t)NULL) &&
+        (pthread_self() != pxThreadState->hThread)) {
+        pthread_testcancel();
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+        /* Wake the thread to unwind its task, rather than cancelling it, so
+         * that it can be pooled. */
+        if (THREAD_SLEEPING == __atomic_exchange_n(&pxThreadState->iWakeFutex,
+                                                   THREAD_END_TASK,
+                                                   __ATOMIC_ACQ_REL)) {
+            (void)syscall(SYS_futex, &pxThreadState->iWakeFutex,
+                          FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+        }
+#else
+        /* Send a signal to wake the task so that it definitely cancels. */
+        pthread_cancel(pxThreadState->hThread);
+        /** xResult = pthread_cancel( pxThreadState->hThread ); */
+        /* Pthread Clean-up function will note the cancellation. */
+#endif
+    }
+}
+/*-----------------------------------------------------------*/
+
 void *prvWaitForStart(void *pvParams)
 {
-    xParams *pxParams = (xParams *)pvParams;
-    pdTASK_CODE pvCode = pxParams->pxCode;
-    void *pParams = pxParams->pvParams;
-    vPortFree(pvParams);
+    xThreadState *pxThreadState = (xThreadState *)pvParams;
+#if (INCLUDE_uxTaskGetStackHighWaterMark == 1)
+    pthread_attr_t xAttributes;
+    void *pvStack = NULL;
+    size_t xStackSize = 0;
+
+    if (0 == pthread_getattr_np(pthread_self(), &xAttributes)) {
+        (void)pthread_attr_getstack(&xAttributes, &pvStack, &xStackSize);
+        pthread_attr_destroy(&xAttributes);
+    }
+    pxThreadState->pucStackBase = __builtin_frame_address(0);
+    pxThreadState->pucStackLimit = (unsigned char *)pvStack;
+    prvPaintStack(pxThreadState);
+#endif
+
+    pthread_cleanup_push(prvDeleteThread, (void *)pxThreadState);
 
-    pthread_cleanup_push(prvDeleteThread, (void *)pthread_self());
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+    /* Threads spawned for the pool have no creator waiting for them. */
+    if ((NULL != pxThreadState->pxCode) &&
+        (0 == pthread_mutex_lock(&xSingleThreadMutex))) {
+        prvSetSentinel();
+        (void)pthread_mutex_unlock(&xSingleThreadMutex);
+    }
+
+    /* Run one task after another, deleting a task jumps back to here. */
+    for (;;) {
+        if ((NULL == pxThreadState->pxCode) &&
+            (pdFALSE == prvPoolThread(pxThreadState))) {
+            break;
+        }
+
+        if (0 == sigsetjmp(pxThreadState->xTaskExit, 1)) {
+            prvParkThread(pxThreadState);
+            pxThreadState->pxCode(pxThreadState->pvParams);
+            break;
+        }
 
+        pxThreadState->pxCode = NULL;
+#if (INCLUDE_uxTaskGetStackHighWaterMark == 1)
+        prvPaintStack(pxThreadState);
+#endif
+    }
+#else
     if (0 == pthread_mutex_lock(&xSingleThreadMutex)) {
-        prvSuspendThread(pthread_self());
+        prvSuspendThread(pxThreadState);
     }
 
-    pvCode(pParams);
+    pxThreadState->pxCode(pxThreadState->pvParams);
+#endif
 
     pthread_cleanup_pop(1);
     return (void *)NULL;
 }
 /*-----------------------------------------------------------*/
 
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 0)
 void prvSuspendSignalHandler(int sig)
 {
     sigset_t xSignals;
@@ -513,7 +1376,7 @@ void prvSuspendSignalHandler(int sig)
     /* Only interested in the resume signal. */
     sigemptyset(&xSignals);
     sigaddset(&xSignals, SIG_RESUME);
-    xSentinel = 1;
+    prvSetSentinel();
 
     /* Unlock the Single thread mutex to allow the resumed task to continue. */
     if (0 != pthread_mutex_unlock(&xSingleThreadMutex)) {
@@ -536,16 +1399,18 @@ void prvSuspendSignalHandler(int sig)
 }
 /*-----------------------------------------------------------*/
 
-void prvSuspendThread(pthread_t xThreadId)
+void prvSuspendThread(xThreadState *pxThreadState)
 {
     portBASE_TYPE xResult = pthread_mutex_lock(&xSuspendResumeThreadMutex);
     if (0 == xResult) {
         /* Set-up for the Suspend Signal handler? */
-        xSentinel = 0;
+        iSentinel = 0;
         xResult = pthread_mutex_unlock(&xSuspendResumeThreadMutex);
-        xResult = pthread_kill(xThreadId, SIG_SUSPEND);
-        while ((xSentinel == 0) && (pdTRUE != xServicingTick)) {
-            sched_yield();
+        xResult = pthread_kill(pxThreadState->hThread, SIG_SUSPEND);
+        /* The signal is blocked while the tick is being serviced and is
+         * only handled once the tick handler returns. */
+        if (pdTRUE != xServicingTick) {
+            prvWaitForSentinel();
         }
     }
 }
@@ -559,21 +1424,164 @@ void prvResumeSignalHandler(int sig)
     }
 }
 /*-----------------------------------------------------------*/
+#endif /* configUSE_FUTEX_CONTEXT_SWITCH */
+
+void prvSetSentinel(void)
+{
+    /* Also called from the suspend signal handler, futex is signal safe. */
+    __atomic_store_n(&iSentinel, 1, __ATOMIC_RELEASE);
+    (void)syscall(SYS_futex, &iSentinel, FUTEX_WAKE_PRIVATE, INT_MAX, NULL,
+                  NULL, 0);
+}
+/*-----------------------------------------------------------*/
+
+void prvWaitForSentinel(void)
+{
+    while (0 == __atomic_load_n(&iSentinel, __ATOMIC_ACQUIRE)) {
+        (void)syscall(SYS_futex, &iSentinel, FUTEX_WAIT_PRIVATE, 0, NULL, NULL,
+                      0);
+    }
+}
+/*-----------------------------------------------------------*/
 
-void prvResumeThread(pthread_t xThreadId)
+void prvResumeThread(xThreadState *pxThreadState)
 {
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+    if (pthread_self() != pxThreadState->hThread) {
+        prvUnparkThread(pxThreadState);
+    }
+#else
     /** portBASE_TYPE xResult; */
     if (0 == pthread_mutex_lock(&xSuspendResumeThreadMutex)) {
-        if (pthread_self() != xThreadId) {
-            pthread_kill(xThreadId, SIG_RESUME);
+        if (pthread_self() != pxThreadState->hThread) {
+            pthread_kill(pxThreadState->hThread, SIG_RESUME);
             /** xResult = pthread_kill( xThreadId, SIG_RESUME ); */
         }
         pthread_mutex_unlock(&xSuspendResumeThreadMutex);
         /** xResult = pthread_mutex_unlock( &xSuspendResumeThreadMutex ); */
     }
+#endif
+}
+/*-----------------------------------------------------------*/
+
+void prvSwitchThread(xThreadState *pxThreadToSuspend,
+                     xThreadState *pxThreadToResume)
+{
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+    /* Called with xSingleThreadMutex held by the thread being switched out.
+     * The mutex is released before the wake-up so the woken thread does not
+     * immediately contend for it on a busy host. */
+    __atomic_store_n(&pxThreadToSuspend->iWakeFutex, THREAD_PARKED,
+                     __ATOMIC_RELAXED);
+    (void)pthread_mutex_unlock(&xSingleThreadMutex);
+    prvUnparkThread(pxThreadToResume);
+    prvParkThread(pxThreadToSuspend);
+#else
+    prvResumeThread(pxThreadToResume);
+    prvSuspendThread(pxThreadToSuspend);
+#endif
 }
 /*-----------------------------------------------------------*/
 
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+/*
+ * Spins until the futex word leaves THREAD_PARKED, for at most
+ * configFUTEX_SPIN_NS.
+ */
+void prvSpinWhileParked(xThreadState *pxThreadState)
+{
+    struct timespec xStart, xNow;
+    unsigned portBASE_TYPE uxPolls;
+
+    clock_gettime(CLOCK_MONOTONIC, &xStart);
+
+    for (;;) {
+        /* The clock is only read every so often, the word far more often. */
+        for (uxPolls = 0; uxPolls < FUTEX_SPIN_POLLS; uxPolls++) {
+            if (THREAD_PARKED != __atomic_load_n(&pxThreadState->iWakeFutex,
+                                                 __ATOMIC_ACQUIRE)) {
+                return;
+            }
+            prvSpinWaitHint();
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &xNow);
+        if ((xNow.tv_sec - xStart.tv_sec) * 1000000000LL +
+            (xNow.tv_nsec - xStart.tv_nsec) >= configFUTEX_SPIN_NS) {
+            return;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void prvParkThread(xThreadState *pxThreadState)
+{
+    int iWake;
+
+    /* Sleep until another thread hands execution back to this one, after
+     * spinning for a while on a host where that thread runs alongside. */
+    if (pdTRUE == xSpinWhenParked) {
+        prvSpinWhileParked(pxThreadState);
+    }
+
+    for (;;) {
+        iWake = __atomic_load_n(&pxThreadState->iWakeFutex, __ATOMIC_ACQUIRE);
+        if ((THREAD_PARKED != iWake) && (THREAD_SLEEPING != iWake)) {
+            break;
+        }
+
+        /* Announce the sleep, so that the waking thread makes the system
+         * call. The kernel re-checks the futex word so a wake-up that happens
+         * before the wait is never lost. */
+        if ((THREAD_PARKED == iWake) &&
+            !__atomic_compare_exchange_n(&pxThreadState->iWakeFutex, &iWake,
+                                         THREAD_SLEEPING, pdFALSE,
+                                         __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+        (void)syscall(SYS_futex, &pxThreadState->iWakeFutex,
+                      FUTEX_WAIT_PRIVATE, THREAD_SLEEPING, NULL, NULL, 0);
+    }
+
+    /* The task may have been deleted while it was parked. */
+    if (THREAD_END_TASK == iWake) {
+        siglongjmp(pxThreadState->xTaskExit, 1);
+    }
+    pthread_testcancel();
+
+    /* Need to set the interrupts based on the task's critical nesting. */
+    if (uxCriticalNesting == 0) {
+        vPortEnableInterrupts();
+
+        /* Ticks and interrupts raised while the switch was under way were
+         * sent to the thread switched out, which left them to this one. Pairs
+         * with the fences taken before the running thread is signalled. */
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if ((0 != __atomic_load_n(&uxTicksToService, __ATOMIC_RELAXED)) ||
+            (0 != __atomic_load_n(&ulPendingInterrupts, __ATOMIC_RELAXED))) {
+            (void)pthread_kill(pthread_self(), SIG_TICK);
+        }
+    }
+    else {
+        vPortDisableInterrupts();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void prvUnparkThread(xThreadState *pxThreadState)
+{
+    /* No system call is needed while the thread is still spinning. */
+    if ((NULL != pxThreadState) &&
+        (THREAD_SLEEPING == __atomic_exchange_n(&pxThreadState->iWakeFutex,
+                                                THREAD_RUN,
+                                                __ATOMIC_ACQ_REL))) {
+        (void)syscall(SYS_futex, &pxThreadState->iWakeFutex,
+                      FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+}
+/*-----------------------------------------------------------*/
+#endif /* configUSE_FUTEX_CONTEXT_SWITCH */
+
 void prvSetupSignalsAndSchedulerPolicy(void)
 {
     /* The following code would allow for configuring the scheduling of this task as a Real-time task.
@@ -586,17 +1594,18 @@ void prvSetupSignalsAndSchedulerPolicy(void)
     iPolicy = SCHED_FIFO;
     iResult = pthread_setschedparam( pthread_self(), iPolicy, &iSchedulerPriority );        */
 
-    struct sigaction sigsuspendself, sigresume, sigtick;
-    portLONG lIndex;
-
-    pxThreads = (xThreadState *)pvPortMalloc(sizeof(xThreadState) *
-                MAX_NUMBER_OF_TASKS);
-    for (lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++) {
-        pxThreads[lIndex].hThread = (pthread_t)NULL;
-        pxThreads[lIndex].hTask = (xTaskHandle)NULL;
-        pxThreads[lIndex].uxCriticalNesting = 0;
-    }
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 0)
+    struct sigaction sigsuspendself, sigresume;
+#endif
+    struct sigaction sigtick;
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+    xThreadState *pxThreadState;
+    unsigned portBASE_TYPE uxThread;
+    cpu_set_t xCPUs;
+#endif
 
+    /* Threads switching with futexes need no suspend or resume signals. */
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 0)
     sigsuspendself.sa_flags = 0;
     sigsuspendself.sa_handler = prvSuspendSignalHandler;
     sigfillset(&sigsuspendself.sa_mask);
@@ -605,140 +1614,225 @@ void prvSetupSignalsAndSchedulerPolicy(void)
     sigresume.sa_handler = prvResumeSignalHandler;
     sigfillset(&sigresume.sa_mask);
 
-    sigtick.sa_flags = 0;
-    sigtick.sa_handler = vPortSystemTickHandler;
-    sigfillset(&sigtick.sa_mask);
-
     if (0 != sigaction(SIG_SUSPEND, &sigsuspendself, NULL)) {
         printf("Problem installing SIG_SUSPEND_SELF\n");
     }
     if (0 != sigaction(SIG_RESUME, &sigresume, NULL)) {
         printf("Problem installing SIG_RESUME\n");
     }
+#endif
+
+    /* Restart system calls the tick interrupts where possible. */
+    sigtick.sa_flags = SA_RESTART;
+    sigtick.sa_handler = vPortSystemTickHandler;
+    sigfillset(&sigtick.sa_mask);
+
     if (0 != sigaction(SIG_TICK, &sigtick, NULL)) {
         printf("Problem installing SIG_TICK\n");
     }
-    printf("Running as PID: %d\n", getpid());
-}
-/*-----------------------------------------------------------*/
 
-pthread_t prvGetThreadHandle(xTaskHandle hTask)
-{
-    pthread_t hThread = (pthread_t)NULL;
-    portLONG lIndex;
-    for (lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++) {
-        if (pxThreads[lIndex].hTask == hTask) {
-            hThread = pxThreads[lIndex].hThread;
+    /* Simulated interrupts are serviced in the same way as the tick. */
+    if (0 != sigaction(SIG_INTERRUPT, &sigtick, NULL)) {
+        printf("Problem installing SIG_INTERRUPT\n");
+    }
+
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+    /* With a single CPU the thread to switch in cannot run while the thread
+     * switched out spins, so it sleeps straight away. */
+    if ((configFUTEX_SPIN_NS > 0) &&
+        (0 == sched_getaffinity(0, sizeof(xCPUs), &xCPUs)) &&
+        (CPU_COUNT(&xCPUs) > 1)) {
+        xSpinWhenParked = pdTRUE;
+    }
+
+    /* Pre-spawn the thread pool, the threads add themselves to it. */
+    for (uxThread = 0; uxThread < configTHREAD_POOL_SIZE; uxThread++) {
+        pxThreadState = prvGetFreeThreadState();
+        if (NULL == pxThreadState) {
+            break;
+        }
+        pxThreadState->pxCode = NULL;
+        pxThreadState->xStackSize =
+            prvGetHostStackSize(configTHREAD_POOL_STACK_DEPTH);
+        if (0 != prvSpawnThread(pxThreadState)) {
+            pxThreadState->hThread = (pthread_t)NULL;
+            prvReleaseThreadState(pxThreadState);
             break;
         }
     }
-    return hThread;
+#endif
+    printf("Running as PID: %d\n", getpid());
 }
 /*-----------------------------------------------------------*/
 
-portLONG prvGetFreeThreadState(void)
+xThreadState *prvGetFreeThreadState(void)
 {
+    xThreadStateBlock *pxBlock;
+    xThreadState *pxThreadState;
     portLONG lIndex;
-    for (lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++) {
-        if (pxThreads[lIndex].hThread == (pthread_t)NULL) {
-            break;
+
+    (void)pthread_mutex_lock(&xThreadTableMutex);
+
+    if (NULL == pxFreeThreads) {
+        /* Grow the table by another block of thread states. */
+        if (NULL == pxThreadBlocks) {
+            pxBlock = &xFirstThreadBlock;
+        }
+        else {
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+            /* The thread states follow the block header. */
+            pxBlock = (xThreadStateBlock *)pvPortMalloc(
+                          sizeof(xThreadStateBlock) +
+                          THREAD_STATE_BLOCK_SIZE * sizeof(xThreadState));
+            if (NULL != pxBlock) {
+                pxBlock->lThreads = THREAD_STATE_BLOCK_SIZE;
+                pxBlock->pxThreads = (xThreadState *)(pxBlock + 1);
+            }
+#else
+            pxBlock = NULL;
+#endif
+        }
+        if (NULL != pxBlock) {
+            for (lIndex = 0; lIndex < pxBlock->lThreads; lIndex++) {
+                pxBlock->pxThreads[lIndex].hThread = (pthread_t)NULL;
+                pxBlock->pxThreads[lIndex].hTask = (xTaskHandle)NULL;
+                pxBlock->pxThreads[lIndex].uxCriticalNesting = 0;
+                pxBlock->pxThreads[lIndex].iWakeFutex = THREAD_PARKED;
+                pxBlock->pxThreads[lIndex].xStackSize = 0;
+                pxBlock->pxThreads[lIndex].pxNextFree =
+                    (lIndex + 1 < pxBlock->lThreads) ?
+                    &pxBlock->pxThreads[lIndex + 1] : NULL;
+            }
+            pxBlock->pxNext = pxThreadBlocks;
+            pxThreadBlocks = pxBlock;
+            pxFreeThreads = &pxBlock->pxThreads[0];
         }
     }
 
-    if (MAX_NUMBER_OF_TASKS == lIndex) {
-        printf("No more free threads, please increase the maximum.\n");
-        lIndex = 0;
-        vPortEndScheduler();
+    pxThreadState = pxFreeThreads;
+    if (NULL != pxThreadState) {
+        pxFreeThreads = pxThreadState->pxNextFree;
+        pxThreadState->pxNextFree = NULL;
     }
 
-    return lIndex;
+    (void)pthread_mutex_unlock(&xThreadTableMutex);
+
+    /* NULL is passed up to the task creation function, which fails. */
+    return pxThreadState;
 }
 /*-----------------------------------------------------------*/
 
-void prvSetTaskCriticalNesting(pthread_t xThreadId,
-                               unsigned portBASE_TYPE uxNesting)
+#if (configUSE_FUTEX_CONTEXT_SWITCH == 1)
+/*
+ * Takes the first pooled thread whose stack holds at least xStackSize bytes.
+ */
+xThreadState *prvGetPooledThread(size_t xStackSize)
 {
-    portLONG lIndex;
-    for (lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++) {
-        if (pxThreads[lIndex].hThread == xThreadId) {
-            pxThreads[lIndex].uxCriticalNesting = uxNesting;
-            break;
-        }
+    xThreadState **ppxLink;
+    xThreadState *pxThreadState;
+
+    (void)pthread_mutex_lock(&xThreadTableMutex);
+    ppxLink = &pxPooledThreads;
+    while ((NULL != *ppxLink) && ((*ppxLink)->xStackSize < xStackSize)) {
+        ppxLink = &(*ppxLink)->pxNextFree;
     }
+    pxThreadState = *ppxLink;
+    if (NULL != pxThreadState) {
+        *ppxLink = pxThreadState->pxNextFree;
+        pxThreadState->pxNextFree = NULL;
+        uxPooledThreads--;
+    }
+    (void)pthread_mutex_unlock(&xThreadTableMutex);
+
+    return pxThreadState;
 }
 /*-----------------------------------------------------------*/
 
-unsigned portBASE_TYPE prvGetTaskCriticalNesting(pthread_t xThreadId)
+/*
+ * Called by a thread without a task. Returns pdTRUE if the thread has been
+ * added to the pool, pdFALSE if the pool is full and the thread should exit.
+ */
+portBASE_TYPE prvPoolThread(xThreadState *pxThreadState)
 {
-    unsigned portBASE_TYPE uxNesting = 0;
-    portLONG lIndex;
-    for (lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++) {
-        if (pxThreads[lIndex].hThread == xThreadId) {
-            uxNesting = pxThreads[lIndex].uxCriticalNesting;
-            break;
-        }
+    portBASE_TYPE xPooled = pdFALSE;
+
+    pxThreadState->hTask = (xTaskHandle)NULL;
+    pxThreadState->uxCriticalNesting = 0;
+    /* Parked until the scheduler first runs the next task. */
+    pxThreadState->iWakeFutex = THREAD_PARKED;
+
+    (void)pthread_mutex_lock(&xThreadTableMutex);
+    if ((uxPooledThreads < configTHREAD_POOL_SIZE) &&
+        (pdTRUE != xSchedulerEnd)) {
+        pxThreadState->pxNextFree = pxPooledThreads;
+        pxPooledThreads = pxThreadState;
+        uxPooledThreads++;
+        xPooled = pdTRUE;
     }
-    return uxNesting;
+    (void)pthread_mutex_unlock(&xThreadTableMutex);
+
+    return xPooled;
 }
 /*-----------------------------------------------------------*/
+#endif /* configUSE_FUTEX_CONTEXT_SWITCH */
 
-void prvDeleteThread(void *xThreadId)
+void prvReleaseThreadState(xThreadState *pxThreadState)
 {
-    portLONG lIndex;
-    for (lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++) {
-        if (pxThreads[lIndex].hThread == (pthread_t)xThreadId) {
-            pxThreads[lIndex].hThread = (pthread_t)NULL;
-            pxThreads[lIndex].hTask = (xTaskHandle)NULL;
-            if (pxThreads[lIndex].uxCriticalNesting > 0) {
-                uxCriticalNesting = 0;
-                vPortEnableInterrupts();
-            }
-            pxThreads[lIndex].uxCriticalNesting = 0;
-            break;
-        }
+    (void)pthread_mutex_lock(&xThreadTableMutex);
+    pxThreadState->pxNextFree = pxFreeThreads;
+    pxFreeThreads = pxThreadState;
+    (void)pthread_mutex_unlock(&xThreadTableMutex);
+}
+/*-----------------------------------------------------------*/
+
+void prvDeleteThread(void *pxThreadState)
+{
+    xThreadState *pxThread = (xThreadState *)pxThreadState;
+
+    pxThread->hThread = (pthread_t)NULL;
+    pxThread->hTask = (xTaskHandle)NULL;
+    if (pxThread->uxCriticalNesting > 0) {
+        uxCriticalNesting = 0;
+        vPortEnableInterrupts();
     }
+    pxThread->uxCriticalNesting = 0;
+    prvReleaseThreadState(pxThread);
 }
 /*-----------------------------------------------------------*/
 
 void vPortAddTaskHandle(void *pxTaskHandle)
 {
-    portLONG lIndex;
+    xThreadState *pxThreadState = prvGetThreadState(pxTaskHandle);
 
-    pxThreads[lIndexOfLastAddedTask].hTask = (xTaskHandle)pxTaskHandle;
-    for (lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++) {
-        if (pxThreads[lIndex].hThread ==
-            pxThreads[lIndexOfLastAddedTask].hThread) {
-            if (pxThreads[lIndex].hTask !=
-                pxThreads[lIndexOfLastAddedTask].hTask) {
-                pxThreads[lIndex].hThread = (pthread_t)NULL;
-                pxThreads[lIndex].hTask = NULL;
-                pxThreads[lIndex].uxCriticalNesting = 0;
-            }
-        }
+    if (NULL != pxThreadState) {
+        pxThreadState->hTask = (xTaskHandle)pxTaskHandle;
     }
 }
 /*-----------------------------------------------------------*/
 
 void vPortFindTicksPerSecond(void)
 {
-    /* Needs to be reasonably high for accuracy. */
-    unsigned long ulTicksPerSecond = sysconf(_SC_CLK_TCK);
-    printf("Timer Resolution for Run TimeStats is %ld ticks per second.\n",
-           ulTicksPerSecond);
+    struct timespec xResolution;
+
+    /* Count from the start of the scheduler. */
+    clock_gettime(CLOCK_MONOTONIC, &xRunTimeStart);
+
+    if (0 == clock_getres(CLOCK_MONOTONIC, &xResolution)) {
+        printf("Timer Resolution for Run TimeStats is %ld ns.\n",
+               xResolution.tv_sec * 1000000000L + xResolution.tv_nsec);
+    }
 }
 /*-----------------------------------------------------------*/
 
-unsigned long ulPortGetTimerValue(void)
+configRUN_TIME_COUNTER_TYPE ulPortGetTimerValue(void)
 {
-    struct tms xTimes;
-    unsigned long ulTotalTime = times(&xTimes);
-    /* Return the application code times.
-     * The timer only increases when the application code is actually running
-     * which means that the total execution times should add up to 100%.
-     */
-    return (unsigned long)xTimes.tms_utime;
+    struct timespec xNow;
 
-    /* Should check ulTotalTime for being clock_t max minus 1. */
-    (void)ulTotalTime;
+    /* Only one task thread runs at a time, so the monotonic time between two
+     * context switches is the time the switched out task has been running.
+     */
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return (configRUN_TIME_COUNTER_TYPE)(xNow.tv_sec - xRunTimeStart.tv_sec) *
+           1000000000ULL + xNow.tv_nsec - xRunTimeStart.tv_nsec;
 }
 /*-----------------------------------------------------------*/
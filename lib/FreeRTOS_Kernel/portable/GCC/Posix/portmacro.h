@@ -106,6 +106,7 @@ not need to be guarded with a critical section. */
 #define portTICK_PERIOD_MS              ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
 #define portTICK_PERIOD_MICROSECONDS        ( ( TickType_t ) 1000000 / configTICK_RATE_HZ )
 #define portBYTE_ALIGNMENT              4
+#define portPOINTER_SIZE_TYPE           uintptr_t
 #define portREMOVE_STATIC_QUALIFIER
 /*-----------------------------------------------------------*/
 
@@ -122,6 +123,47 @@ extern void vPortYield(void);
 #define portYIELD_FROM_ISR( xSwitchRequired ) portEND_SWITCHING_ISR( xSwitchRequired )
 /*-----------------------------------------------------------*/
 
+/* Architecture specific optimisations. The ready priorities are kept in a
+bit map in uxTopReadyPriority, one bit per priority, so the highest priority
+with ready tasks is found by counting the leading zeros of the bit map rather
+than by searching the ready lists. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+#endif
+
+#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+/* Check the configuration. */
+#if( configMAX_PRIORITIES > ( __SIZEOF_LONG__ * 8 ) )
+#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is at most the number of bits of UBaseType_t, 64 on 64-bit hosts.
+#endif
+
+/* Store/clear the ready priorities in a bit map. */
+#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+/*-----------------------------------------------------------*/
+
+#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( ( UBaseType_t ) ( ( __SIZEOF_LONG__ * 8 ) - 1 ) - ( UBaseType_t ) __builtin_clzl( ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* Simulated interrupts. Host threads that are not tasks, such as those that
+run AsyncIO callbacks, must not call the kernel themselves but raise an
+interrupt, whose handler the thread of the running task then runs from its
+tick handler: at once unless interrupts are disabled, otherwise at the end of
+the critical section or the next tick. Handlers may use the _FROM_ISR() API
+and return non-zero, or call portYIELD_FROM_ISR(), to switch task. Raising an
+interrupt that is still pending has no further effect, lower numbers are
+serviced first. */
+#define portMAX_INTERRUPTS          ( ( uint32_t ) 32 )
+
+extern void vPortGenerateSimulatedInterrupt(uint32_t ulInterruptNumber);
+extern void vPortSetInterruptHandler(uint32_t ulInterruptNumber,
+                                     uint32_t (*pvHandler)(void));
+/*-----------------------------------------------------------*/
+
 
 /* Critical section management. */
 extern void vPortDisableInterrupts(void);
@@ -156,12 +198,125 @@ extern void vPortExitCritical(void);
 extern void vPortForciblyEndThread(void *pxTaskToDelete);
 #define traceTASK_DELETE( pxTaskToDelete )      vPortForciblyEndThread( pxTaskToDelete )
 
+extern void vPortCleanUpTCB(void *pxTCB);
+#define portCLEAN_UP_TCB( pxTCB )               vPortCleanUpTCB( pxTCB )
+
 extern void vPortAddTaskHandle(void *pxTaskHandle);
 #define traceTASK_CREATE( pxNewTCB )            vPortAddTaskHandle( pxNewTCB )
 
+/* Select how execution is handed from one task thread to the next. When set
+to 1 every task thread parks on its own futex and only the thread that is to
+run next is woken, otherwise threads are suspended and resumed by signals. */
+#ifndef configUSE_FUTEX_CONTEXT_SWITCH
+#define configUSE_FUTEX_CONTEXT_SWITCH  1
+#endif
+
+/* Nanoseconds a thread that was switched out with futexes spins on its futex
+word before it sleeps in the kernel, if the process may run on more than one
+CPU. A thread switched back in meanwhile takes over without a system call on
+either side, at the cost of keeping a CPU busy for up to this long after each
+switch. Set to 0 to always sleep straight away. */
+#ifndef configFUTEX_SPIN_NS
+#define configFUTEX_SPIN_NS             0
+#endif
+
+/* Select how the tick is generated. When set to 1 a dedicated thread sleeps
+until each tick's absolute deadline on CLOCK_MONOTONIC and sends SIG_TICK to
+the running task's thread only, otherwise a process wide interval timer of
+TIMER_TYPE raises SIG_TICK. */
+#ifndef configUSE_TICK_THREAD
+#define configUSE_TICK_THREAD           1
+#endif
+
+/* Statistics of the tick thread, see vPortGetTickStats(). Bucket 0 of the
+jitter histogram counts ticks raised less than 1us late, bucket n counts those
+less than 2^n us late and the last bucket counts all later ones. */
+#define portTICK_JITTER_BUCKETS         16
+
+typedef struct xPORT_TICK_STATS {
+    unsigned long ulTicks;          /* Tick periods that have elapsed. */
+    unsigned long ulMissedTicks;    /* Periods that were overslept. */
+    unsigned long ulMaxLatenessNs;  /* Latest that a tick has been raised. */
+    unsigned long ulJitterHistogram[portTICK_JITTER_BUCKETS];
+} xPortTickStats;
+
+extern void vPortGetTickStats(xPortTickStats *pxStats);
+extern void vPortResetTickStats(void);
+
+/* Virtual time decouples the tick from the wall clock to simulate faster than
+real time. While tasks are runnable a tick is raised after every
+configVIRTUAL_TICK_BUDGET_US microseconds of real time, while all tasks are
+blocked the tick count jumps straight to the next unblock time. Requires the
+tick thread and tickless idle. */
+#ifndef configUSE_VIRTUAL_TIME
+#define configUSE_VIRTUAL_TIME          0
+#endif
+
+#ifndef configVIRTUAL_TICK_BUDGET_US
+#define configVIRTUAL_TICK_BUDGET_US    100
+#endif
+
+/* Tickless idle needs the tick thread. A simulated interrupt that readies a
+task during a tickless period ends it through portYIELD_FROM_ISR(). */
+extern void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )  vPortSuppressTicksAndSleep( xExpectedIdleTime )
+
+/* Number of host threads kept parked for reuse by new tasks. They are spawned
+when the first task is created and the thread of a deleted task returns to the
+pool while it has room. Only used with configUSE_FUTEX_CONTEXT_SWITCH. */
+#ifndef configTHREAD_POOL_SIZE
+#define configTHREAD_POOL_SIZE          0
+#endif
+
+/* Each task runs from a thread state of the port, and so does each parked
+pooled thread. The first configTHREAD_POOL_SIZE + configMAX_STATIC_TASKS thread
+states are a static array, so that configMAX_STATIC_TASKS tasks, including the
+idle and timer tasks, can run at a time however full the pool is. Further
+thread states are taken from pvPortMalloc(), without
+configSUPPORT_DYNAMIC_ALLOCATION creating a task beyond the limit fails. */
+#ifndef configMAX_STATIC_TASKS
+#define configMAX_STATIC_TASKS          48
+#endif
+
+/* The stack of a task is the stack of its host thread. Host library code
+needs far more stack than code built for a microcontroller, so the thread gets
+the task's stack depth scaled by configHOST_STACK_SCALE, but no less than
+configMINIMAL_HOST_STACK_SIZE bytes. Pages are only committed once touched and
+a guard page below the stack turns an overflow into a fault. Pooled threads are
+spawned with a stack for configTHREAD_POOL_STACK_DEPTH and only take tasks that
+fit. */
+#define portHAS_STACK_OVERFLOW_CHECKING 1
+
+/* With INCLUDE_uxTaskGetStackHighWaterMark set to 1, uxTaskGetStackHighWaterMark()
+and vTaskGetInfo() measure the host stacks that tasks run on rather than the
+stack the kernel allocates. Each thread zeroes the pages of its stack that are
+resident before it runs a task, which costs a system call, and the lowest byte
+that is no longer zero is the task's peak. Pages that were never touched stay
+uncommitted. The result is the task's stack depth less the peak in words
+scaled down by configHOST_STACK_SCALE, so it says how far the depth could be
+cut. */
+#if( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+#define portGET_STACK_HIGH_WATER_MARK( pxTopOfStack ) uxPortGetStackHighWaterMark( ( portSTACK_TYPE * ) ( pxTopOfStack ) )
+extern unsigned portBASE_TYPE uxPortGetStackHighWaterMark(portSTACK_TYPE *pxTopOfStack);
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+
+#ifndef configHOST_STACK_SCALE
+#define configHOST_STACK_SCALE          16
+#endif
+
+#ifndef configMINIMAL_HOST_STACK_SIZE
+#define configMINIMAL_HOST_STACK_SIZE   ( 64 * 1024 )
+#endif
+
+#ifndef configTHREAD_POOL_STACK_DEPTH
+#define configTHREAD_POOL_STACK_DEPTH   configMINIMAL_STACK_SIZE
+#endif
+
 /* Posix Signal definitions that can be changed or read as appropriate. */
 #define SIG_SUSPEND                 SIGUSR1
 #define SIG_RESUME                  SIGUSR2
+/* Interrupts the running task's thread to service simulated interrupts. */
+#define SIG_INTERRUPT               SIGRTMIN
 
 /* Enable the following hash defines to make use of the real-time tick where time progresses at real-time. */
 #define SIG_TICK                    SIGALRM
@@ -173,11 +328,14 @@ extern void vPortAddTaskHandle(void *pxTaskHandle);
 #define SIG_TICK                    SIGPROF
 #define TIMER_TYPE                  ITIMER_PROF */
 
-/* Make use of times(man 2) to gather run-time statistics on the tasks. */
+/* Run-time statistics count the nanoseconds of CLOCK_MONOTONIC that each task
+spends running, configRUN_TIME_COUNTER_TYPE should be uint64_t as a 32-bit
+counter overflows after about 4 seconds. */
 extern void vPortFindTicksPerSecond(void);
-#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    vPortFindTicksPerSecond()       /* Nothing to do because the timer is already present. */
-extern unsigned long ulPortGetTimerValue(void);
-#define portGET_RUN_TIME_COUNTER_VALUE()            ulPortGetTimerValue()           /* Query the System time stats for this process. */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    vPortFindTicksPerSecond()       /* Remember when the scheduler started. */
+extern configRUN_TIME_COUNTER_TYPE ulPortGetTimerValue(void);
+#define portGET_RUN_TIME_COUNTER_VALUE()            ulPortGetTimerValue()           /* Nanoseconds since the scheduler started. */
+#define portLU_PRINTF_SPECIFIER_REQUIRED
 
 #ifdef __cplusplus
 }
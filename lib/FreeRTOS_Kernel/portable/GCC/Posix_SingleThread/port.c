@@ -0,0 +1,1424 @@
+/*
+    FreeRTOS.org V5.2.0 - Copyright (C) 2003-2009 Richard Barry.
+
+    This file is part of the FreeRTOS.org distribution.
+
+    FreeRTOS.org is free software; you can redistribute it and/or modify it
+    under the terms of the GNU General Public License (version 2) as published
+    by the Free Software Foundation and modified by the FreeRTOS exception.
+
+    FreeRTOS.org is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details.
+
+    You should have received a copy of the GNU General Public License along
+    with FreeRTOS.org; if not, write to the Free Software Foundation, Inc., 59
+    Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+    A special exception to the GPL is included to allow you to distribute a
+    combined work that includes FreeRTOS.org without being obliged to provide
+    the source code for any proprietary components.  See the licensing section
+    of http://www.FreeRTOS.org for full details.
+
+
+    ***************************************************************************
+    *                                                                         *
+    * Get the FreeRTOS eBook!  See http://www.FreeRTOS.org/Documentation      *
+    *                                                                         *
+    * This is a concise, step by step, 'hands on' guide that describes both   *
+    * general multitasking concepts and FreeRTOS specifics. It presents and   *
+    * explains numerous examples that are written using the FreeRTOS API.     *
+    * Full source code for all the examples is provided in an accompanying    *
+    * .zip file.                                                              *
+    *                                                                         *
+    ***************************************************************************
+
+    1 tab == 4 spaces!
+
+    Please ensure to read the configuration and relevant port sections of the
+    online documentation.
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the single host
+ * thread Posix port.
+ *
+ * Every task runs on its own mapped stack within the thread that started the
+ * scheduler. Tasks are switched by swapping stacks in user space, which takes
+ * no system call and makes the schedule depend only on the kernel. The tick
+ * is a timer signal to this thread, a task is only preempted by it while
+ * running code of the executable itself, never inside a host library that
+ * may hold a lock the next task needs. Such ticks are serviced once the task
+ * next enters the kernel.
+ *
+ * With configNUMBER_OF_CORES above 1 each simulated core is a host thread of
+ * its own that runs tasks in the same way, the thread that started the
+ * scheduler being core 0. Critical sections, interrupt masks and the task
+ * lock then also take a kernel lock shared by all cores, and a core yields
+ * another by signalling its thread.
+ *----------------------------------------------------------*/
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <pthread.h>
+#include <signal.h>
+#include <errno.h>
+#include <time.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <ucontext.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/*-----------------------------------------------------------*/
+
+#if (configUSE_VIRTUAL_TIME == 1)
+#if (configUSE_TICKLESS_IDLE == 0)
+#error configUSE_VIRTUAL_TIME requires configUSE_TICKLESS_IDLE
+#endif
+/* Ticks are raised after each budget of real time while tasks are runnable,
+ * and skipped entirely while all tasks are blocked. */
+#define TICK_PERIOD_NS ((long long)configVIRTUAL_TICK_BUDGET_US * 1000LL)
+#else
+#define TICK_PERIOD_NS (1000000000LL / configTICK_RATE_HZ)
+#endif
+
+/* Stacks are switched by hand where the registers to keep are known, which
+ * unlike swapcontext() does not save the signal mask with a system call. */
+#if defined(__x86_64__)
+#define portSWITCH_STACKS 1
+#else
+#define portSWITCH_STACKS 0
+#endif
+
+/* The tick and yields never preempt the port's own functions, which switch
+ * task only where they mean to. A task could otherwise move to another core
+ * between looking up its core and changing that core's state. */
+#define portNO_PREEMPT __attribute__((section("freertos_port_text")))
+
+/* Hint to the CPU while spinning on the kernel lock. */
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__)
+#define CPU_RELAX() __asm__ volatile("yield")
+#else
+#define CPU_RELAX()
+#endif
+
+#if (configNUMBER_OF_CORES > 1) && (configUSE_TICKLESS_IDLE != 0)
+#error Tickless idle, and with it configUSE_VIRTUAL_TIME, needs a single core
+#endif
+
+/* Pages whose residency is looked up at once while scanning a stack. */
+#define portSTACK_SCAN_PAGES 64
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+/*-----------------------------------------------------------*/
+
+/* The context of a task lives at the top of its stack mapping. */
+typedef struct TASK_CONTEXT {
+#if (portSWITCH_STACKS == 1)
+    void *pvStackPointer;
+#else
+    ucontext_t xContext;
+#endif
+    pdTASK_CODE pxCode;
+    void *pvParams;
+    void *pvMapping;
+    size_t xMappingSize;
+    unsigned portBASE_TYPE uxStackDepth;
+} xTaskContext;
+
+/* pxPortInitialiseStack() returns the context so that the kernel stores it in
+ * pxTopOfStack, the first member of the TCB. */
+#define prvGetTaskContext(hTask)                                               \
+    (((hTask) == NULL) ? (xTaskContext *)NULL : *(xTaskContext **)(hTask))
+/*-----------------------------------------------------------*/
+
+/* The interrupt state of a simulated core. Host threads that are not a core,
+ * such as those of the simulated peripherals, get a state of their own to
+ * mask interrupts and take the kernel lock with. */
+typedef struct CORE_STATE {
+    volatile portBASE_TYPE xInterruptsEnabled;
+    volatile unsigned portBASE_TYPE uxCriticalNesting;
+    /* A task switch requested while the core could not switch. */
+    volatile portBASE_TYPE xPendYield;
+    /* Set while the core runs tasks rather than its scheduler context. */
+    volatile portBASE_TYPE xRunning;
+    portBASE_TYPE xCoreID;          /* -1 if the thread is not a core. */
+    pthread_t hThread;
+    /* Where the core's thread returns to once the scheduler ends. */
+    xTaskContext xSchedulerContext;
+} xCoreState;
+
+static xCoreState xCores[configNUMBER_OF_CORES];
+static __thread xCoreState *pxThisCore = NULL;
+static __thread xCoreState xHostThread = { pdTRUE, 0, pdFALSE, pdFALSE, -1 };
+static volatile portBASE_TYPE xSchedulerStarted = pdFALSE;
+static timer_t hTickTimer;
+static volatile portBASE_TYPE xSchedulerEnd = pdFALSE;
+/* Ticks raised on core 0 but not yet passed to the kernel, for instance
+ * because interrupts were disabled when they occurred. */
+static volatile unsigned portBASE_TYPE uxTicksToService = 0;
+static struct timespec xRunTimeStart;
+static struct timespec xNextTick;
+static xPortTickStats xTickStats;
+/* Simulated interrupts raised but not yet serviced, one bit each, and the
+ * handlers core 0 runs for them. */
+static volatile uint32_t ulPendingInterrupts = 0;
+static uint32_t (*volatile pvInterruptHandlers[portMAX_INTERRUPTS])(void);
+
+#if (configNUMBER_OF_CORES > 1)
+/* The kernel lock is 0 while free, 1 while taken and 2 while taken with
+ * threads waiting for it. It may be taken again by the thread that holds it. */
+static volatile int iKernelLock = 0;
+static xCoreState *volatile pxKernelLockOwner = NULL;
+static unsigned portBASE_TYPE uxKernelLockCount = 0;
+static pthread_barrier_t xCoresStarted;
+#endif
+/*-----------------------------------------------------------*/
+
+/* Bounds of the executable's own code and of the port's code within it,
+ * provided by the linker. */
+extern char __executable_start[];
+extern char etext[];
+extern char __start_freertos_port_text[];
+extern char __stop_freertos_port_text[];
+/*-----------------------------------------------------------*/
+
+static size_t prvGetHostStackSize(size_t xStackDepth);
+static unsigned char *prvFindStackPeak(unsigned char *pucLow,
+                                       unsigned char *pucHigh);
+static xCoreState *prvGetCore(void) __attribute__((noinline));
+static portBASE_TYPE prvGetKernelLock(xCoreState *pxCore);
+static void prvReleaseKernelLock(xCoreState *pxCore);
+static xCoreState *prvEnterKernel(xCoreState *pxCore, portBASE_TYPE xMayYield);
+static portBASE_TYPE prvInterruptsPending(xCoreState *pxCore);
+static void prvLeaveScheduler(xCoreState *pxCore);
+static int *prvGetErrno(void) __attribute__((noinline));
+static void prvTaskStart(void);
+static void prvSwitchContext(xTaskContext *pxFrom, xTaskContext *pxTo);
+static void prvSwitchTasks(void);
+static void prvRestoreInterrupts(void);
+static void prvServiceInterrupts(void);
+static portBASE_TYPE prvRunInterruptHandlers(void);
+static portBASE_TYPE prvInterruptedTaskCode(void *pvContext);
+static void prvInterruptHandler(int iSignal, siginfo_t *pxInfo,
+                                void *pvContext);
+static void prvArmTickTimer(long long llFirstNs);
+static void prvTimespecAdd(struct timespec *pxTime, long long llNs);
+static void prvRecordTick(long long llLatenessNs, unsigned long ulMissed);
+/*-----------------------------------------------------------*/
+
+#if (portSWITCH_STACKS == 1)
+/*
+ * Saves the callee saved registers and the floating point control words on
+ * the current stack, stores the stack pointer in *ppvSave and restores the
+ * same from pvNew. A new task's stack is prepared to return into
+ * prvTaskTrampoline, which calls the function held in r12.
+ */
+void prvSwitchStacks(void **ppvSave, void *pvNew);
+void prvTaskTrampoline(void);
+
+__asm__(
+    "    .text\n"
+    "    .globl prvSwitchStacks\n"
+    "    .hidden prvSwitchStacks\n"
+    "    .type prvSwitchStacks, @function\n"
+    "prvSwitchStacks:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $8, %rsp\n"
+    "    stmxcsr (%rsp)\n"
+    "    fnstcw 4(%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr (%rsp)\n"
+    "    fldcw 4(%rsp)\n"
+    "    addq $8, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    "    .size prvSwitchStacks, .-prvSwitchStacks\n"
+    "    .globl prvTaskTrampoline\n"
+    "    .hidden prvTaskTrampoline\n"
+    "    .type prvTaskTrampoline, @function\n"
+    "prvTaskTrampoline:\n"
+    "    andq $-16, %rsp\n"
+    "    callq *%r12\n"
+    "    ud2\n"
+    "    .size prvTaskTrampoline, .-prvTaskTrampoline\n");
+#endif
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+portNO_PREEMPT
+portSTACK_TYPE *pxPortInitialiseStack(portSTACK_TYPE *pxTopOfStack,
+                                      portSTACK_TYPE *pxEndOfStack,
+                                      pdTASK_CODE pxCode, void *pvParameters)
+{
+    size_t xPageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t xStackSize =
+        prvGetHostStackSize((size_t)(pxTopOfStack - pxEndOfStack) + 1);
+    size_t xMappingSize = xPageSize + xStackSize +
+                          ((sizeof(xTaskContext) + xPageSize - 1) &
+                           ~(xPageSize - 1));
+    xTaskContext *pxContext;
+    unsigned char *pucMapping;
+#if (portSWITCH_STACKS == 1)
+    uint64_t *pullStack;
+#endif
+
+    /* Pages are only committed once the task touches them. */
+    pucMapping = mmap(NULL, xMappingSize, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_STACK,
+                      -1, 0);
+    if (MAP_FAILED == pucMapping) {
+        return 0;
+    }
+    /* The stack grows down into the guard page. */
+    (void)mprotect(pucMapping, xPageSize, PROT_NONE);
+
+    pxContext = (xTaskContext *)(pucMapping + xMappingSize -
+                                 sizeof(xTaskContext));
+    pxContext->pxCode = pxCode;
+    pxContext->pvParams = pvParameters;
+    pxContext->pvMapping = pucMapping;
+    pxContext->xMappingSize = xMappingSize;
+    pxContext->uxStackDepth = (size_t)(pxTopOfStack - pxEndOfStack) + 1;
+
+#if (portSWITCH_STACKS == 1)
+    /* The frame prvSwitchStacks() restores: the control words, r15 to r12,
+     * rbx, rbp and the return address. */
+    pullStack = (uint64_t *)(((uintptr_t)pxContext) & ~(uintptr_t)15);
+    *--pullStack = 0;
+    *--pullStack = (uint64_t)(uintptr_t)prvTaskTrampoline;
+    *--pullStack = 0;                                   /* rbp */
+    *--pullStack = 0;                                   /* rbx */
+    *--pullStack = (uint64_t)(uintptr_t)prvTaskStart;   /* r12 */
+    *--pullStack = 0;                                   /* r13 */
+    *--pullStack = 0;                                   /* r14 */
+    *--pullStack = 0;                                   /* r15 */
+    *--pullStack = (0x037FULL << 32) | 0x1F80ULL;       /* x87 CW, MXCSR */
+    pxContext->pvStackPointer = pullStack;
+#else
+    getcontext(&pxContext->xContext);
+    pxContext->xContext.uc_stack.ss_sp = pucMapping + xPageSize;
+    pxContext->xContext.uc_stack.ss_size =
+        (unsigned char *)pxContext - (pucMapping + xPageSize);
+    pxContext->xContext.uc_link = NULL;
+    makecontext(&pxContext->xContext, prvTaskStart, 0);
+#endif
+
+    return (portSTACK_TYPE *)pxContext;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the size of the host stack for a task stack of xStackDepth words.
+ */
+portNO_PREEMPT
+size_t prvGetHostStackSize(size_t xStackDepth)
+{
+    size_t xPageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t xStackSize =
+        xStackDepth * sizeof(portSTACK_TYPE) * configHOST_STACK_SCALE;
+
+    if (xStackSize < configMINIMAL_HOST_STACK_SIZE) {
+        xStackSize = configMINIMAL_HOST_STACK_SIZE;
+    }
+
+    return (xStackSize + xPageSize - 1) & ~(xPageSize - 1);
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the lowest byte in [pucLow, pucHigh) that is not zero, or pucHigh.
+ * Fresh pages read as zero, so stacks need no painting, and pages that have
+ * never been touched are not resident and are skipped without reading them.
+ */
+portNO_PREEMPT
+unsigned char *prvFindStackPeak(unsigned char *pucLow, unsigned char *pucHigh)
+{
+    size_t xPageSize = (size_t)sysconf(_SC_PAGESIZE);
+    unsigned char ucResident[portSTACK_SCAN_PAGES];
+    unsigned char *pucPage, *pucByte, *pucEnd;
+    size_t xPages, x;
+
+    pucPage = (unsigned char *)((uintptr_t)pucLow & ~(uintptr_t)(xPageSize - 1));
+    while (pucPage < pucHigh) {
+        xPages = ((size_t)(pucHigh - pucPage) + xPageSize - 1) / xPageSize;
+        if (xPages > portSTACK_SCAN_PAGES) {
+            xPages = portSTACK_SCAN_PAGES;
+        }
+        if (0 != mincore(pucPage, xPages * xPageSize, ucResident)) {
+            memset(ucResident, 1, xPages);
+        }
+
+        for (x = 0; x < xPages; x++, pucPage += xPageSize) {
+            if (0 == (ucResident[x] & 1)) {
+                continue;
+            }
+            pucByte = (pucPage < pucLow) ? pucLow : pucPage;
+            pucEnd = (pucPage + xPageSize < pucHigh) ? pucPage + xPageSize
+                     : pucHigh;
+            for (; pucByte < pucEnd; pucByte++) {
+                if (0 != *pucByte) {
+                    return pucByte;
+                }
+            }
+        }
+    }
+
+    return pucHigh;
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+unsigned portBASE_TYPE uxPortGetStackHighWaterMark(portSTACK_TYPE *pxTopOfStack)
+{
+    xTaskContext *pxContext = (xTaskContext *)pxTopOfStack;
+    unsigned char *pucStack;
+    size_t xUsed;
+
+    if (NULL == pxContext) {
+        return 0;
+    }
+
+    /* The stack runs from above the guard page up to the context. */
+    pucStack = (unsigned char *)pxContext->pvMapping +
+               (size_t)sysconf(_SC_PAGESIZE);
+    xUsed = (size_t)((unsigned char *)pxContext -
+                     prvFindStackPeak(pucStack, (unsigned char *)pxContext));
+    xUsed = (xUsed + sizeof(portSTACK_TYPE) * configHOST_STACK_SCALE - 1) /
+            (sizeof(portSTACK_TYPE) * configHOST_STACK_SCALE);
+
+    return (xUsed < pxContext->uxStackDepth) ? pxContext->uxStackDepth - xUsed
+           : 0;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the state of the core the calling thread is, which is looked up
+ * anew on every call as a task may continue on another core after a switch.
+ */
+portNO_PREEMPT
+xCoreState *prvGetCore(void)
+{
+    xCoreState *pxCore = pxThisCore;
+
+    __asm__ volatile("" ::: "memory");
+    return (NULL != pxCore) ? pxCore : &xHostThread;
+}
+/*-----------------------------------------------------------*/
+
+#if (configNUMBER_OF_CORES > 1)
+static void *prvCoreThread(void *pvCore);
+
+/*
+ * Takes the kernel lock, called with the thread's interrupts disabled.
+ * Returns pdTRUE if the lock was free, pdFALSE if the thread already held it.
+ */
+portNO_PREEMPT
+portBASE_TYPE prvGetKernelLock(xCoreState *pxCore)
+{
+    int iState = 0;
+    int iSpin;
+
+    if (pxKernelLockOwner == pxCore) {
+        uxKernelLockCount++;
+        return pdFALSE;
+    }
+
+    /* The lock is mostly held briefly, so spin a little before sleeping on
+     * the futex. */
+    for (iSpin = 0; iSpin < 100; iSpin++) {
+        iState = 0;
+        if (__atomic_compare_exchange_n(&iKernelLock, &iState, 1, pdFALSE,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            break;
+        }
+        CPU_RELAX();
+    }
+
+    if (0 != iState) {
+        if (2 != iState) {
+            iState = __atomic_exchange_n(&iKernelLock, 2, __ATOMIC_ACQUIRE);
+        }
+        while (0 != iState) {
+            (void)syscall(SYS_futex, &iKernelLock, FUTEX_WAIT_PRIVATE, 2,
+                          NULL, NULL, 0);
+            iState = __atomic_exchange_n(&iKernelLock, 2, __ATOMIC_ACQUIRE);
+        }
+    }
+
+    pxKernelLockOwner = pxCore;
+    uxKernelLockCount = 1;
+
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void prvReleaseKernelLock(xCoreState *pxCore)
+{
+    (void)pxCore;
+
+    if (0 == --uxKernelLockCount) {
+        pxKernelLockOwner = NULL;
+        if (2 == __atomic_exchange_n(&iKernelLock, 0, __ATOMIC_RELEASE)) {
+            (void)syscall(SYS_futex, &iKernelLock, FUTEX_WAKE_PRIVATE, 1,
+                          NULL, NULL, 0);
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+#else
+/* With a single core only the scheduler's thread runs tasks, disabling its
+ * interrupts is all the locking there is. */
+portNO_PREEMPT
+portBASE_TYPE prvGetKernelLock(xCoreState *pxCore)
+{
+    (void)pxCore;
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void prvReleaseKernelLock(xCoreState *pxCore)
+{
+    (void)pxCore;
+}
+/*-----------------------------------------------------------*/
+#endif /* configNUMBER_OF_CORES */
+
+/*
+ * Takes the kernel lock with the thread's interrupts disabled. If xMayYield
+ * is set, a switch still pending for the core, for instance because another
+ * core deleted or suspended the running task, is taken first as an interrupt
+ * would have been. Returns the core the calling task is on afterwards.
+ */
+portNO_PREEMPT
+xCoreState *prvEnterKernel(xCoreState *pxCore, portBASE_TYPE xMayYield)
+{
+    while ((pdTRUE == prvGetKernelLock(pxCore)) && (pdFALSE != xMayYield) &&
+           (pdTRUE == pxCore->xPendYield) && (pdTRUE == pxCore->xRunning)) {
+        prvReleaseKernelLock(pxCore);
+        prvSwitchTasks();
+        pxCore = prvGetCore();
+    }
+
+    return pxCore;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns pdTRUE if the core has something to service once its interrupts
+ * are enabled.
+ */
+portNO_PREEMPT
+portBASE_TYPE prvInterruptsPending(xCoreState *pxCore)
+{
+    return ((pdTRUE == pxCore->xPendYield) ||
+            ((pxCore == &xCores[0]) && (0 != uxTicksToService)) ||
+            ((pxCore == &xCores[0]) && (0 != ulPendingInterrupts)) ||
+            ((pdTRUE == xSchedulerEnd) && (pdTRUE == pxCore->xRunning)))
+           ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the thread's errno, which also moves when a task continues on
+ * another core.
+ */
+portNO_PREEMPT
+int *prvGetErrno(void)
+{
+    __asm__ volatile("" ::: "memory");
+    return &errno;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * First function run on a task's stack, switched to with interrupts disabled
+ * and the kernel lock held.
+ */
+portNO_PREEMPT
+void prvTaskStart(void)
+{
+    xTaskContext *pxContext = prvGetTaskContext(xTaskGetCurrentTaskHandle());
+
+    prvReleaseKernelLock(prvGetCore());
+    prvRestoreInterrupts();
+    pxContext->pxCode(pxContext->pvParams);
+
+    /* Tasks must not return, end it like a task deleting itself. */
+    vTaskDelete(NULL);
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void prvSwitchContext(xTaskContext *pxFrom, xTaskContext *pxTo)
+{
+#if (portSWITCH_STACKS == 1)
+    prvSwitchStacks(&pxFrom->pvStackPointer, pxTo->pvStackPointer);
+#else
+    (void)swapcontext(&pxFrom->xContext, &pxTo->xContext);
+#endif
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Switches to the task the kernel selects, called with interrupts disabled
+ * outside of any critical section. Returns once the calling task is switched
+ * back in, possibly on another core.
+ */
+portNO_PREEMPT
+void prvSwitchTasks(void)
+{
+    xCoreState *pxCore = prvGetCore();
+    xTaskContext *pxTaskToSuspend;
+    xTaskContext *pxTaskToResume;
+
+    (void)prvGetKernelLock(pxCore);
+
+    pxTaskToSuspend = prvGetTaskContext(xTaskGetCurrentTaskHandle());
+    pxCore->xPendYield = pdFALSE;
+
+    vTaskSwitchContext();
+
+    pxTaskToResume = prvGetTaskContext(xTaskGetCurrentTaskHandle());
+    if (pxTaskToSuspend != pxTaskToResume) {
+        /* The task resumed releases the lock, so that no other core resumes
+         * the suspended task before its context is saved. */
+        prvSwitchContext(pxTaskToSuspend, pxTaskToResume);
+    }
+
+    prvReleaseKernelLock(prvGetCore());
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Sets the interrupts from the core's critical nesting and services whatever
+ * has been pended while they were disabled.
+ */
+portNO_PREEMPT
+void prvRestoreInterrupts(void)
+{
+    xCoreState *pxCore = prvGetCore();
+
+    if (pxCore->uxCriticalNesting == 0) {
+        pxCore->xInterruptsEnabled = pdTRUE;
+        if (pdTRUE == prvInterruptsPending(pxCore)) {
+            prvServiceInterrupts();
+        }
+    }
+    else {
+        pxCore->xInterruptsEnabled = pdFALSE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Passes the pending ticks to the kernel, runs the handlers of the pending
+ * simulated interrupts and switches task if required, called with interrupts
+ * enabled outside of any critical section.
+ */
+portNO_PREEMPT
+void prvServiceInterrupts(void)
+{
+    xCoreState *pxCore = prvGetCore();
+    unsigned portBASE_TYPE uxTicks = 0;
+    portBASE_TYPE xSwitchRequired;
+
+    do {
+        pxCore->xInterruptsEnabled = pdFALSE;
+
+        /* A task holding the task lock leaves once it releases it. */
+        if ((pdTRUE == xSchedulerEnd) && (pdTRUE == pxCore->xRunning) &&
+            (pdTRUE == prvGetKernelLock(pxCore))) {
+            prvReleaseKernelLock(pxCore);
+            prvLeaveScheduler(pxCore);
+        }
+
+        xSwitchRequired = pdFALSE;
+        if (pxCore == &xCores[0]) {
+            uxTicks = __atomic_exchange_n(&uxTicksToService, 0,
+                                          __ATOMIC_ACQUIRE);
+        }
+        if (uxTicks > 0) {
+            (void)prvGetKernelLock(pxCore);
+            while (uxTicks-- > 0) {
+                if (pdFALSE != xTaskIncrementTick()) {
+                    xSwitchRequired = pdTRUE;
+                }
+            }
+            prvReleaseKernelLock(pxCore);
+            uxTicks = 0;
+        }
+        if ((pxCore == &xCores[0]) &&
+            (pdFALSE != prvRunInterruptHandlers())) {
+            xSwitchRequired = pdTRUE;
+        }
+
+        /* Also a portYIELD_FROM_ISR() of the handlers. */
+        if (pdTRUE == pxCore->xPendYield) {
+            xSwitchRequired = pdTRUE;
+        }
+        pxCore->xPendYield = pdFALSE;
+
+#if (configUSE_PREEMPTION == 1)
+        if (pdFALSE != xSwitchRequired) {
+            prvSwitchTasks();
+            pxCore = prvGetCore();
+        }
+#else
+        (void)xSwitchRequired;
+#endif
+
+        pxCore->xInterruptsEnabled = pdTRUE;
+    } while (pdTRUE == prvInterruptsPending(pxCore));
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Runs the handlers of the simulated interrupts pending, called by core 0
+ * with interrupts disabled. Returns pdTRUE if a handler requires a switch.
+ */
+portNO_PREEMPT
+portBASE_TYPE prvRunInterruptHandlers(void)
+{
+    uint32_t ulPending = __atomic_exchange_n(&ulPendingInterrupts, 0,
+                                             __ATOMIC_ACQUIRE);
+    uint32_t (*pvHandler)(void);
+    portBASE_TYPE xSwitchRequired = pdFALSE;
+    int iInterrupt;
+
+    /* Lower numbers first, as with a prioritised interrupt controller. */
+    while (0 != ulPending) {
+        iInterrupt = __builtin_ctz(ulPending);
+        ulPending &= ulPending - 1;
+        pvHandler = __atomic_load_n(&pvInterruptHandlers[iInterrupt],
+                                    __ATOMIC_ACQUIRE);
+        if ((NULL != pvHandler) && (0 != pvHandler())) {
+            xSwitchRequired = pdTRUE;
+        }
+    }
+
+    return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Leaves the running task for good once the scheduler has ended, called with
+ * interrupts disabled.
+ */
+portNO_PREEMPT
+void prvLeaveScheduler(xCoreState *pxCore)
+{
+    pxCore->xRunning = pdFALSE;
+    prvSwitchContext(prvGetTaskContext(xTaskGetCurrentTaskHandle()),
+                     &pxCore->xSchedulerContext);
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortStartFirstTask(void)
+{
+    xCoreState *pxCore = prvGetCore();
+
+    /* The first task releases the lock once it runs. */
+    pxCore->uxCriticalNesting = 0;
+    pxCore->xInterruptsEnabled = pdFALSE;
+    (void)prvGetKernelLock(pxCore);
+    pxCore->xRunning = pdTRUE;
+
+    prvSwitchContext(&pxCore->xSchedulerContext,
+                     prvGetTaskContext(xTaskGetCurrentTaskHandle()));
+}
+/*-----------------------------------------------------------*/
+
+#if (configNUMBER_OF_CORES > 1)
+/*
+ * Host thread of the cores other than core 0, runs tasks until the scheduler
+ * ends.
+ */
+portNO_PREEMPT
+void *prvCoreThread(void *pvCore)
+{
+    pxThisCore = (xCoreState *)pvCore;
+
+    /* Tasks only run once every core's thread is known. */
+    (void)pthread_barrier_wait(&xCoresStarted);
+    vPortStartFirstTask();
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+#endif /* configNUMBER_OF_CORES */
+
+/*
+ * See header file for description.
+ */
+portNO_PREEMPT
+portBASE_TYPE xPortStartScheduler(void)
+{
+    struct sigaction xAction;
+    struct sigevent xEvent;
+    portBASE_TYPE xCoreID;
+
+    for (xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++) {
+        xCores[xCoreID].xInterruptsEnabled = pdFALSE;
+        xCores[xCoreID].xCoreID = xCoreID;
+    }
+    xCores[0].hThread = pthread_self();
+    pxThisCore = &xCores[0];
+
+    /* Restart system calls the interrupts where possible. The handler may
+     * switch task, so no other interrupt is blocked while it runs. */
+    memset(&xAction, 0, sizeof(xAction));
+    xAction.sa_flags = SA_RESTART | SA_SIGINFO;
+    xAction.sa_sigaction = prvInterruptHandler;
+    sigemptyset(&xAction.sa_mask);
+    if ((0 != sigaction(SIG_TICK, &xAction, NULL)) ||
+        (0 != sigaction(SIG_YIELD, &xAction, NULL))) {
+        printf("Problem installing the interrupt handler\n");
+    }
+
+    /* Only core 0 receives the tick, the other host threads run no tasks or
+     * are interrupted by core 0 when the tick requires it. */
+    memset(&xEvent, 0, sizeof(xEvent));
+    xEvent.sigev_notify = SIGEV_THREAD_ID;
+    xEvent.sigev_signo = SIG_TICK;
+    xEvent.sigev_notify_thread_id = (pid_t)syscall(SYS_gettid);
+    if (0 != timer_create(CLOCK_MONOTONIC, &xEvent, &hTickTimer)) {
+        printf("Tick timer problem.\n");
+        pxThisCore = NULL;
+        return 0;
+    }
+
+#if (configNUMBER_OF_CORES > 1)
+    (void)pthread_barrier_init(&xCoresStarted, NULL, configNUMBER_OF_CORES);
+    for (xCoreID = 1; xCoreID < configNUMBER_OF_CORES; xCoreID++) {
+        if (0 != pthread_create(&xCores[xCoreID].hThread, NULL, prvCoreThread,
+                                &xCores[xCoreID])) {
+            printf("Problem creating the thread of core %ld\n", xCoreID);
+            exit(EXIT_FAILURE);
+        }
+    }
+#endif
+
+    xSchedulerStarted = pdTRUE;
+
+#if (configNUMBER_OF_CORES > 1)
+    (void)pthread_barrier_wait(&xCoresStarted);
+#endif
+
+    printf("Running as PID: %d\n", getpid());
+
+    vPortResetTickStats();
+    prvArmTickTimer(TICK_PERIOD_NS);
+
+    /* Start the first task. Returns here once the scheduler has ended. */
+    vPortStartFirstTask();
+
+#if (configNUMBER_OF_CORES > 1)
+    for (xCoreID = 1; xCoreID < configNUMBER_OF_CORES; xCoreID++) {
+        (void)pthread_join(xCores[xCoreID].hThread, NULL);
+    }
+    (void)pthread_barrier_destroy(&xCoresStarted);
+#endif
+
+    pxThisCore = NULL;
+    (void)timer_delete(hTickTimer);
+    printf("Cleaning Up, Exiting.\n");
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortEndScheduler(void)
+{
+    xCoreState *pxCore = prvGetCore();
+    struct itimerspec xStop;
+#if (configNUMBER_OF_CORES > 1)
+    portBASE_TYPE xCoreID;
+#endif
+
+    memset(&xStop, 0, sizeof(xStop));
+    (void)timer_settime(hTickTimer, 0, &xStop, NULL);
+
+    /* The stacks of the tasks are left to the host to reclaim. Every other
+     * core leaves the scheduler once it next takes an interrupt. */
+    xSchedulerEnd = pdTRUE;
+#if (configNUMBER_OF_CORES > 1)
+    for (xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++) {
+        if (&xCores[xCoreID] != pxCore) {
+            (void)pthread_kill(xCores[xCoreID].hThread, SIG_YIELD);
+        }
+    }
+#endif
+
+    prvLeaveScheduler(pxCore);
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortYieldFromISR(void)
+{
+    xCoreState *pxCore = prvGetCore();
+
+    /* Another host thread interrupts core 0 like a peripheral would. Within
+     * a core the yield happens once interrupts are enabled. */
+    if (pxCore->xCoreID < 0) {
+        if (pdTRUE == xSchedulerStarted) {
+            vPortYieldCore(0);
+        }
+    }
+    else {
+        pxCore->xPendYield = pdTRUE;
+        if ((pdTRUE == pxCore->xInterruptsEnabled) &&
+            (pxCore->uxCriticalNesting == 0)) {
+            prvServiceInterrupts();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortSetInterruptHandler(uint32_t ulInterruptNumber,
+                              uint32_t (*pvHandler)(void))
+{
+    if (ulInterruptNumber < portMAX_INTERRUPTS) {
+        __atomic_store_n(&pvInterruptHandlers[ulInterruptNumber], pvHandler,
+                         __ATOMIC_RELEASE);
+    }
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortGenerateSimulatedInterrupt(uint32_t ulInterruptNumber)
+{
+    xCoreState *pxCore = prvGetCore();
+    uint32_t ulBit;
+
+    if (ulInterruptNumber >= portMAX_INTERRUPTS) {
+        return;
+    }
+
+    /* Whoever set the bit has already interrupted core 0. */
+    ulBit = (uint32_t)1 << ulInterruptNumber;
+    if (0 != (__atomic_fetch_or(&ulPendingInterrupts, ulBit,
+                                __ATOMIC_RELEASE) & ulBit)) {
+        return;
+    }
+
+    if (pxCore == &xCores[0]) {
+        if ((pdTRUE == pxCore->xInterruptsEnabled) &&
+            (pxCore->uxCriticalNesting == 0)) {
+            prvServiceInterrupts();
+        }
+    }
+    else if ((pdTRUE == xSchedulerStarted) && (pdTRUE != xSchedulerEnd)) {
+        (void)pthread_kill(xCores[0].hThread, SIG_YIELD);
+    }
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortYieldCore(portBASE_TYPE xCoreID)
+{
+    xCoreState *pxCore = &xCores[xCoreID];
+
+    pxCore->xPendYield = pdTRUE;
+    if ((pxCore != prvGetCore()) && (pdTRUE == xSchedulerStarted) &&
+        (pdTRUE != xSchedulerEnd)) {
+        (void)pthread_kill(pxCore->hThread, SIG_YIELD);
+    }
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortYield(void)
+{
+    xCoreState *pxCore = prvGetCore();
+
+    /* Within a critical section the switch happens once it is left. */
+    if ((pdTRUE != pxCore->xInterruptsEnabled) ||
+        (pxCore->uxCriticalNesting != 0)) {
+        pxCore->xPendYield = pdTRUE;
+        return;
+    }
+
+    pxCore->xInterruptsEnabled = pdFALSE;
+    prvSwitchTasks();
+    prvRestoreInterrupts();
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+portBASE_TYPE xPortGetCoreID(void)
+{
+    xCoreState *pxCore = prvGetCore();
+
+    /* Other host threads act as interrupts of core 0. */
+    return (pxCore->xCoreID < 0) ? 0 : pxCore->xCoreID;
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortEnterCritical(void)
+{
+    xCoreState *pxCore = prvGetCore();
+    portBASE_TYPE xMayYield = ((pdTRUE == pxCore->xInterruptsEnabled) &&
+                               (pxCore->uxCriticalNesting == 0)) ? pdTRUE
+                                                                 : pdFALSE;
+
+    pxCore->xInterruptsEnabled = pdFALSE;
+    pxCore = prvEnterKernel(pxCore, xMayYield);
+    pxCore->uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortExitCritical(void)
+{
+    xCoreState *pxCore = prvGetCore();
+
+    /* Check for unmatched exits. */
+    if (pxCore->uxCriticalNesting > 0) {
+        pxCore->uxCriticalNesting--;
+        prvReleaseKernelLock(pxCore);
+    }
+
+    /* If we have reached 0 then re-enable the interrupts, which also
+     * services any tick or yield pended in the meantime. */
+    if (pxCore->uxCriticalNesting == 0) {
+        prvRestoreInterrupts();
+    }
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortGetTaskLock(void)
+{
+    xCoreState *pxCore = prvGetCore();
+
+    /* Called with interrupts masked by vTaskSuspendAll(). */
+    (void)prvEnterKernel(pxCore, (pxCore->uxCriticalNesting == 0) ? pdTRUE
+                                                                   : pdFALSE);
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortReleaseTaskLock(void)
+{
+    prvReleaseKernelLock(prvGetCore());
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortDisableInterrupts(void)
+{
+    prvGetCore()->xInterruptsEnabled = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortEnableInterrupts(void)
+{
+    prvGetCore()->xInterruptsEnabled = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+portBASE_TYPE xPortSetCoreInterruptMask(void)
+{
+    xCoreState *pxCore = prvGetCore();
+    portBASE_TYPE xReturn = pxCore->xInterruptsEnabled;
+
+    pxCore->xInterruptsEnabled = pdFALSE;
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortClearCoreInterruptMask(portBASE_TYPE xMask)
+{
+    if (pdFALSE != xMask) {
+        prvRestoreInterrupts();
+    }
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+portBASE_TYPE xPortSetInterruptMask(void)
+{
+    xCoreState *pxCore = prvGetCore();
+    portBASE_TYPE xReturn = pxCore->xInterruptsEnabled;
+
+    pxCore->xInterruptsEnabled = pdFALSE;
+    (void)prvGetKernelLock(pxCore);
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortClearInterruptMask(portBASE_TYPE xMask)
+{
+    prvReleaseKernelLock(prvGetCore());
+    if (pdFALSE != xMask) {
+        prvRestoreInterrupts();
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if (configNUMBER_OF_CORES > 1)
+portNO_PREEMPT
+void vPortWaitForInterrupt(void)
+{
+    xCoreState *pxCore = prvGetCore();
+    sigset_t xSignals, xWaitSignals;
+
+    /* Interrupts are held off until the core is awake, but still wake it. */
+    pxCore->xInterruptsEnabled = pdFALSE;
+    sigemptyset(&xSignals);
+    sigaddset(&xSignals, SIG_TICK);
+    sigaddset(&xSignals, SIG_YIELD);
+    (void)pthread_sigmask(SIG_BLOCK, &xSignals, &xWaitSignals);
+    sigdelset(&xWaitSignals, SIG_TICK);
+    sigdelset(&xWaitSignals, SIG_YIELD);
+
+    if (pdTRUE != prvInterruptsPending(pxCore)) {
+        (void)sigsuspend(&xWaitSignals);
+    }
+
+    (void)pthread_sigmask(SIG_UNBLOCK, &xSignals, NULL);
+    prvRestoreInterrupts();
+}
+/*-----------------------------------------------------------*/
+#endif /* configNUMBER_OF_CORES */
+
+/*
+ * Returns pdTRUE if the signal interrupted the executable's own code, rather
+ * than a host library or the port.
+ */
+portNO_PREEMPT
+portBASE_TYPE prvInterruptedTaskCode(void *pvContext)
+{
+    ucontext_t *pxContext = (ucontext_t *)pvContext;
+    uintptr_t uxPC;
+
+#if defined(__x86_64__)
+    uxPC = (uintptr_t)pxContext->uc_mcontext.gregs[REG_RIP];
+#elif defined(__aarch64__)
+    uxPC = (uintptr_t)pxContext->uc_mcontext.pc;
+#else
+    /* Unknown where the program counter is kept, assume it is safe. */
+    (void)pxContext;
+    return pdTRUE;
+#endif
+
+    if ((uxPC >= (uintptr_t)__start_freertos_port_text) &&
+        (uxPC < (uintptr_t)__stop_freertos_port_text)) {
+        return pdFALSE;
+    }
+
+    return ((uxPC >= (uintptr_t)__executable_start) &&
+            (uxPC < (uintptr_t)etext)) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void prvInterruptHandler(int iSignal, siginfo_t *pxInfo, void *pvContext)
+{
+    xCoreState *pxCore = prvGetCore();
+    int iErrno = *prvGetErrno();
+    struct timespec xNow;
+    long long llLatenessNs;
+    unsigned long ulMissed;
+    sigset_t xSignals;
+
+    if (SIG_TICK == iSignal) {
+        clock_gettime(CLOCK_MONOTONIC, &xNow);
+        ulMissed = (pxInfo->si_overrun > 0) ? pxInfo->si_overrun : 0;
+        llLatenessNs = (xNow.tv_sec - xNextTick.tv_sec) * 1000000000LL +
+                       (xNow.tv_nsec - xNextTick.tv_nsec) -
+                       (long long)ulMissed * TICK_PERIOD_NS;
+        prvTimespecAdd(&xNextTick, (1 + ulMissed) * TICK_PERIOD_NS);
+        prvRecordTick((llLatenessNs > 0) ? llLatenessNs : 0, ulMissed);
+
+        __atomic_add_fetch(&uxTicksToService, 1 + ulMissed, __ATOMIC_RELEASE);
+    }
+    /* Whoever sends SIG_YIELD has pended what the core is to service. */
+
+    if ((pdTRUE == pxCore->xInterruptsEnabled) &&
+        (pdTRUE == pxCore->xRunning) &&
+        (pdTRUE == prvInterruptedTaskCode(pvContext))) {
+        /* A task switched to from here may itself be interrupted, its
+         * handler returns once this task is switched back in. */
+        sigemptyset(&xSignals);
+        sigaddset(&xSignals, SIG_TICK);
+        sigaddset(&xSignals, SIG_YIELD);
+        (void)pthread_sigmask(SIG_UNBLOCK, &xSignals, NULL);
+
+        prvServiceInterrupts();
+    }
+
+    /* The task interrupted may have been switched back in on another core. */
+    *prvGetErrno() = iErrno;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Starts the periodic tick with the first tick llFirstNs from now.
+ */
+portNO_PREEMPT
+void prvArmTickTimer(long long llFirstNs)
+{
+    struct itimerspec xTimer;
+
+    xTimer.it_interval.tv_sec = TICK_PERIOD_NS / 1000000000LL;
+    xTimer.it_interval.tv_nsec = TICK_PERIOD_NS % 1000000000LL;
+    xTimer.it_value.tv_sec = llFirstNs / 1000000000LL;
+    xTimer.it_value.tv_nsec = llFirstNs % 1000000000LL;
+
+    clock_gettime(CLOCK_MONOTONIC, &xNextTick);
+    prvTimespecAdd(&xNextTick, llFirstNs);
+    if (0 != timer_settime(hTickTimer, 0, &xTimer, NULL)) {
+        printf("Set Timer problem.\n");
+    }
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void prvTimespecAdd(struct timespec *pxTime, long long llNs)
+{
+    llNs += pxTime->tv_nsec;
+    pxTime->tv_sec += llNs / 1000000000LL;
+    pxTime->tv_nsec = llNs % 1000000000LL;
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void prvRecordTick(long long llLatenessNs, unsigned long ulMissed)
+{
+    unsigned long ulLatenessUs = llLatenessNs / 1000;
+    int iBucket = 0;
+
+    while ((ulLatenessUs > 0) && (iBucket < portTICK_JITTER_BUCKETS - 1)) {
+        ulLatenessUs >>= 1;
+        iBucket++;
+    }
+
+    xTickStats.ulTicks += 1 + ulMissed;
+    xTickStats.ulMissedTicks += ulMissed;
+    xTickStats.ulJitterHistogram[iBucket]++;
+    if ((unsigned long)llLatenessNs > xTickStats.ulMaxLatenessNs) {
+        xTickStats.ulMaxLatenessNs = (unsigned long)llLatenessNs;
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if (configUSE_TICKLESS_IDLE == 1)
+portNO_PREEMPT
+void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime)
+{
+    TickType_t xModifiableIdleTime = xExpectedIdleTime;
+    TickType_t xSlept = 0;
+    TickType_t xStep;
+    unsigned portBASE_TYPE uxTicks;
+    eSleepModeStatus eSleepStatus;
+    sigset_t xSignals, xSleepSignals;
+    struct itimerspec xTimer;
+    struct timespec xStart, xNow, xNoWait = { 0, 0 };
+    long long llToTickNs, llElapsedNs;
+    unsigned long ulTicksBefore;
+
+    /* Interrupts are held off until the end of the idle period, but still
+     * wake the thread. */
+    sigemptyset(&xSignals);
+    sigaddset(&xSignals, SIG_TICK);
+    sigaddset(&xSignals, SIG_YIELD);
+    (void)pthread_sigmask(SIG_BLOCK, &xSignals, &xSleepSignals);
+    sigdelset(&xSleepSignals, SIG_TICK);
+    sigdelset(&xSleepSignals, SIG_YIELD);
+
+    vPortEnterCritical();
+
+    eSleepStatus = eTaskConfirmSleepModeStatus();
+    if ((eAbortSleep == eSleepStatus) || (pdTRUE == xCores[0].xPendYield) ||
+        (0 != ulPendingInterrupts)) {
+        vPortExitCritical();
+        (void)pthread_sigmask(SIG_UNBLOCK, &xSignals, NULL);
+        return;
+    }
+
+    configPRE_SLEEP_PROCESSING(xModifiableIdleTime);
+
+    /* Ticks raised before the idle period. */
+    uxTicks = __atomic_exchange_n(&uxTicksToService, 0, __ATOMIC_ACQUIRE);
+
+#if (configUSE_VIRTUAL_TIME == 1)
+    /* Nothing can run before the next task unblocks, so time jumps straight
+     * there. Without a timeout to wait for, sleep until woken from outside. */
+    if (eStandardSleep == eSleepStatus) {
+        xSlept = xModifiableIdleTime;
+        xModifiableIdleTime = 0;
+    }
+#endif
+
+    if (xModifiableIdleTime > 0) {
+        /* Stretch the wait for the next tick over the idle period. */
+        (void)timer_gettime(hTickTimer, &xTimer);
+        clock_gettime(CLOCK_MONOTONIC, &xStart);
+        llToTickNs = xTimer.it_value.tv_sec * 1000000000LL +
+                     xTimer.it_value.tv_nsec;
+        prvTimespecAdd(&xTimer.it_value,
+                       (long long)(xModifiableIdleTime - 1) * TICK_PERIOD_NS);
+        (void)timer_settime(hTickTimer, 0, &xTimer, NULL);
+        ulTicksBefore = xTickStats.ulTicks;
+
+        (void)sigsuspend(&xSleepSignals);
+
+        /* Stop the timer so that every tick period that passed is counted
+         * below and not also by a pending signal. */
+        memset(&xTimer, 0, sizeof(xTimer));
+        (void)timer_settime(hTickTimer, 0, &xTimer, NULL);
+        clock_gettime(CLOCK_MONOTONIC, &xNow);
+        sigemptyset(&xSignals);
+        sigaddset(&xSignals, SIG_TICK);
+        while (SIG_TICK == sigtimedwait(&xSignals, NULL, &xNoWait)) {
+        }
+        (void)__atomic_exchange_n(&uxTicksToService, 0, __ATOMIC_ACQUIRE);
+
+        llElapsedNs = (xNow.tv_sec - xStart.tv_sec) * 1000000000LL +
+                      (xNow.tv_nsec - xStart.tv_nsec);
+        if (llElapsedNs >= llToTickNs) {
+            xSlept = (llElapsedNs - llToTickNs) / TICK_PERIOD_NS + 1;
+        }
+        xTickStats.ulTicks = ulTicksBefore + xSlept;
+
+        /* Carry on with the tick where it would have been. */
+        prvArmTickTimer(llToTickNs + (long long)xSlept * TICK_PERIOD_NS -
+                        llElapsedNs);
+    }
+
+    configPOST_SLEEP_PROCESSING(xExpectedIdleTime);
+
+    while (uxTicks-- > 0) {
+        xTaskIncrementTick();
+    }
+
+    /* The tick count may only be stepped up to the tick before the next
+     * unblock time, any further ticks are pended like any other tick. */
+    xStep = (xSlept < xExpectedIdleTime) ? xSlept : xExpectedIdleTime - 1;
+    vTaskStepTick(xStep);
+    while (xSlept-- > xStep) {
+        xTaskIncrementTick();
+    }
+
+    vPortExitCritical();
+
+    /* A simulated interrupt that woke the thread is taken now. */
+    sigemptyset(&xSignals);
+    sigaddset(&xSignals, SIG_TICK);
+    sigaddset(&xSignals, SIG_YIELD);
+    (void)pthread_sigmask(SIG_UNBLOCK, &xSignals, NULL);
+}
+/*-----------------------------------------------------------*/
+#endif /* configUSE_TICKLESS_IDLE */
+
+portNO_PREEMPT
+void vPortGetTickStats(xPortTickStats *pxStats)
+{
+    portBASE_TYPE xMask = xPortSetInterruptMask();
+
+    *pxStats = xTickStats;
+    vPortClearInterruptMask(xMask);
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortResetTickStats(void)
+{
+    portBASE_TYPE xMask = xPortSetInterruptMask();
+
+    memset(&xTickStats, 0, sizeof(xTickStats));
+    vPortClearInterruptMask(xMask);
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortCleanUpTCB(void *pxTCB)
+{
+    xTaskContext *pxContext = prvGetTaskContext(pxTCB);
+
+    /* Never the running task, a task that deleted itself is cleaned up by
+     * the idle task. */
+    if (NULL != pxContext) {
+        (void)munmap(pxContext->pvMapping, pxContext->xMappingSize);
+    }
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+void vPortFindTicksPerSecond(void)
+{
+    struct timespec xResolution;
+
+    /* Count from the start of the scheduler. */
+    clock_gettime(CLOCK_MONOTONIC, &xRunTimeStart);
+
+    if (0 == clock_getres(CLOCK_MONOTONIC, &xResolution)) {
+        printf("Timer Resolution for Run TimeStats is %ld ns.\n",
+               xResolution.tv_sec * 1000000000L + xResolution.tv_nsec);
+    }
+}
+/*-----------------------------------------------------------*/
+
+portNO_PREEMPT
+configRUN_TIME_COUNTER_TYPE ulPortGetTimerValue(void)
+{
+    struct timespec xNow;
+
+    /* Only one task runs at a time on a core, so the monotonic time between
+     * two context switches of a core is the time the switched out task has
+     * been running. */
+    clock_gettime(CLOCK_MONOTONIC, &xNow);
+    return (configRUN_TIME_COUNTER_TYPE)(xNow.tv_sec - xRunTimeStart.tv_sec) *
+           1000000000ULL + xNow.tv_nsec - xRunTimeStart.tv_nsec;
+}
+/*-----------------------------------------------------------*/
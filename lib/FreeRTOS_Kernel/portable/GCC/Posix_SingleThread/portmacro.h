@@ -0,0 +1,315 @@
+/*
+    FreeRTOS.org V5.2.0 - Copyright (C) 2003-2009 Richard Barry.
+
+    This file is part of the FreeRTOS.org distribution.
+
+    FreeRTOS.org is free software; you can redistribute it and/or modify it
+    under the terms of the GNU General Public License (version 2) as published
+    by the Free Software Foundation and modified by the FreeRTOS exception.
+
+    FreeRTOS.org is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+    more details.
+
+    You should have received a copy of the GNU General Public License along
+    with FreeRTOS.org; if not, write to the Free Software Foundation, Inc., 59
+    Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+    A special exception to the GPL is included to allow you to distribute a
+    combined work that includes FreeRTOS.org without being obliged to provide
+    the source code for any proprietary components.  See the licensing section
+    of http://www.FreeRTOS.org for full details.
+
+
+    ***************************************************************************
+    *                                                                         *
+    * Get the FreeRTOS eBook!  See http://www.FreeRTOS.org/Documentation      *
+    *                                                                         *
+    * This is a concise, step by step, 'hands on' guide that describes both   *
+    * general multitasking concepts and FreeRTOS specifics. It presents and   *
+    * explains numerous examples that are written using the FreeRTOS API.     *
+    * Full source code for all the examples is provided in an accompanying    *
+    * .zip file.                                                              *
+    *                                                                         *
+    ***************************************************************************
+
+    1 tab == 4 spaces!
+
+    Please ensure to read the configuration and relevant port sections of the
+    online documentation.
+
+    http://www.FreeRTOS.org - Documentation, latest information, license and
+    contact details.
+
+    http://www.SafeRTOS.com - A version that is certified for use in safety
+    critical systems.
+
+    http://www.OpenRTOS.com - Commercial support, development, porting,
+    licensing and training services.
+*/
+
+
+/*
+ * Single host thread variant of the Posix port. All tasks share the thread
+ * that starts the scheduler, each on its own stack, and are switched in user
+ * space.
+ * */
+
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the
+ * given hardware and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. Legacy*/
+#define portCHAR        char
+#define portFLOAT       float
+#define portDOUBLE      double
+#define portLONG        int
+#define portSHORT       short
+#define portSTACK_TYPE uint32_t
+#define portBASE_TYPE   long
+
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+typedef uint16_t TickType_t;
+#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+typedef uint32_t TickType_t;
+#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+/* 32-bit tick type on a 32-bit architecture, so reads of the tick count do
+not need to be guarded with a critical section. */
+#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH                ( -1 )
+#define portTICK_PERIOD_MS              ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portTICK_PERIOD_MICROSECONDS        ( ( TickType_t ) 1000000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT              4
+#define portPOINTER_SIZE_TYPE           uintptr_t
+#define portREMOVE_STATIC_QUALIFIER
+/*-----------------------------------------------------------*/
+
+
+
+
+/* Scheduler utilities. */
+extern void vPortYieldFromISR(void);
+extern void vPortYield(void);
+
+#define portYIELD()                 vPortYield()
+
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired ) vPortYieldFromISR()
+#define portYIELD_FROM_ISR( xSwitchRequired ) portEND_SWITCHING_ISR( xSwitchRequired )
+/*-----------------------------------------------------------*/
+
+/* Simulated interrupts. Host threads that are not tasks, such as those that
+run AsyncIO callbacks, must not call the kernel themselves but raise an
+interrupt, whose handler core 0 then runs like an interrupt service routine:
+at once if it raised the interrupt itself, otherwise when it is interrupted or
+leaves a critical section. Handlers may use the _FROM_ISR() API and return
+non-zero, or call portYIELD_FROM_ISR(), to switch task. Raising an interrupt
+that is still pending has no further effect, lower numbers are serviced first.
+*/
+#define portMAX_INTERRUPTS          ( ( uint32_t ) 32 )
+
+extern void vPortGenerateSimulatedInterrupt(uint32_t ulInterruptNumber);
+extern void vPortSetInterruptHandler(uint32_t ulInterruptNumber,
+                                     uint32_t (*pvHandler)(void));
+/*-----------------------------------------------------------*/
+
+
+/* Critical section management. Disabling the interrupts and masking them
+with portSET_INTERRUPT_MASK() only concern the calling core, the critical
+section and the _FROM_ISR() mask also take the kernel lock shared by all cores.
+*/
+extern void vPortDisableInterrupts(void);
+extern void vPortEnableInterrupts(void);
+extern BaseType_t xPortSetCoreInterruptMask(void);
+extern void vPortClearCoreInterruptMask(BaseType_t xMask);
+#define portSET_INTERRUPT_MASK()    xPortSetCoreInterruptMask()
+#define portCLEAR_INTERRUPT_MASK(x) vPortClearCoreInterruptMask(x)
+
+extern BaseType_t xPortSetInterruptMask(void);
+extern void vPortClearInterruptMask(BaseType_t xMask);
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()       xPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)    vPortClearInterruptMask(x)
+
+
+extern void vPortEnterCritical(void);
+extern void vPortExitCritical(void);
+
+#define portDISABLE_INTERRUPTS()    vPortDisableInterrupts()
+#define portENABLE_INTERRUPTS()     vPortEnableInterrupts()
+#define portENTER_CRITICAL()        vPortEnterCritical()
+#define portEXIT_CRITICAL()         vPortExitCritical()
+/*-----------------------------------------------------------*/
+
+/* Multiple cores. Each core is a host thread of its own, the thread that
+starts the scheduler being core 0. A core yields another by signalling it with
+SIG_YIELD, other host threads act as interrupts of core 0. The task lock is the
+kernel lock, so it may be taken again within a critical section and the other
+way around. An idle core sleeps until it is interrupted. */
+#ifndef configNUMBER_OF_CORES
+#define configNUMBER_OF_CORES           1
+#endif
+
+extern BaseType_t xPortGetCoreID(void);
+extern void vPortYieldCore(BaseType_t xCoreID);
+extern void vPortGetTaskLock(void);
+extern void vPortReleaseTaskLock(void);
+extern void vPortWaitForInterrupt(void);
+
+#define portGET_CORE_ID()           xPortGetCoreID()
+#define portYIELD_CORE( xCoreID )   vPortYieldCore( xCoreID )
+#define portGET_TASK_LOCK()         vPortGetTaskLock()
+#define portRELEASE_TASK_LOCK()     vPortReleaseTaskLock()
+#if ( configNUMBER_OF_CORES > 1 )
+#define portWAIT_FOR_INTERRUPT()    vPortWaitForInterrupt()
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specific optimisations. The ready priorities are kept in a
+bit map in uxTopReadyPriority, one bit per priority, so the highest priority
+with ready tasks is found by counting the leading zeros of the bit map rather
+than by searching the ready lists. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+/* Not supported by the kernel with more than one core. */
+#if ( configNUMBER_OF_CORES > 1 )
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+#else
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+#endif
+#endif
+
+#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+/* Check the configuration. */
+#if( configMAX_PRIORITIES > ( __SIZEOF_LONG__ * 8 ) )
+#error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is at most the number of bits of UBaseType_t, 64 on 64-bit hosts.
+#endif
+
+/* Store/clear the ready priorities in a bit map. */
+#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+/*-----------------------------------------------------------*/
+
+#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( ( UBaseType_t ) ( ( __SIZEOF_LONG__ * 8 ) - 1 ) - ( UBaseType_t ) __builtin_clzl( ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+
+#define portOUTPUT_BYTE( a, b )
+
+/* Unmaps the stack of a deleted task. */
+extern void vPortCleanUpTCB(void *pxTCB);
+#define portCLEAN_UP_TCB( pxTCB )               vPortCleanUpTCB( pxTCB )
+
+/* Each task runs on its own mapped stack of the task's stack depth scaled by
+configHOST_STACK_SCALE, as host library code needs far more stack than code
+built for a microcontroller, but no less than configMINIMAL_HOST_STACK_SIZE
+bytes. Pages are only committed once touched and a guard page below the stack
+turns an overflow into a fault. */
+#define portHAS_STACK_OVERFLOW_CHECKING 1
+
+/* Tasks run on their host stacks rather than the stack the kernel allocates,
+so uxTaskGetStackHighWaterMark() and vTaskGetInfo() measure those. A stack is
+freshly mapped and reads as zero, the lowest byte that is no longer zero is
+the task's peak and pages that were never touched stay uncommitted. The result
+is the task's stack depth less the peak in words scaled down by
+configHOST_STACK_SCALE, so it says how far the depth could be cut. */
+#define portGET_STACK_HIGH_WATER_MARK( pxTopOfStack ) uxPortGetStackHighWaterMark( ( portSTACK_TYPE * ) ( pxTopOfStack ) )
+extern unsigned portBASE_TYPE uxPortGetStackHighWaterMark(portSTACK_TYPE *pxTopOfStack);
+
+#ifndef configHOST_STACK_SCALE
+#define configHOST_STACK_SCALE          16
+#endif
+
+#ifndef configMINIMAL_HOST_STACK_SIZE
+#define configMINIMAL_HOST_STACK_SIZE   ( 64 * 1024 )
+#endif
+
+/* Statistics of the tick, see vPortGetTickStats(). Bucket 0 of the jitter
+histogram counts ticks raised less than 1us late, bucket n counts those less
+than 2^n us late and the last bucket counts all later ones. */
+#define portTICK_JITTER_BUCKETS         16
+
+typedef struct xPORT_TICK_STATS {
+    unsigned long ulTicks;          /* Tick periods that have elapsed. */
+    unsigned long ulMissedTicks;    /* Periods that were overslept. */
+    unsigned long ulMaxLatenessNs;  /* Latest that a tick has been raised. */
+    unsigned long ulJitterHistogram[portTICK_JITTER_BUCKETS];
+} xPortTickStats;
+
+extern void vPortGetTickStats(xPortTickStats *pxStats);
+extern void vPortResetTickStats(void);
+
+/* Virtual time decouples the tick from the wall clock to simulate faster than
+real time. While tasks are runnable a tick is raised after every
+configVIRTUAL_TICK_BUDGET_US microseconds of real time, while all tasks are
+blocked the tick count jumps straight to the next unblock time. Requires
+tickless idle. */
+#ifndef configUSE_VIRTUAL_TIME
+#define configUSE_VIRTUAL_TIME          0
+#endif
+
+#ifndef configVIRTUAL_TICK_BUDGET_US
+#define configVIRTUAL_TICK_BUDGET_US    100
+#endif
+
+/* The idle task sleeps until the next task is due or a simulated interrupt
+readies a task through portYIELD_FROM_ISR(). */
+extern void vPortSuppressTicksAndSleep(TickType_t xExpectedIdleTime);
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )  vPortSuppressTicksAndSleep( xExpectedIdleTime )
+
+/* Posix Signal definitions that can be changed or read as appropriate. The
+tick is raised by a timer that signals core 0 only, other host threads that
+raise a simulated interrupt or call portYIELD_FROM_ISR() interrupt it with
+SIG_YIELD. */
+#define SIG_YIELD                   SIGUSR1
+#define SIG_TICK                    SIGALRM
+
+/* Run-time statistics count the nanoseconds of CLOCK_MONOTONIC that each task
+spends running, configRUN_TIME_COUNTER_TYPE should be uint64_t as a 32-bit
+counter overflows after about 4 seconds. */
+extern void vPortFindTicksPerSecond(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()    vPortFindTicksPerSecond()       /* Remember when the scheduler started. */
+extern configRUN_TIME_COUNTER_TYPE ulPortGetTimerValue(void);
+#define portGET_RUN_TIME_COUNTER_VALUE()            ulPortGetTimerValue()           /* Nanoseconds since the scheduler started. */
+#define portLU_PRINTF_SPECIFIER_REQUIRED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
@@ -75,6 +75,9 @@ task.h is included from an application file. */
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* heap_6.c is used instead when the size class heap is selected. */
+#if( configUSE_SIZE_CLASS_HEAP == 0 )
+
 /*-----------------------------------------------------------*/
 
 void *pvPortMalloc(size_t xWantedSize)
@@ -111,5 +114,4 @@ void vPortFree(void *pv)
     }
 }
 
-
-
+#endif /* configUSE_SIZE_CLASS_HEAP */
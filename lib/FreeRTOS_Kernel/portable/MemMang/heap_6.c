@@ -0,0 +1,865 @@
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that allocates
+ * from a fixed configTOTAL_HEAP_SIZE array, like heap_4.c, in constant time.
+ *
+ * Requests of up to heapMAX_SIZE_CLASS bytes are rounded up to one of
+ * heapNUMBER_OF_SIZE_CLASSES sizes.  Each core keeps a cache of free blocks
+ * per size class that it uses with only its own interrupts masked, so most
+ * small allocations neither suspend the scheduler nor search the heap.  A
+ * cache that runs empty takes a batch of blocks from the bin its size class
+ * shares between the cores, or carves them from the free blocks, a cache that
+ * grows too long returns a batch to the shared bin, both with the scheduler
+ * suspended.
+ *
+ * Larger requests are served from free lists segregated by size, with a bit
+ * map of the lists that are not empty, so finding a block that fits does not
+ * walk the free blocks.  Each block records the size of the free block in
+ * front of it, so a freed block is combined with the free blocks on either
+ * side without a search either.  The blocks in the shared bins, and in the
+ * cache of the calling core, are only returned to the free blocks, and so
+ * combined, when an allocation would otherwise fail.
+ *
+ * Select this implementation instead of heap_3.c by setting
+ * configUSE_SIZE_CLASS_HEAP to 1 in FreeRTOSConfig.h.  vPortGetHeapStats()
+ * reports how fragmented the heap is.
+ *
+ * See heap_3.c for an alternative implementation, and the memory management
+ * pages of http://www.FreeRTOS.org for more information.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configUSE_SIZE_CLASS_HEAP == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* Blocks are aligned as by the host's malloc(), so that any type can be
+stored in them. */
+#define heapBYTE_ALIGNMENT          ( ( size_t ) 16 )
+#define heapBYTE_ALIGNMENT_MASK     ( heapBYTE_ALIGNMENT - ( size_t ) 1 )
+
+/* Block sizes must not get too small, a free block holds two links. */
+#define heapMINIMUM_BLOCK_SIZE      ( ( size_t ) ( xHeapStructSize << 1 ) )
+
+/* Block sizes are multiples of the alignment, which leaves the low bits of
+xBlockSize for flags.  heapBLOCK_ALLOCATED_BIT is set while the block does not
+belong to the free lists, that is while it is allocated or binned, and
+heapPREV_FREE_BIT while the block in front of it is free. */
+#define heapBLOCK_ALLOCATED_BIT     ( ( size_t ) 1 )
+#define heapPREV_FREE_BIT           ( ( size_t ) 2 )
+#define heapBLOCK_SIZE( pxBlock )   ( ( pxBlock )->xBlockSize & ~heapBYTE_ALIGNMENT_MASK )
+#define heapNEXT_BLOCK( pxBlock )   ( ( BlockLink_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/* There is a free list for every power of two of block sizes, each split into
+heapSECOND_LEVEL_LISTS lists. */
+#define heapBITS_PER_BYTE           ( ( size_t ) 8 )
+#define heapFIRST_LEVEL_LISTS       ( sizeof( size_t ) * heapBITS_PER_BYTE )
+#define heapSECOND_LEVEL_BITS       ( 2 )
+#define heapSECOND_LEVEL_LISTS      ( 1 << heapSECOND_LEVEL_BITS )
+#define heapMOST_SIGNIFICANT_BIT( x )   ( ( UBaseType_t ) ( ( heapFIRST_LEVEL_LISTS - 1 ) - ( size_t ) __builtin_clzl( x ) ) )
+#define heapLEAST_SIGNIFICANT_BIT( x )  ( ( UBaseType_t ) __builtin_ctzl( x ) )
+
+/* The size classes, see xSizeClassSizes[]. */
+#define heapNUMBER_OF_SIZE_CLASSES  ( 10 )
+#define heapMAX_SIZE_CLASS          ( ( size_t ) 512 )
+
+/* The number of blocks of a size class a core caches at most, and the number
+of blocks moved between a cache and the shared bin at once. */
+#define heapCACHE_DEPTH             ( ( UBaseType_t ) 32 )
+#define heapCACHE_BATCH             ( ( UBaseType_t ) 16 )
+
+#if defined( portGET_CORE_ID )
+
+/* In the Posix_SingleThread port the tasks of a core share its host thread,
+masking the interrupts of the core keeps them from switching without taking
+the kernel lock. */
+#define heapENTER_CACHE( xMask )    ( xMask ) = portSET_INTERRUPT_MASK()
+#define heapEXIT_CACHE( xMask )     portCLEAR_INTERRUPT_MASK( xMask )
+#define heapGET_CACHE()             ( &( xCaches[ portGET_CORE_ID() ] ) )
+
+#else
+
+/* The Posix port has a single core, whose critical section only masks the
+interrupts. */
+#define heapENTER_CACHE( xMask )    { ( void ) ( xMask ); taskENTER_CRITICAL(); }
+#define heapEXIT_CACHE( xMask )     taskEXIT_CRITICAL()
+#define heapGET_CACHE()             ( &( xCaches[ 0 ] ) )
+
+#endif /* portGET_CORE_ID */
+
+/* Allocate the memory for the heap. */
+static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+
+/* The header at the start of every block, followed by links that are only
+used while the block is free or binned and otherwise belong to the
+application. */
+typedef struct A_BLOCK_LINK {
+    size_t xPrevBlockSize;                  /*<< The size of the block in front, only valid while that block is free. */
+    size_t xBlockSize;                      /*<< The size of the block, including the header, and its flags. */
+    struct A_BLOCK_LINK *pxNextFreeBlock;   /*<< The next block in the same free list or bin. */
+    struct A_BLOCK_LINK *pxPrevFreeBlock;   /*<< The previous block in the same free list. */
+} BlockLink_t;
+
+/* The blocks a core keeps of each size class. */
+typedef struct A_HEAP_CACHE {
+    BlockLink_t *pxBlocks[ heapNUMBER_OF_SIZE_CLASSES ];
+    UBaseType_t uxBlocks[ heapNUMBER_OF_SIZE_CLASSES ];
+    size_t xBytes;                          /*<< The size of all the cached blocks. */
+    size_t xAllocations;                    /*<< Allocations served from the cache. */
+    size_t xFrees;                          /*<< Frees taken by the cache. */
+} HeapCache_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Inserts a block of memory that is being freed into the free list of its
+ * size.  The block being freed will be merged with the block in front it
+ * and/or the block behind it if they are free.
+ */
+static void prvInsertBlockIntoFreeList(BlockLink_t *pxBlockToInsert);
+
+/*
+ * Adds a free block to, or removes it from, the free list of its size.
+ */
+static void prvAddToFreeList(BlockLink_t *pxBlock);
+static void prvRemoveFromFreeList(BlockLink_t *pxBlock);
+
+/*
+ * Returns the free list that holds blocks of xBlockSize bytes.
+ */
+static void prvGetFreeList(size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel);
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit(void);
+
+/*
+ * Takes a block of at least xWantedSize bytes, including its header, from the
+ * free lists, or returns NULL if there is none.
+ */
+static BlockLink_t *prvAllocateFromFreeList(size_t xWantedSize);
+
+/*
+ * Returns the blocks of the shared bins, and of the cache of the calling
+ * core, to the free lists.  Called with the scheduler suspended.
+ */
+static void prvReleaseBins(void);
+
+/*
+ * Returns a block of the size class, from the cache of the calling core or
+ * else from a new batch, or NULL if the heap is exhausted.
+ */
+static BlockLink_t *prvAllocateFromCache(UBaseType_t uxClass);
+
+/*
+ * Takes a batch of up to heapCACHE_BATCH blocks of the size class from its
+ * shared bin, or carves them from the free blocks, and links them from
+ * *ppxFirst to *ppxLast.  Called with the scheduler suspended, returns the
+ * number of blocks taken.
+ */
+static UBaseType_t prvTakeBatch(UBaseType_t uxClass, BlockLink_t **ppxFirst, BlockLink_t **ppxLast, size_t *pxBytes);
+
+/*-----------------------------------------------------------*/
+
+/* The header size at the beginning of each allocated memory block must by
+correctly byte aligned. */
+static const size_t xHeapStructSize = (offsetof(BlockLink_t, pxNextFreeBlock) + ((size_t)(heapBYTE_ALIGNMENT - 1))) & ~((size_t) heapBYTE_ALIGNMENT_MASK);
+
+/* The usable size of the blocks of each size class, about a third apart so
+that rounding a request up wastes at most a third of the block. */
+static const size_t xSizeClassSizes[ heapNUMBER_OF_SIZE_CLASSES ] = { 16, 32, 48, 64, 96, 128, 192, 256, 384, 512 };
+
+/* The size class of a request, indexed by the request rounded up to the
+alignment and divided by it. */
+static const uint8_t ucSizeClassOfRequest[ (heapMAX_SIZE_CLASS / heapBYTE_ALIGNMENT) + 1 ] = {
+    0, 0, 1, 2, 3, 4, 4, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7,
+    8, 8, 8, 8, 8, 8, 8, 8, 9, 9, 9, 9, 9, 9, 9, 9
+};
+
+/* The first block of the heap, and the header at its end that stops blocks
+from being merged past it. */
+static BlockLink_t *pxStart = NULL, *pxEnd = NULL;
+
+/* The free lists, and bit maps of those that are not empty. */
+static BlockLink_t *pxFreeLists[ heapFIRST_LEVEL_LISTS ][ heapSECOND_LEVEL_LISTS ];
+static size_t xFirstLevelMap = 0U;
+static uint8_t ucSecondLevelMaps[ heapFIRST_LEVEL_LISTS ];
+
+/* Binned blocks shared by the cores, one list per size class. */
+static BlockLink_t *pxBins[ heapNUMBER_OF_SIZE_CLASSES ];
+
+/* The blocks cached by each core. */
+static HeapCache_t xCaches[ configNUMBER_OF_CORES ];
+
+/* Keeps track of the number of free bytes remaining, in free and binned
+blocks, but says nothing about fragmentation.  The blocks cached by the cores
+are counted separately. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xBinnedBytes = 0U;
+
+/* Allocations and frees that did not use a cache. */
+static size_t xNumberOfSuccessfulAllocations = 0U;
+static size_t xNumberOfSuccessfulFrees = 0U;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc(size_t xWantedSize)
+{
+    BlockLink_t *pxBlock = NULL;
+    void *pvReturn = NULL;
+
+    if ((xWantedSize > (size_t) 0) && (xWantedSize <= heapMAX_SIZE_CLASS)) {
+        pxBlock = prvAllocateFromCache((UBaseType_t) ucSizeClassOfRequest[ (xWantedSize + heapBYTE_ALIGNMENT_MASK) / heapBYTE_ALIGNMENT ]);
+    }
+    else if ((xWantedSize > (size_t) 0) && (xWantedSize < (size_t) configTOTAL_HEAP_SIZE)) {
+        /* The wanted size is increased so it can contain the header in
+        addition to the requested amount of bytes, and to stay aligned. */
+        xWantedSize = (xWantedSize + xHeapStructSize + heapBYTE_ALIGNMENT_MASK) & ~heapBYTE_ALIGNMENT_MASK;
+
+        vTaskSuspendAll();
+        {
+            if (pxEnd == NULL) {
+                prvHeapInit();
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxBlock = prvAllocateFromFreeList(xWantedSize);
+            if (pxBlock == NULL) {
+                /* Combine the binned blocks with the free ones and try
+                again. */
+                prvReleaseBins();
+                pxBlock = prvAllocateFromFreeList(xWantedSize);
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if (pxBlock != NULL) {
+                xNumberOfSuccessfulAllocations++;
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        (void) xTaskResumeAll();
+    }
+    else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if (pxBlock != NULL) {
+        /* Return the memory space pointed to - jumping over the header at its
+        start. */
+        pvReturn = (void *)(((uint8_t *) pxBlock) + xHeapStructSize);
+    }
+    else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceMALLOC(pvReturn, xWantedSize);
+
+#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if (pvReturn == NULL) {
+            extern void vApplicationMallocFailedHook(void);
+            vApplicationMallocFailedHook();
+        }
+        else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+#endif
+
+    configASSERT((((size_t) pvReturn) & (size_t) heapBYTE_ALIGNMENT_MASK) == 0);
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree(void *pv)
+{
+    uint8_t *puc = (uint8_t *) pv;
+    BlockLink_t *pxLink, *pxFirst = NULL, *pxLast = NULL;
+    HeapCache_t *pxCache;
+    size_t xBlockSize, xBytes = 0U;
+    UBaseType_t uxClass = 0, uxBlocks;
+    BaseType_t xCached = pdFALSE;
+    UBaseType_t uxMask = 0;
+
+    if (pv != NULL) {
+        /* The memory being freed will have a header immediately before it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = (BlockLink_t *) puc;
+
+        /* Check the block is actually allocated. */
+        configASSERT((pxLink->xBlockSize & heapBLOCK_ALLOCATED_BIT) != 0);
+
+        xBlockSize = heapBLOCK_SIZE(pxLink);
+        traceFREE(pv, xBlockSize);
+
+        /* A block whose usable size is that of a size class is cached. */
+        if ((xBlockSize - xHeapStructSize) <= heapMAX_SIZE_CLASS) {
+            uxClass = (UBaseType_t) ucSizeClassOfRequest[ (xBlockSize - xHeapStructSize) / heapBYTE_ALIGNMENT ];
+            if (xSizeClassSizes[ uxClass ] == (xBlockSize - xHeapStructSize)) {
+                xCached = pdTRUE;
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if (xCached != pdFALSE) {
+            heapENTER_CACHE(uxMask);
+            {
+                pxCache = heapGET_CACHE();
+                pxLink->pxNextFreeBlock = pxCache->pxBlocks[ uxClass ];
+                pxCache->pxBlocks[ uxClass ] = pxLink;
+                pxCache->uxBlocks[ uxClass ]++;
+                pxCache->xBytes += xBlockSize;
+                pxCache->xFrees++;
+
+                if (pxCache->uxBlocks[ uxClass ] > heapCACHE_DEPTH) {
+                    /* Take a batch of blocks off the cache for the shared
+                    bin. */
+                    pxFirst = pxCache->pxBlocks[ uxClass ];
+                    pxLast = pxFirst;
+                    xBytes = heapBLOCK_SIZE(pxLast);
+                    for (uxBlocks = 1; uxBlocks < heapCACHE_BATCH; uxBlocks++) {
+                        pxLast = pxLast->pxNextFreeBlock;
+                        xBytes += heapBLOCK_SIZE(pxLast);
+                    }
+
+                    pxCache->pxBlocks[ uxClass ] = pxLast->pxNextFreeBlock;
+                    pxCache->uxBlocks[ uxClass ] -= heapCACHE_BATCH;
+                    pxCache->xBytes -= xBytes;
+                }
+                else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            heapEXIT_CACHE(uxMask);
+
+            if (pxFirst != NULL) {
+                vTaskSuspendAll();
+                {
+                    pxLast->pxNextFreeBlock = pxBins[ uxClass ];
+                    pxBins[ uxClass ] = pxFirst;
+                    xBinnedBytes += xBytes;
+                    xFreeBytesRemaining += xBytes;
+                }
+                (void) xTaskResumeAll();
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else {
+            vTaskSuspendAll();
+            {
+                /* Add this block to the free lists. */
+                xFreeBytesRemaining += xBlockSize;
+                prvInsertBlockIntoFreeList(pxLink);
+                xNumberOfSuccessfulFrees++;
+            }
+            (void) xTaskResumeAll();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize(void)
+{
+    size_t xReturn = xFreeBytesRemaining;
+    BaseType_t xCore;
+
+    for (xCore = 0; xCore < (BaseType_t) configNUMBER_OF_CORES; xCore++) {
+        xReturn += xCaches[ xCore ].xBytes;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize(void)
+{
+    /* The blocks cached by the cores count as allocated, they are at most
+    heapCACHE_DEPTH blocks per size class and core. */
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks(void)
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats(HeapStats_t *pxHeapStats)
+{
+    BlockLink_t *pxBlock;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = 0, xCachedBytes = 0;
+    size_t xAllocations = 0, xFrees = 0;
+    BaseType_t xCore;
+
+    vTaskSuspendAll();
+    {
+        if (pxEnd != NULL) {
+            /* Walk all the blocks in address order to find the free ones. */
+            for (pxBlock = pxStart; pxBlock != pxEnd; pxBlock = heapNEXT_BLOCK(pxBlock)) {
+                if ((pxBlock->xBlockSize & heapBLOCK_ALLOCATED_BIT) == 0) {
+                    xBlocks++;
+                    if (heapBLOCK_SIZE(pxBlock) > xMaxSize) {
+                        xMaxSize = heapBLOCK_SIZE(pxBlock);
+                    }
+                    if ((xMinSize == 0) || (heapBLOCK_SIZE(pxBlock) < xMinSize)) {
+                        xMinSize = heapBLOCK_SIZE(pxBlock);
+                    }
+                }
+            }
+        }
+        else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The caches of other cores are read without masking their
+        interrupts, so the counts are a snapshot. */
+        for (xCore = 0; xCore < (BaseType_t) configNUMBER_OF_CORES; xCore++) {
+            xCachedBytes += xCaches[ xCore ].xBytes;
+            xAllocations += xCaches[ xCore ].xAllocations;
+            xFrees += xCaches[ xCore ].xFrees;
+        }
+
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining + xCachedBytes;
+        pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+        pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+        pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations + xAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees + xFrees;
+        pxHeapStats->xBytesInSizeClassBins = xBinnedBytes + xCachedBytes;
+    }
+    (void) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t *prvAllocateFromCache(UBaseType_t uxClass)
+{
+    BlockLink_t *pxBlock, *pxFirst = NULL, *pxLast = NULL;
+    HeapCache_t *pxCache;
+    size_t xBytes = 0U;
+    UBaseType_t uxBlocks = 0, uxMask = 0;
+
+    heapENTER_CACHE(uxMask);
+    {
+        pxCache = heapGET_CACHE();
+        pxBlock = pxCache->pxBlocks[ uxClass ];
+        if (pxBlock != NULL) {
+            pxCache->pxBlocks[ uxClass ] = pxBlock->pxNextFreeBlock;
+            pxCache->uxBlocks[ uxClass ]--;
+            pxCache->xBytes -= heapBLOCK_SIZE(pxBlock);
+            pxCache->xAllocations++;
+        }
+        else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    heapEXIT_CACHE(uxMask);
+
+    if (pxBlock == NULL) {
+        vTaskSuspendAll();
+        {
+            if (pxEnd == NULL) {
+                prvHeapInit();
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxBlocks = prvTakeBatch(uxClass, &pxFirst, &pxLast, &xBytes);
+            if (uxBlocks == (UBaseType_t) 0) {
+                /* Combine the binned blocks with the free ones and try
+                again. */
+                prvReleaseBins();
+                uxBlocks = prvTakeBatch(uxClass, &pxFirst, &pxLast, &xBytes);
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if (uxBlocks != (UBaseType_t) 0) {
+                xNumberOfSuccessfulAllocations++;
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        (void) xTaskResumeAll();
+
+        if (pxFirst != NULL) {
+            /* Return the first block and cache the rest of the batch, on the
+            core the task is now running on. */
+            pxBlock = pxFirst;
+            xBytes -= heapBLOCK_SIZE(pxBlock);
+            pxFirst = pxFirst->pxNextFreeBlock;
+
+            if (pxFirst != NULL) {
+                heapENTER_CACHE(uxMask);
+                {
+                    pxCache = heapGET_CACHE();
+                    pxLast->pxNextFreeBlock = pxCache->pxBlocks[ uxClass ];
+                    pxCache->pxBlocks[ uxClass ] = pxFirst;
+                    pxCache->uxBlocks[ uxClass ] += uxBlocks - (UBaseType_t) 1;
+                    pxCache->xBytes += xBytes;
+                }
+                heapEXIT_CACHE(uxMask);
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvTakeBatch(UBaseType_t uxClass, BlockLink_t **ppxFirst, BlockLink_t **ppxLast, size_t *pxBytes)
+{
+    const size_t xBlockSize = xHeapStructSize + xSizeClassSizes[ uxClass ];
+    BlockLink_t *pxBlock = NULL;
+    UBaseType_t uxBlocks;
+
+    *ppxFirst = NULL;
+    *pxBytes = 0U;
+
+    for (uxBlocks = 0; uxBlocks < heapCACHE_BATCH; uxBlocks++) {
+        if (pxBins[ uxClass ] != NULL) {
+            pxBlock = pxBins[ uxClass ];
+            pxBins[ uxClass ] = pxBlock->pxNextFreeBlock;
+            xBinnedBytes -= heapBLOCK_SIZE(pxBlock);
+            xFreeBytesRemaining -= heapBLOCK_SIZE(pxBlock);
+        }
+        else {
+            pxBlock = prvAllocateFromFreeList(xBlockSize);
+            if (pxBlock == NULL) {
+                break;
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        pxBlock->pxNextFreeBlock = *ppxFirst;
+        if (*ppxFirst == NULL) {
+            *ppxLast = pxBlock;
+        }
+        else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+        *ppxFirst = pxBlock;
+        *pxBytes += heapBLOCK_SIZE(pxBlock);
+    }
+
+    if (xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
+        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+    }
+    else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return uxBlocks;
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t *prvAllocateFromFreeList(size_t xWantedSize)
+{
+    BlockLink_t *pxBlock = NULL, *pxNewBlockLink;
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    size_t xLists;
+
+    if (xWantedSize > xFreeBytesRemaining) {
+        return NULL;
+    }
+
+    /* Look in the first list that is not empty from the one of the wanted size
+    rounded up to the next list, whose blocks all fit. */
+    prvGetFreeList(xWantedSize + (((size_t) 1) << (heapMOST_SIGNIFICANT_BIT(xWantedSize) - heapSECOND_LEVEL_BITS)) - 1, &uxFirstLevel, &uxSecondLevel);
+    xLists = (size_t) ucSecondLevelMaps[ uxFirstLevel ] & (~((size_t) 0) << uxSecondLevel);
+    if (xLists == 0U) {
+        xLists = xFirstLevelMap & (~((size_t) 1) << uxFirstLevel);
+        if (xLists != 0U) {
+            uxFirstLevel = heapLEAST_SIGNIFICANT_BIT(xLists);
+            xLists = (size_t) ucSecondLevelMaps[ uxFirstLevel ];
+        }
+        else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if (xLists != 0U) {
+        pxBlock = pxFreeLists[ uxFirstLevel ][ heapLEAST_SIGNIFICANT_BIT(xLists) ];
+    }
+    else {
+        /* Only the list of the wanted size itself may hold a block that is
+        large enough. */
+        prvGetFreeList(xWantedSize, &uxFirstLevel, &uxSecondLevel);
+        for (pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock) {
+            if (heapBLOCK_SIZE(pxBlock) >= xWantedSize) {
+                break;
+            }
+        }
+
+        if (pxBlock == NULL) {
+            return NULL;
+        }
+    }
+
+    /* This block is being returned for use so must be taken out of the free
+    lists. */
+    prvRemoveFromFreeList(pxBlock);
+
+    /* If the block is larger than required it can be split into two. */
+    if ((heapBLOCK_SIZE(pxBlock) - xWantedSize) >= heapMINIMUM_BLOCK_SIZE) {
+        /* This block is to be split into two.  Create a new block following
+        the number of bytes requested, the block in front of which is not
+        free. */
+        pxNewBlockLink = (BlockLink_t *)(((uint8_t *) pxBlock) + xWantedSize);
+        configASSERT((((size_t) pxNewBlockLink) & heapBYTE_ALIGNMENT_MASK) == 0);
+        pxNewBlockLink->xBlockSize = heapBLOCK_SIZE(pxBlock) - xWantedSize;
+        pxBlock->xBlockSize = xWantedSize;
+
+        /* Insert the new block into the free lists. */
+        prvAddToFreeList(pxNewBlockLink);
+    }
+    else {
+        heapNEXT_BLOCK(pxBlock)->xBlockSize &= ~heapPREV_FREE_BIT;
+    }
+
+    xFreeBytesRemaining -= heapBLOCK_SIZE(pxBlock);
+
+    if (xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
+        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+    }
+    else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* The block is being returned - it is allocated and owned by the
+    application. */
+    pxBlock->xBlockSize |= heapBLOCK_ALLOCATED_BIT;
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseBins(void)
+{
+    BlockLink_t *pxBlocks[ heapNUMBER_OF_SIZE_CLASSES ];
+    BlockLink_t *pxBlock;
+    HeapCache_t *pxCache;
+    UBaseType_t uxClass, uxMask = 0;
+
+    /* The cache of the calling core is emptied with its interrupts masked,
+    the caches of other cores may be in use. */
+    heapENTER_CACHE(uxMask);
+    {
+        pxCache = heapGET_CACHE();
+        for (uxClass = 0; uxClass < (UBaseType_t) heapNUMBER_OF_SIZE_CLASSES; uxClass++) {
+            pxBlocks[ uxClass ] = pxCache->pxBlocks[ uxClass ];
+            pxCache->pxBlocks[ uxClass ] = NULL;
+            pxCache->uxBlocks[ uxClass ] = 0;
+        }
+        xFreeBytesRemaining += pxCache->xBytes;
+        pxCache->xBytes = 0U;
+    }
+    heapEXIT_CACHE(uxMask);
+
+    for (uxClass = 0; uxClass < (UBaseType_t) heapNUMBER_OF_SIZE_CLASSES; uxClass++) {
+        while (pxBlocks[ uxClass ] != NULL) {
+            pxBlock = pxBlocks[ uxClass ];
+            pxBlocks[ uxClass ] = pxBlock->pxNextFreeBlock;
+            prvInsertBlockIntoFreeList(pxBlock);
+        }
+
+        while (pxBins[ uxClass ] != NULL) {
+            pxBlock = pxBins[ uxClass ];
+            pxBins[ uxClass ] = pxBlock->pxNextFreeBlock;
+            prvInsertBlockIntoFreeList(pxBlock);
+        }
+    }
+
+    xBinnedBytes = 0U;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit(void)
+{
+    uint8_t *pucAlignedHeap;
+    size_t uxAddress;
+    size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+    /* Ensure the heap starts on a correctly aligned boundary. */
+    uxAddress = (size_t) ucHeap;
+
+    if ((uxAddress & heapBYTE_ALIGNMENT_MASK) != 0) {
+        uxAddress += (heapBYTE_ALIGNMENT - 1);
+        uxAddress &= ~((size_t) heapBYTE_ALIGNMENT_MASK);
+        xTotalHeapSize -= uxAddress - (size_t) ucHeap;
+    }
+
+    pucAlignedHeap = (uint8_t *) uxAddress;
+
+    /* pxEnd is a header without a block at the end of the heap space, it
+    counts as allocated so that no block is merged with it. */
+    uxAddress = ((size_t) pucAlignedHeap) + xTotalHeapSize;
+    uxAddress -= sizeof(BlockLink_t);
+    uxAddress &= ~((size_t) heapBYTE_ALIGNMENT_MASK);
+    pxEnd = (void *) uxAddress;
+    pxEnd->xBlockSize = heapBLOCK_ALLOCATED_BIT;
+
+    /* To start with there is a single free block that is sized to take up the
+    entire heap space, minus the space taken by pxEnd. */
+    pxStart = (void *) pucAlignedHeap;
+    pxStart->xBlockSize = uxAddress - (size_t) pxStart;
+    prvAddToFreeList(pxStart);
+
+    /* Only one block exists - and it covers the entire usable heap space. */
+    xMinimumEverFreeBytesRemaining = heapBLOCK_SIZE(pxStart);
+    xFreeBytesRemaining = heapBLOCK_SIZE(pxStart);
+}
+/*-----------------------------------------------------------*/
+
+static void prvGetFreeList(size_t xBlockSize, UBaseType_t *puxFirstLevel, UBaseType_t *puxSecondLevel)
+{
+    /* The power of two below the size, and the next bits of the size. */
+    *puxFirstLevel = heapMOST_SIGNIFICANT_BIT(xBlockSize);
+    *puxSecondLevel = (UBaseType_t)(xBlockSize >> (*puxFirstLevel - heapSECOND_LEVEL_BITS)) & (UBaseType_t)(heapSECOND_LEVEL_LISTS - 1);
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddToFreeList(BlockLink_t *pxBlock)
+{
+    BlockLink_t *pxNextBlock;
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+
+    prvGetFreeList(heapBLOCK_SIZE(pxBlock), &uxFirstLevel, &uxSecondLevel);
+
+    pxBlock->pxPrevFreeBlock = NULL;
+    pxBlock->pxNextFreeBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+    if (pxBlock->pxNextFreeBlock != NULL) {
+        pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock;
+    }
+    else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+    pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+
+    ucSecondLevelMaps[ uxFirstLevel ] |= (uint8_t)(1U << uxSecondLevel);
+    xFirstLevelMap |= ((size_t) 1) << uxFirstLevel;
+
+    /* Let the block behind this one find it. */
+    pxNextBlock = heapNEXT_BLOCK(pxBlock);
+    pxNextBlock->xPrevBlockSize = heapBLOCK_SIZE(pxBlock);
+    pxNextBlock->xBlockSize |= heapPREV_FREE_BIT;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFromFreeList(BlockLink_t *pxBlock)
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+
+    prvGetFreeList(heapBLOCK_SIZE(pxBlock), &uxFirstLevel, &uxSecondLevel);
+
+    if (pxBlock->pxNextFreeBlock != NULL) {
+        pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+    }
+    else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if (pxBlock->pxPrevFreeBlock != NULL) {
+        pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+    }
+    else {
+        pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+        if (pxBlock->pxNextFreeBlock == NULL) {
+            ucSecondLevelMaps[ uxFirstLevel ] &= (uint8_t) ~(1U << uxSecondLevel);
+            if (ucSecondLevelMaps[ uxFirstLevel ] == 0U) {
+                xFirstLevelMap &= ~(((size_t) 1) << uxFirstLevel);
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList(BlockLink_t *pxBlockToInsert)
+{
+    BlockLink_t *pxBlock;
+    size_t xBlockSize = heapBLOCK_SIZE(pxBlockToInsert);
+
+    /* Is the block behind the one being inserted free?  Then form one big
+    block from the two blocks. */
+    pxBlock = heapNEXT_BLOCK(pxBlockToInsert);
+    if ((pxBlock->xBlockSize & heapBLOCK_ALLOCATED_BIT) == 0) {
+        prvRemoveFromFreeList(pxBlock);
+        xBlockSize += heapBLOCK_SIZE(pxBlock);
+    }
+    else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Likewise with the block in front of it. */
+    if ((pxBlockToInsert->xBlockSize & heapPREV_FREE_BIT) != 0) {
+        pxBlock = (BlockLink_t *)(((uint8_t *) pxBlockToInsert) - pxBlockToInsert->xPrevBlockSize);
+        prvRemoveFromFreeList(pxBlock);
+        xBlockSize += heapBLOCK_SIZE(pxBlock);
+        pxBlockToInsert = pxBlock;
+    }
+    else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Free blocks are never next to each other, so the block in front of the
+    merged block is not free. */
+    pxBlockToInsert->xBlockSize = xBlockSize;
+    prvAddToFreeList(pxBlockToInsert);
+}
+
+#endif /* configUSE_SIZE_CLASS_HEAP */
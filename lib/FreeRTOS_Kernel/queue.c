@@ -78,6 +78,7 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "queue.h"
+#include "object_pool.h"
 
 #if (configUSE_CO_ROUTINES == 1)
 #include "croutine.h"
@@ -239,6 +240,30 @@ prvCopyDataToQueue(Queue_t *const pxQueue, const void *pvItemToQueue,
 static void prvCopyDataFromQueue(Queue_t *const pxQueue,
                                  void *const pvBuffer) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies uxCount items to the back of a queue that has room for them, as a
+ * single copy unless the items wrap around the end of the queue storage.
+ */
+static void prvCopyDataToQueueMultiple(Queue_t *const pxQueue,
+                                       const void *pvItems,
+                                       const UBaseType_t uxCount) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies uxCount items out of a queue that holds at least as many.
+ */
+static void prvCopyDataFromQueueMultiple(Queue_t *const pxQueue,
+                                         void *const pvBuffer,
+                                         const UBaseType_t uxCount) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes up to uxCount tasks from an event list of a queue, from within a
+ * critical section.
+ *
+ * @return pdTRUE if one of them has a higher priority than the calling task.
+ */
+static BaseType_t prvUnblockWaitingTasks(List_t *const pxEventList,
+                                         UBaseType_t uxCount) PRIVILEGED_FUNCTION;
+
 #if (configUSE_QUEUE_SETS == 1)
 /*
      * Checks to see if a queue is a member of a queue set, and if so, notifies
@@ -421,8 +446,8 @@ QueueHandle_t xQueueGenericCreate(const UBaseType_t uxQueueLength,
                                 uxItemSize); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
     }
 
-    pxNewQueue =
-        (Queue_t *)pvPortMalloc(sizeof(Queue_t) + xQueueSizeInBytes);
+    pxNewQueue = (Queue_t *)pvObjectPoolAllocate(
+                     eQueuePool, sizeof(Queue_t) + xQueueSizeInBytes);
 
     if (pxNewQueue != NULL) {
         /* Jump past the queue structure to find the location of the queue
@@ -1464,6 +1489,283 @@ BaseType_t xQueueGenericReceive(QueueHandle_t xQueue, void *const pvBuffer,
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t xQueueSendMultiple(QueueHandle_t xQueue, const void *const pvItems,
+                              const UBaseType_t uxItemCount,
+                              TickType_t xTicksToWait)
+{
+    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxCount, uxItem;
+    Queue_t *const pxQueue = (Queue_t *)xQueue;
+
+    configASSERT(pxQueue);
+    configASSERT(!((pvItems == NULL) && (uxItemCount != (UBaseType_t)0U)));
+    /* Semaphores and mutexes carry no items. */
+    configASSERT(pxQueue->uxItemSize != (UBaseType_t)0U);
+#if ((INCLUDE_xTaskGetSchedulerState == 1) || (configUSE_TIMERS == 1))
+    {
+        configASSERT(!(
+                         (xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED) &&
+                         (xTicksToWait != 0)));
+    }
+#endif
+
+    for (;;) {
+        taskENTER_CRITICAL();
+        {
+            /* Post as many of the items as there is room for, if there is
+            any, and wake the tasks waiting for them with at most one
+            yield. */
+            uxCount = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+            if ((uxCount > (UBaseType_t)0) ||
+                (uxItemCount == (UBaseType_t)0)) {
+                if (uxCount > uxItemCount) {
+                    uxCount = uxItemCount;
+                }
+
+                /* Trace each item as xQueueGenericSend() would. */
+                for (uxItem = 0; uxItem < uxCount; uxItem++) {
+                    traceQUEUE_SEND(pxQueue);
+                }
+                prvCopyDataToQueueMultiple(pxQueue, pvItems, uxCount);
+
+#if (configUSE_QUEUE_SETS == 1)
+                {
+                    if (pxQueue->pxQueueSetContainer != NULL) {
+                        /* The set holds one entry per item. */
+                        for (uxItem = 0; uxItem < uxCount; uxItem++) {
+                            if (prvNotifyQueueSetContainer(
+                                    pxQueue, queueSEND_TO_BACK) !=
+                                pdFALSE) {
+                                xYieldRequired = pdTRUE;
+                            }
+                        }
+                    }
+                    else {
+                        xYieldRequired = prvUnblockWaitingTasks(
+                                             &(pxQueue->xTasksWaitingToReceive),
+                                             uxCount);
+                    }
+                }
+#else /* configUSE_QUEUE_SETS */
+                {
+                    xYieldRequired = prvUnblockWaitingTasks(
+                                         &(pxQueue->xTasksWaitingToReceive),
+                                         uxCount);
+                }
+#endif /* configUSE_QUEUE_SETS */
+
+                if (xYieldRequired != pdFALSE) {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+                return (BaseType_t)uxCount;
+            }
+            else {
+                if (xTicksToWait == (TickType_t)0) {
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_SEND_FAILED(pxQueue);
+                    return 0;
+                }
+                else if (xEntryTimeSet == pdFALSE) {
+                    vTaskSetTimeOutState(&xTimeOut);
+                    xEntryTimeSet = pdTRUE;
+                }
+                else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* The queue is full, block as xQueueGenericSend() does. */
+        vTaskSuspendAll();
+        prvLockQueue(pxQueue);
+
+        if (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) == pdFALSE) {
+            if (prvIsQueueFull(pxQueue) != pdFALSE) {
+                traceBLOCKING_ON_QUEUE_SEND(pxQueue);
+                vTaskPlaceOnEventList(&(pxQueue->xTasksWaitingToSend),
+                                      xTicksToWait);
+                prvUnlockQueue(pxQueue);
+
+                if (xTaskResumeAll() == pdFALSE) {
+                    portYIELD_WITHIN_API();
+                }
+            }
+            else {
+                /* Try again. */
+                prvUnlockQueue(pxQueue);
+                (void)xTaskResumeAll();
+            }
+        }
+        else {
+            prvUnlockQueue(pxQueue);
+            (void)xTaskResumeAll();
+
+            traceQUEUE_SEND_FAILED(pxQueue);
+            return 0;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveMultiple(QueueHandle_t xQueue, void *const pvBuffer,
+                                 const UBaseType_t uxBufferCount,
+                                 TickType_t xTicksToWait)
+{
+    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxCount, uxItem;
+    Queue_t *const pxQueue = (Queue_t *)xQueue;
+
+    configASSERT(pxQueue);
+    configASSERT(!((pvBuffer == NULL) && (uxBufferCount != (UBaseType_t)0U)));
+    /* Semaphores and mutexes carry no items. */
+    configASSERT(pxQueue->uxItemSize != (UBaseType_t)0U);
+#if ((INCLUDE_xTaskGetSchedulerState == 1) || (configUSE_TIMERS == 1))
+    {
+        configASSERT(!(
+                         (xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED) &&
+                         (xTicksToWait != 0)));
+    }
+#endif
+
+    for (;;) {
+        taskENTER_CRITICAL();
+        {
+            /* Take as many items as are waiting, up to uxBufferCount, and
+            wake the tasks waiting for the space with at most one yield. */
+            uxCount = pxQueue->uxMessagesWaiting;
+
+            if ((uxCount > (UBaseType_t)0) ||
+                (uxBufferCount == (UBaseType_t)0)) {
+                if (uxCount > uxBufferCount) {
+                    uxCount = uxBufferCount;
+                }
+
+                /* Trace each item as xQueueReceive() would. */
+                for (uxItem = 0; uxItem < uxCount; uxItem++) {
+                    traceQUEUE_RECEIVE(pxQueue);
+                }
+                prvCopyDataFromQueueMultiple(pxQueue, pvBuffer, uxCount);
+
+                xYieldRequired = prvUnblockWaitingTasks(
+                                     &(pxQueue->xTasksWaitingToSend), uxCount);
+                if (xYieldRequired != pdFALSE) {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+                return (BaseType_t)uxCount;
+            }
+            else {
+                if (xTicksToWait == (TickType_t)0) {
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_RECEIVE_FAILED(pxQueue);
+                    return 0;
+                }
+                else if (xEntryTimeSet == pdFALSE) {
+                    vTaskSetTimeOutState(&xTimeOut);
+                    xEntryTimeSet = pdTRUE;
+                }
+                else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* The queue is empty, block as xQueueGenericReceive() does. */
+        vTaskSuspendAll();
+        prvLockQueue(pxQueue);
+
+        if (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) == pdFALSE) {
+            if (prvIsQueueEmpty(pxQueue) != pdFALSE) {
+                traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue);
+                vTaskPlaceOnEventList(&(pxQueue->xTasksWaitingToReceive),
+                                      xTicksToWait);
+                prvUnlockQueue(pxQueue);
+
+                if (xTaskResumeAll() == pdFALSE) {
+                    portYIELD_WITHIN_API();
+                }
+            }
+            else {
+                /* Try again. */
+                prvUnlockQueue(pxQueue);
+                (void)xTaskResumeAll();
+            }
+        }
+        else {
+            prvUnlockQueue(pxQueue);
+            (void)xTaskResumeAll();
+
+            if (prvIsQueueEmpty(pxQueue) != pdFALSE) {
+                traceQUEUE_RECEIVE_FAILED(pxQueue);
+                return 0;
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSendReference(QueueHandle_t xQueue, void *const pvBlock,
+                               TickType_t xTicksToWait)
+{
+    configASSERT(((Queue_t *)xQueue)->uxItemSize == sizeof(void *));
+
+    /* Only the pointer is copied, the block now belongs to the receiver. */
+    return xQueueGenericSend(xQueue, &pvBlock, xTicksToWait,
+                             queueSEND_TO_BACK);
+}
+/*-----------------------------------------------------------*/
+
+void *pvQueueReceiveReference(QueueHandle_t xQueue, TickType_t xTicksToWait)
+{
+    void *pvBlock = NULL;
+
+    configASSERT(((Queue_t *)xQueue)->uxItemSize == sizeof(void *));
+
+    (void)xQueueGenericReceive(xQueue, &pvBlock, xTicksToWait, pdFALSE);
+
+    return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void *pvQueueOverwriteReference(QueueHandle_t xQueue, void *const pvBlock)
+{
+    Queue_t *const pxQueue = (Queue_t *)xQueue;
+    void *pvDisplaced = NULL;
+
+    configASSERT(pxQueue->uxItemSize == sizeof(void *));
+    configASSERT(pxQueue->uxLength == 1);
+
+    /* Take out the block being overwritten, if any, so that it is handed
+    back to the caller rather than lost. */
+    taskENTER_CRITICAL();
+    {
+        if (pxQueue->uxMessagesWaiting > (UBaseType_t)0) {
+            prvCopyDataFromQueue(pxQueue, &pvDisplaced);
+            pxQueue->uxMessagesWaiting = 0;
+        }
+
+        (void)xQueueGenericSend(xQueue, &pvBlock, 0, queueOVERWRITE);
+    }
+    taskEXIT_CRITICAL();
+
+    return pvDisplaced;
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueReceiveFromISR(QueueHandle_t xQueue, void *const pvBuffer,
                                 BaseType_t *const pxHigherPriorityTaskWoken)
 {
@@ -1671,7 +1973,7 @@ void vQueueDelete(QueueHandle_t xQueue)
     {
         /* The queue can only have been allocated dynamically - free it
         again. */
-        vPortFree(pxQueue);
+        vObjectPoolFree(eQueuePool, pxQueue);
     }
 #elif ((configSUPPORT_DYNAMIC_ALLOCATION == 1) &&                              \
        (configSUPPORT_STATIC_ALLOCATION == 1))
@@ -1679,7 +1981,7 @@ void vQueueDelete(QueueHandle_t xQueue)
         /* The queue could have been allocated statically or dynamically, so
         check before attempting to free the memory. */
         if (pxQueue->ucStaticallyAllocated == (uint8_t)pdFALSE) {
-            vPortFree(pxQueue);
+            vObjectPoolFree(eQueuePool, pxQueue);
         }
         else {
             mtCOVERAGE_TEST_MARKER();
@@ -1824,6 +2126,90 @@ static void prvCopyDataFromQueue(Queue_t *const pxQueue, void *const pvBuffer)
 }
 /*-----------------------------------------------------------*/
 
+static void prvCopyDataToQueueMultiple(Queue_t *const pxQueue,
+                                       const void *pvItems,
+                                       const UBaseType_t uxCount)
+{
+    const size_t xBytes = (size_t)uxCount * (size_t)pxQueue->uxItemSize;
+    size_t xFirst = (size_t)(pxQueue->pcTail - pxQueue->pcWriteTo);
+
+    /* This function is called from a critical section. */
+
+    if (xFirst >= xBytes) {
+        (void)memcpy((void *)pxQueue->pcWriteTo, pvItems, xBytes);
+        pxQueue->pcWriteTo += xBytes;
+        if (pxQueue->pcWriteTo >= pxQueue->pcTail) {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+    }
+    else {
+        /* The items wrap around the end of the storage area. */
+        (void)memcpy((void *)pxQueue->pcWriteTo, pvItems, xFirst);
+        (void)memcpy((void *)pxQueue->pcHead,
+                     (const int8_t *)pvItems + xFirst, xBytes - xFirst);
+        pxQueue->pcWriteTo = pxQueue->pcHead + (xBytes - xFirst);
+    }
+
+    pxQueue->uxMessagesWaiting += uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataFromQueueMultiple(Queue_t *const pxQueue,
+                                         void *const pvBuffer,
+                                         const UBaseType_t uxCount)
+{
+    const size_t xBytes = (size_t)uxCount * (size_t)pxQueue->uxItemSize;
+    int8_t *pcFirst;
+    size_t xFirst;
+
+    /* This function is called from a critical section. */
+
+    if (uxCount == (UBaseType_t)0) {
+        return;
+    }
+
+    /* pcReadFrom points at the last item read, so the first item to read
+    is the one after it. */
+    pcFirst = pxQueue->u.pcReadFrom + pxQueue->uxItemSize;
+    if (pcFirst >= pxQueue->pcTail) {
+        pcFirst = pxQueue->pcHead;
+    }
+    xFirst = (size_t)(pxQueue->pcTail - pcFirst);
+
+    if (xFirst >= xBytes) {
+        (void)memcpy(pvBuffer, (void *)pcFirst, xBytes);
+        pxQueue->u.pcReadFrom = pcFirst + xBytes - pxQueue->uxItemSize;
+    }
+    else {
+        /* The items wrap around the end of the storage area. */
+        (void)memcpy(pvBuffer, (void *)pcFirst, xFirst);
+        (void)memcpy((int8_t *)pvBuffer + xFirst, (void *)pxQueue->pcHead,
+                     xBytes - xFirst);
+        pxQueue->u.pcReadFrom =
+            pxQueue->pcHead + (xBytes - xFirst) - pxQueue->uxItemSize;
+    }
+
+    pxQueue->uxMessagesWaiting -= uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockWaitingTasks(List_t *const pxEventList,
+                                         UBaseType_t uxCount)
+{
+    BaseType_t xYieldRequired = pdFALSE;
+
+    while ((uxCount > (UBaseType_t)0) &&
+           (listLIST_IS_EMPTY(pxEventList) == pdFALSE)) {
+        if (xTaskRemoveFromEventList(pxEventList) != pdFALSE) {
+            xYieldRequired = pdTRUE;
+        }
+        uxCount--;
+    }
+
+    return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue(Queue_t *const pxQueue)
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
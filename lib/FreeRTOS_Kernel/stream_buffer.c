@@ -0,0 +1,776 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+#if (configUSE_TASK_NOTIFICATIONS != 1)
+#error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
+#endif
+
+/* The reader only writes the tail and the writer only writes the head, each
+publishes its index with release semantics after copying the data, so that the
+other side sees the data, or the free space, before the index. */
+#define sbLOAD_ACQUIRE(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define sbSTORE_RELEASE(x, y) __atomic_store_n(&(x), (y), __ATOMIC_RELEASE)
+
+/* Orders the publication of an index before the check for a waiting task, and
+the registration of a waiting task before the check of the index, so that
+either the task sees the data or the other side sees the task. */
+#define sbFENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+/* Only one side may take a waiting task, so that it is notified once. */
+#define sbTAKE_WAITING_TASK(x) __atomic_exchange_n(&(x), NULL, __ATOMIC_SEQ_CST)
+
+/* The flags in ucFlags. */
+#define sbFLAGS_IS_MESSAGE_BUFFER ((uint8_t)1)
+#define sbFLAGS_IS_STATICALLY_ALLOCATED ((uint8_t)2)
+
+/* The stream buffer structure is followed by its storage, at the next aligned
+address. */
+#define sbHEADER_SIZE                                                           \
+    ((sizeof(StreamBuffer_t) + portBYTE_ALIGNMENT_MASK) &                      \
+     ~((size_t)portBYTE_ALIGNMENT_MASK))
+
+/* The storage has one byte more than the stream buffer holds, so that a full
+buffer can be told from an empty one by the indexes alone. */
+typedef struct StreamBufferDefinition {
+    volatile size_t xTail; /*< Index of the next byte to read. */
+    volatile size_t xHead; /*< Index of the next byte to write. */
+    size_t xLength;        /*< The size of the storage. */
+    size_t xTriggerLevelBytes; /*< Bytes needed to wake a waiting reader. */
+    volatile TaskHandle_t xTaskWaitingToReceive; /*< The reader, if blocked. */
+    volatile TaskHandle_t xTaskWaitingToSend;    /*< The writer, if blocked. */
+    uint8_t *pucBuffer;    /*< The storage. */
+    uint8_t ucFlags;       /*< The sbFLAGS_ that apply. */
+    struct StreamBufferDefinition *pxNext; /*< The next in pxStreamBuffers. */
+} StreamBuffer_t;
+
+/* All stream buffers, so that the interrupt raised by host threads can find
+the readers to wake. */
+PRIVILEGED_DATA static StreamBuffer_t *volatile pxStreamBuffers = NULL;
+
+/*
+ * Sets up a stream buffer whose storage of xBufferSizeBytes + 1 bytes starts at
+ * pucBuffer and adds it to pxStreamBuffers.
+ */
+static void prvInitialiseNewStreamBuffer(StreamBuffer_t *const pxStreamBuffer, uint8_t *const pucBuffer, size_t xBufferSizeBytes, size_t xTriggerLevelBytes, uint8_t ucFlags) PRIVILEGED_FUNCTION;
+
+/*
+ * The number of bytes that can be read, or written.
+ */
+static size_t prvBytesAvailable(const StreamBuffer_t *const pxStreamBuffer) PRIVILEGED_FUNCTION;
+static size_t prvSpacesAvailable(const StreamBuffer_t *const pxStreamBuffer) PRIVILEGED_FUNCTION;
+
+/*
+ * pdTRUE if the bytes available are enough to wake the reader, that is a
+ * whole message for message buffers and the trigger level for stream buffers.
+ */
+static BaseType_t prvReceiverReady(const StreamBuffer_t *const pxStreamBuffer) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies xCount bytes between the storage, starting at xIndex, and pucData.
+ * Return the index following the last byte copied.
+ */
+static size_t prvWriteBytes(StreamBuffer_t *const pxStreamBuffer, const uint8_t *pucData, size_t xCount, size_t xIndex) PRIVILEGED_FUNCTION;
+static size_t prvReadBytes(const StreamBuffer_t *const pxStreamBuffer, uint8_t *pucData, size_t xCount, size_t xIndex) PRIVILEGED_FUNCTION;
+
+/*
+ * Writes what fits of pvTxData, or nothing if a message does not fit whole,
+ * and publishes it.  Returns the number of data bytes written.
+ */
+static size_t prvWriteToBuffer(StreamBuffer_t *const pxStreamBuffer, const void *pvTxData, size_t xDataLengthBytes) PRIVILEGED_FUNCTION;
+
+/*
+ * Reads up to xBufferLengthBytes bytes, or the next message if it fits, and
+ * publishes the space freed.  Returns the number of data bytes read.
+ */
+static size_t prvReadFromBuffer(StreamBuffer_t *const pxStreamBuffer, void *pvRxData, size_t xBufferLengthBytes) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task on its notification state, for up to xTicksToWait,
+ * unless pxAvailable() already returns at least xNeeded.
+ */
+static void prvWaitFor(StreamBuffer_t *const pxStreamBuffer, volatile TaskHandle_t *pxWaitingTask, size_t (*pxAvailable)(const StreamBuffer_t *const), size_t xNeeded, TickType_t xTicksToWait) PRIVILEGED_FUNCTION;
+
+/*
+ * Wakes the reader on behalf of a host thread.
+ */
+static uint32_t prvStreamBufferInterruptHandler(void) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+
+StreamBufferHandle_t xStreamBufferGenericCreate(size_t xBufferSizeBytes,
+                                                size_t xTriggerLevelBytes,
+                                                BaseType_t xIsMessageBuffer)
+{
+    StreamBuffer_t *pxStreamBuffer;
+
+    pxStreamBuffer = (StreamBuffer_t *)pvPortMalloc(sbHEADER_SIZE +
+                                                    xBufferSizeBytes + 1);
+    if (pxStreamBuffer == NULL) {
+        return NULL;
+    }
+
+    prvInitialiseNewStreamBuffer(pxStreamBuffer,
+                                 (uint8_t *)pxStreamBuffer + sbHEADER_SIZE,
+                                 xBufferSizeBytes, xTriggerLevelBytes,
+                                 (xIsMessageBuffer != pdFALSE) ?
+                                 sbFLAGS_IS_MESSAGE_BUFFER : (uint8_t)0);
+
+    return (StreamBufferHandle_t)pxStreamBuffer;
+}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+
+StreamBufferHandle_t xStreamBufferGenericCreateStatic(
+    size_t xBufferSizeBytes, size_t xTriggerLevelBytes,
+    BaseType_t xIsMessageBuffer, uint8_t *const pucStreamBufferStorageArea,
+    StaticStreamBuffer_t *const pxStaticStreamBuffer)
+{
+    StreamBuffer_t *const pxStreamBuffer =
+        (StreamBuffer_t *)pxStaticStreamBuffer;
+
+    /* The dummy structure must be the size of the real one. */
+    configASSERT(sizeof(StaticStreamBuffer_t) == sizeof(StreamBuffer_t));
+
+    if ((pucStreamBufferStorageArea == NULL) ||
+        (pxStaticStreamBuffer == NULL)) {
+        return NULL;
+    }
+
+    prvInitialiseNewStreamBuffer(pxStreamBuffer, pucStreamBufferStorageArea,
+                                 xBufferSizeBytes, xTriggerLevelBytes,
+                                 ((xIsMessageBuffer != pdFALSE) ?
+                                  sbFLAGS_IS_MESSAGE_BUFFER : (uint8_t)0) |
+                                 sbFLAGS_IS_STATICALLY_ALLOCATED);
+
+    return (StreamBufferHandle_t)pxStreamBuffer;
+}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewStreamBuffer(StreamBuffer_t *const pxStreamBuffer,
+                                         uint8_t *const pucBuffer,
+                                         size_t xBufferSizeBytes,
+                                         size_t xTriggerLevelBytes,
+                                         uint8_t ucFlags)
+{
+    if ((ucFlags & sbFLAGS_IS_MESSAGE_BUFFER) != 0) {
+        /* A message buffer must hold at least a length and a byte. */
+        configASSERT(xBufferSizeBytes >
+                     sizeof(configMESSAGE_BUFFER_LENGTH_TYPE));
+    }
+    else {
+        configASSERT(xBufferSizeBytes > (size_t)0);
+    }
+    configASSERT(xTriggerLevelBytes <= xBufferSizeBytes);
+
+    if (xTriggerLevelBytes == (size_t)0) {
+        xTriggerLevelBytes = (size_t)1;
+    }
+
+    memset(pxStreamBuffer, 0x00, sizeof(StreamBuffer_t));
+    pxStreamBuffer->pucBuffer = pucBuffer;
+    pxStreamBuffer->xLength = xBufferSizeBytes + 1;
+    pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+    pxStreamBuffer->ucFlags = ucFlags;
+
+    vPortSetInterruptHandler(configSTREAM_BUFFER_INTERRUPT,
+                             prvStreamBufferInterruptHandler);
+
+    taskENTER_CRITICAL();
+    {
+        pxStreamBuffer->pxNext = pxStreamBuffers;
+        pxStreamBuffers = pxStreamBuffer;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vStreamBufferDelete(StreamBufferHandle_t xStreamBuffer)
+{
+    StreamBuffer_t *const pxStreamBuffer = (StreamBuffer_t *)xStreamBuffer;
+    StreamBuffer_t *volatile *ppxLink;
+
+    configASSERT(pxStreamBuffer);
+    configASSERT(pxStreamBuffer->xTaskWaitingToReceive == NULL);
+    configASSERT(pxStreamBuffer->xTaskWaitingToSend == NULL);
+
+    taskENTER_CRITICAL();
+    {
+        for (ppxLink = &pxStreamBuffers; *ppxLink != NULL;
+             ppxLink = &(*ppxLink)->pxNext) {
+            if (*ppxLink == pxStreamBuffer) {
+                *ppxLink = pxStreamBuffer->pxNext;
+                break;
+            }
+        }
+    }
+    taskEXIT_CRITICAL();
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    if ((pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED) == 0) {
+        vPortFree(pxStreamBuffer);
+    }
+    else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferReset(StreamBufferHandle_t xStreamBuffer)
+{
+    StreamBuffer_t *const pxStreamBuffer = (StreamBuffer_t *)xStreamBuffer;
+    BaseType_t xReturn = pdFAIL;
+
+    configASSERT(pxStreamBuffer);
+
+    taskENTER_CRITICAL();
+    {
+        if ((pxStreamBuffer->xTaskWaitingToReceive == NULL) &&
+            (pxStreamBuffer->xTaskWaitingToSend == NULL)) {
+            sbSTORE_RELEASE(pxStreamBuffer->xHead, (size_t)0);
+            sbSTORE_RELEASE(pxStreamBuffer->xTail, (size_t)0);
+            xReturn = pdPASS;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferSetTriggerLevel(StreamBufferHandle_t xStreamBuffer,
+                                        size_t xTriggerLevel)
+{
+    StreamBuffer_t *const pxStreamBuffer = (StreamBuffer_t *)xStreamBuffer;
+
+    configASSERT(pxStreamBuffer);
+
+    if (xTriggerLevel == (size_t)0) {
+        xTriggerLevel = (size_t)1;
+    }
+
+    if (xTriggerLevel >= pxStreamBuffer->xLength) {
+        return pdFAIL;
+    }
+
+    pxStreamBuffer->xTriggerLevelBytes = xTriggerLevel;
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSpacesAvailable(StreamBufferHandle_t xStreamBuffer)
+{
+    configASSERT(xStreamBuffer);
+
+    return prvSpacesAvailable((StreamBuffer_t *)xStreamBuffer);
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferBytesAvailable(StreamBufferHandle_t xStreamBuffer)
+{
+    configASSERT(xStreamBuffer);
+
+    return prvBytesAvailable((StreamBuffer_t *)xStreamBuffer);
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsFull(StreamBufferHandle_t xStreamBuffer)
+{
+    StreamBuffer_t *const pxStreamBuffer = (StreamBuffer_t *)xStreamBuffer;
+    size_t xMinimum = (size_t)0;
+
+    configASSERT(pxStreamBuffer);
+
+    /* A message buffer that cannot take a length is full. */
+    if ((pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER) != 0) {
+        xMinimum = sizeof(configMESSAGE_BUFFER_LENGTH_TYPE);
+    }
+
+    return (prvSpacesAvailable(pxStreamBuffer) <= xMinimum) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsEmpty(StreamBufferHandle_t xStreamBuffer)
+{
+    configASSERT(xStreamBuffer);
+
+    return (prvBytesAvailable((StreamBuffer_t *)xStreamBuffer) == (size_t)0)
+               ? pdTRUE
+               : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferNextMessageLengthBytes(StreamBufferHandle_t xStreamBuffer)
+{
+    StreamBuffer_t *const pxStreamBuffer = (StreamBuffer_t *)xStreamBuffer;
+    configMESSAGE_BUFFER_LENGTH_TYPE xLength;
+
+    configASSERT(pxStreamBuffer);
+    configASSERT((pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER) != 0);
+
+    if (prvBytesAvailable(pxStreamBuffer) == (size_t)0) {
+        return 0;
+    }
+
+    (void)prvReadBytes(pxStreamBuffer, (uint8_t *)&xLength, sizeof(xLength),
+                       pxStreamBuffer->xTail);
+    return (size_t)xLength;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSend(StreamBufferHandle_t xStreamBuffer,
+                         const void *pvTxData, size_t xDataLengthBytes,
+                         TickType_t xTicksToWait)
+{
+    StreamBuffer_t *const pxStreamBuffer = (StreamBuffer_t *)xStreamBuffer;
+    size_t xRequired = xDataLengthBytes, xSent;
+    TaskHandle_t xReceiver;
+    TimeOut_t xTimeOut;
+
+    configASSERT(pxStreamBuffer);
+    configASSERT(pvTxData);
+
+    /* Wait for space for the whole message, or for as much of the stream as
+    the buffer can ever hold. */
+    if ((pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER) != 0) {
+        xRequired += sizeof(configMESSAGE_BUFFER_LENGTH_TYPE);
+        if (xRequired >= pxStreamBuffer->xLength) {
+            return 0;
+        }
+    }
+    else if (xRequired >= pxStreamBuffer->xLength) {
+        xRequired = pxStreamBuffer->xLength - 1;
+    }
+
+    if (xTicksToWait != (TickType_t)0) {
+        vTaskSetTimeOutState(&xTimeOut);
+        while ((prvSpacesAvailable(pxStreamBuffer) < xRequired) &&
+               (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) == pdFALSE)) {
+            prvWaitFor(pxStreamBuffer, &pxStreamBuffer->xTaskWaitingToSend,
+                       prvSpacesAvailable, xRequired, xTicksToWait);
+        }
+    }
+
+    xSent = prvWriteToBuffer(pxStreamBuffer, pvTxData, xDataLengthBytes);
+
+    if ((xSent > (size_t)0) && (prvReceiverReady(pxStreamBuffer) != pdFALSE)) {
+        xReceiver = sbTAKE_WAITING_TASK(pxStreamBuffer->xTaskWaitingToReceive);
+        if (xReceiver != NULL) {
+            (void)xTaskNotify(xReceiver, 0, eNoAction);
+        }
+    }
+
+    return xSent;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromISR(StreamBufferHandle_t xStreamBuffer,
+                                const void *pvTxData,
+                                size_t xDataLengthBytes,
+                                BaseType_t *const pxHigherPriorityTaskWoken)
+{
+    StreamBuffer_t *const pxStreamBuffer = (StreamBuffer_t *)xStreamBuffer;
+    size_t xSent;
+    TaskHandle_t xReceiver;
+
+    configASSERT(pxStreamBuffer);
+    configASSERT(pvTxData);
+
+    xSent = prvWriteToBuffer(pxStreamBuffer, pvTxData, xDataLengthBytes);
+
+    if ((xSent > (size_t)0) && (prvReceiverReady(pxStreamBuffer) != pdFALSE)) {
+        xReceiver = sbTAKE_WAITING_TASK(pxStreamBuffer->xTaskWaitingToReceive);
+        if (xReceiver != NULL) {
+            (void)xTaskNotifyFromISR(xReceiver, 0, eNoAction,
+                                     pxHigherPriorityTaskWoken);
+        }
+    }
+
+    return xSent;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendFromHost(StreamBufferHandle_t xStreamBuffer,
+                                 const void *pvTxData, size_t xDataLengthBytes)
+{
+    StreamBuffer_t *const pxStreamBuffer = (StreamBuffer_t *)xStreamBuffer;
+    size_t xSent;
+
+    configASSERT(pxStreamBuffer);
+    configASSERT(pvTxData);
+
+    xSent = prvWriteToBuffer(pxStreamBuffer, pvTxData, xDataLengthBytes);
+
+    /* The reader is woken from the interrupt, host threads must not call into
+    the kernel. */
+    sbFENCE();
+    if ((xSent > (size_t)0) &&
+        (pxStreamBuffer->xTaskWaitingToReceive != NULL) &&
+        (prvReceiverReady(pxStreamBuffer) != pdFALSE)) {
+        vPortGenerateSimulatedInterrupt(configSTREAM_BUFFER_INTERRUPT);
+    }
+
+    return xSent;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceive(StreamBufferHandle_t xStreamBuffer,
+                            void *pvRxData, size_t xBufferLengthBytes,
+                            TickType_t xTicksToWait)
+{
+    StreamBuffer_t *const pxStreamBuffer = (StreamBuffer_t *)xStreamBuffer;
+    size_t xNeeded = (size_t)1, xTriggerLevel, xReceived;
+    TaskHandle_t xSender;
+    TimeOut_t xTimeOut;
+
+    configASSERT(pxStreamBuffer);
+    configASSERT(pvRxData);
+
+    /* A message is available once its length is, it is published whole. */
+    xTriggerLevel = pxStreamBuffer->xTriggerLevelBytes;
+    if ((pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER) != 0) {
+        xNeeded = sizeof(configMESSAGE_BUFFER_LENGTH_TYPE);
+        xTriggerLevel = xNeeded;
+    }
+
+    /* Only wait while the buffer is empty, a trigger level above a single
+    byte only delays when a waiting reader is woken. */
+    if (xTicksToWait != (TickType_t)0) {
+        vTaskSetTimeOutState(&xTimeOut);
+        while ((prvBytesAvailable(pxStreamBuffer) < xNeeded) &&
+               (xTaskCheckForTimeOut(&xTimeOut, &xTicksToWait) == pdFALSE)) {
+            prvWaitFor(pxStreamBuffer,
+                       &pxStreamBuffer->xTaskWaitingToReceive,
+                       prvBytesAvailable, xTriggerLevel, xTicksToWait);
+        }
+    }
+
+    xReceived = prvReadFromBuffer(pxStreamBuffer, pvRxData,
+                                  xBufferLengthBytes);
+
+    if (xReceived > (size_t)0) {
+        xSender = sbTAKE_WAITING_TASK(pxStreamBuffer->xTaskWaitingToSend);
+        if (xSender != NULL) {
+            (void)xTaskNotify(xSender, 0, eNoAction);
+        }
+    }
+
+    return xReceived;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveFromISR(StreamBufferHandle_t xStreamBuffer,
+                                   void *pvRxData, size_t xBufferLengthBytes,
+                                   BaseType_t *const pxHigherPriorityTaskWoken)
+{
+    StreamBuffer_t *const pxStreamBuffer = (StreamBuffer_t *)xStreamBuffer;
+    size_t xReceived;
+    TaskHandle_t xSender;
+
+    configASSERT(pxStreamBuffer);
+    configASSERT(pvRxData);
+
+    xReceived = prvReadFromBuffer(pxStreamBuffer, pvRxData,
+                                  xBufferLengthBytes);
+
+    if (xReceived > (size_t)0) {
+        xSender = sbTAKE_WAITING_TASK(pxStreamBuffer->xTaskWaitingToSend);
+        if (xSender != NULL) {
+            (void)xTaskNotifyFromISR(xSender, 0, eNoAction,
+                                     pxHigherPriorityTaskWoken);
+        }
+    }
+
+    return xReceived;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitFor(StreamBuffer_t *const pxStreamBuffer,
+                       volatile TaskHandle_t *pxWaitingTask,
+                       size_t (*pxAvailable)(const StreamBuffer_t *const),
+                       size_t xNeeded, TickType_t xTicksToWait)
+{
+    BaseType_t xShouldBlock;
+
+    taskENTER_CRITICAL();
+    {
+        /* Notifications left over from an earlier wait are stale. */
+        (void)xTaskNotifyStateClear(NULL);
+
+        /* There may only be one reader and one writer. */
+        configASSERT(*pxWaitingTask == NULL);
+        *pxWaitingTask = xTaskGetCurrentTaskHandle();
+
+        /* The other side may not run the kernel, so check again now that it
+        can see this task waiting. */
+        sbFENCE();
+        xShouldBlock = (pxAvailable(pxStreamBuffer) < xNeeded) ? pdTRUE
+                                                               : pdFALSE;
+        if (xShouldBlock == pdFALSE) {
+            (void)sbTAKE_WAITING_TASK(*pxWaitingTask);
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    if (xShouldBlock != pdFALSE) {
+        (void)xTaskNotifyWait((uint32_t)0, (uint32_t)0, NULL, xTicksToWait);
+        (void)sbTAKE_WAITING_TASK(*pxWaitingTask);
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvStreamBufferInterruptHandler(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    UBaseType_t uxSavedInterruptStatus;
+    StreamBuffer_t *pxStreamBuffer;
+    TaskHandle_t xReceiver;
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        for (pxStreamBuffer = pxStreamBuffers; pxStreamBuffer != NULL;
+             pxStreamBuffer = pxStreamBuffer->pxNext) {
+            if ((pxStreamBuffer->xTaskWaitingToReceive != NULL) &&
+                (prvReceiverReady(pxStreamBuffer) != pdFALSE)) {
+                xReceiver = sbTAKE_WAITING_TASK(
+                    pxStreamBuffer->xTaskWaitingToReceive);
+                if (xReceiver != NULL) {
+                    (void)xTaskNotifyFromISR(xReceiver, 0, eNoAction,
+                                             &xHigherPriorityTaskWoken);
+                }
+            }
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(uxSavedInterruptStatus);
+
+    return (uint32_t)xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteToBuffer(StreamBuffer_t *const pxStreamBuffer,
+                               const void *pvTxData, size_t xDataLengthBytes)
+{
+    configMESSAGE_BUFFER_LENGTH_TYPE xLength;
+    size_t xSpace = prvSpacesAvailable(pxStreamBuffer);
+    size_t xHead = pxStreamBuffer->xHead;
+
+    if ((pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER) != 0) {
+        if ((xSpace < sizeof(xLength)) ||
+            (xSpace - sizeof(xLength) < xDataLengthBytes)) {
+            return 0;
+        }
+        xLength = (configMESSAGE_BUFFER_LENGTH_TYPE)xDataLengthBytes;
+        xHead = prvWriteBytes(pxStreamBuffer, (const uint8_t *)&xLength,
+                              sizeof(xLength), xHead);
+    }
+    else if (xDataLengthBytes > xSpace) {
+        xDataLengthBytes = xSpace;
+    }
+
+    if (xDataLengthBytes == (size_t)0) {
+        return 0;
+    }
+
+    xHead = prvWriteBytes(pxStreamBuffer, (const uint8_t *)pvTxData,
+                          xDataLengthBytes, xHead);
+    sbSTORE_RELEASE(pxStreamBuffer->xHead, xHead);
+
+    return xDataLengthBytes;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadFromBuffer(StreamBuffer_t *const pxStreamBuffer,
+                                void *pvRxData, size_t xBufferLengthBytes)
+{
+    configMESSAGE_BUFFER_LENGTH_TYPE xLength;
+    size_t xAvailable = prvBytesAvailable(pxStreamBuffer);
+    size_t xTail = pxStreamBuffer->xTail;
+
+    if ((pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER) != 0) {
+        if (xAvailable < sizeof(xLength)) {
+            return 0;
+        }
+        /* A message that does not fit is left for a larger buffer. */
+        xTail = prvReadBytes(pxStreamBuffer, (uint8_t *)&xLength,
+                             sizeof(xLength), xTail);
+        if ((size_t)xLength > xBufferLengthBytes) {
+            return 0;
+        }
+        xAvailable = (size_t)xLength;
+    }
+
+    if (xAvailable > xBufferLengthBytes) {
+        xAvailable = xBufferLengthBytes;
+    }
+
+    xTail = prvReadBytes(pxStreamBuffer, (uint8_t *)pvRxData, xAvailable,
+                         xTail);
+    sbSTORE_RELEASE(pxStreamBuffer->xTail, xTail);
+
+    return xAvailable;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytes(StreamBuffer_t *const pxStreamBuffer,
+                            const uint8_t *pucData, size_t xCount,
+                            size_t xIndex)
+{
+    size_t xFirst = pxStreamBuffer->xLength - xIndex;
+
+    /* Wrap around at most once, in two copies. */
+    if (xFirst > xCount) {
+        xFirst = xCount;
+    }
+    memcpy(&pxStreamBuffer->pucBuffer[xIndex], pucData, xFirst);
+    memcpy(pxStreamBuffer->pucBuffer, pucData + xFirst, xCount - xFirst);
+
+    xIndex += xCount;
+    if (xIndex >= pxStreamBuffer->xLength) {
+        xIndex -= pxStreamBuffer->xLength;
+    }
+
+    return xIndex;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytes(const StreamBuffer_t *const pxStreamBuffer,
+                           uint8_t *pucData, size_t xCount, size_t xIndex)
+{
+    size_t xFirst = pxStreamBuffer->xLength - xIndex;
+
+    if (xFirst > xCount) {
+        xFirst = xCount;
+    }
+    memcpy(pucData, &pxStreamBuffer->pucBuffer[xIndex], xFirst);
+    memcpy(pucData + xFirst, pxStreamBuffer->pucBuffer, xCount - xFirst);
+
+    xIndex += xCount;
+    if (xIndex >= pxStreamBuffer->xLength) {
+        xIndex -= pxStreamBuffer->xLength;
+    }
+
+    return xIndex;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesAvailable(const StreamBuffer_t *const pxStreamBuffer)
+{
+    size_t xCount = pxStreamBuffer->xLength +
+                    sbLOAD_ACQUIRE(pxStreamBuffer->xHead) -
+                    sbLOAD_ACQUIRE(pxStreamBuffer->xTail);
+
+    if (xCount >= pxStreamBuffer->xLength) {
+        xCount -= pxStreamBuffer->xLength;
+    }
+
+    return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvSpacesAvailable(const StreamBuffer_t *const pxStreamBuffer)
+{
+    return pxStreamBuffer->xLength - 1 - prvBytesAvailable(pxStreamBuffer);
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReceiverReady(const StreamBuffer_t *const pxStreamBuffer)
+{
+    size_t xNeeded = pxStreamBuffer->xTriggerLevelBytes;
+
+    if ((pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER) != 0) {
+        xNeeded = sizeof(configMESSAGE_BUFFER_LENGTH_TYPE);
+    }
+
+    return (prvBytesAvailable(pxStreamBuffer) >= xNeeded) ? pdTRUE : pdFALSE;
+}
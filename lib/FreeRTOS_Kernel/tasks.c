@@ -81,6 +81,7 @@ task.h is included from an application file. */
 #include "task.h"
 #include "timers.h"
 #include "StackMacros.h"
+#include "object_pool.h"
 
 /* Lint e961 and e750 are suppressed as a MISRA exception justified because the
 MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
@@ -145,6 +146,12 @@ a statically allocated stack and a dynamically allocated TCB. */
 #define tskDELETED_CHAR     ( 'D' )
 #define tskSUSPENDED_CHAR   ( 'S' )
 
+#if ( configNUMBER_OF_CORES > 1 )
+/* Value of the xTaskRunState member of a TCB whose task is not running on any
+core. */
+#define taskTASK_NOT_RUNNING    ( ( BaseType_t ) -1 )
+#endif
+
 /*
  * Some kernel aware debuggers require the data the debugger needs access to be
  * global, rather than file scope.
@@ -234,6 +241,23 @@ or suspended list then it won't be in a ready list. */
 
 /*-----------------------------------------------------------*/
 
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/* The delayed task wheel counts the ticks modulo the tick count range, so there
+are no lists to switch when the tick count overflows.  xNextTaskUnblockTime
+only holds wake times up to the overflow though, as for the delayed lists, and
+is recalculated once the tick count has overflowed. */
+#define taskSWITCH_DELAYED_LISTS()                                                                  \
+    {                                                                                                   \
+        xNumOfOverflows++;                                                                              \
+        prvResetNextTaskUnblockTime();                                                                  \
+    }
+
+#define taskLIST_IS_DELAYED_LIST( pxList )                                                          \
+    ( ( ( pxList ) >= &( xDelayedTaskWheel[ 0 ] ) ) && ( ( pxList ) < &( xDelayedTaskWheel[ taskWHEEL_LEVELS * taskWHEEL_SLOTS ] ) ) )
+
+#else
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
 count overflows. */
 #define taskSWITCH_DELAYED_LISTS()                                                                  \
@@ -250,6 +274,11 @@ count overflows. */
         prvResetNextTaskUnblockTime();                                                                  \
     }
 
+#define taskLIST_IS_DELAYED_LIST( pxList )                                                          \
+    ( ( ( pxList ) == pxDelayedTaskList ) || ( ( pxList ) == pxOverflowDelayedTaskList ) )
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -260,7 +289,29 @@ count overflows. */
     traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                        \
     taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                             \
     vListInsertEnd( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
-    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                   \
+    taskYIELD_ANY_CORE_FOR_TASK( pxTCB )
+/*-----------------------------------------------------------*/
+
+/*
+ * With more than one core a task that becomes ready preempts the core running
+ * the lowest priority task, if that is of lower priority than the task.
+ */
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+#define taskYIELD_ANY_CORE_FOR_TASK( pxTCB ) prvYieldForTask( pxTCB )
+#else
+#define taskYIELD_ANY_CORE_FOR_TASK( pxTCB )
+#endif
+
+/*
+ * Whether the calling core has to yield for a task it has made ready, which
+ * with more than one core prvYieldForTask() has already decided.
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+#define taskYIELD_REQUIRED_FOR( pxTCB ) ( xYieldPending != pdFALSE )
+#else
+#define taskYIELD_REQUIRED_FOR( pxTCB ) ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -300,6 +351,9 @@ typedef struct tskTaskControlBlock {
     ListItem_t          xStateListItem; /*< The list that the state list item of a task is reference from denotes the state of that task (Ready, Blocked, Suspended ). */
     ListItem_t          xEventListItem;     /*< Used to reference a task from an event list. */
     UBaseType_t         uxPriority;         /*< The priority of the task.  0 is the lowest priority. */
+#if ( configNUMBER_OF_CORES > 1 )
+    volatile BaseType_t xTaskRunState;      /*< The core the task is running on, or taskTASK_NOT_RUNNING. */
+#endif
     StackType_t         *pxStack;           /*< Points to the start of the stack. */
     char                pcTaskName[ configMAX_TASK_NAME_LEN ];/*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
@@ -330,7 +384,7 @@ typedef struct tskTaskControlBlock {
 #endif
 
 #if( configGENERATE_RUN_TIME_STATS == 1 )
-    uint32_t        ulRunTimeCounter;   /*< Stores the amount of time the task has spent in the Running state. */
+    configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /*< Stores the amount of time the task has spent in the Running state. */
 #endif
 
 #if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -368,14 +422,43 @@ typedef tskTCB TCB_t;
 /*lint -e956 A manual analysis and inspection has been used to determine which
 static variables must be declared volatile. */
 
+#if ( configNUMBER_OF_CORES == 1 )
 PRIVILEGED_DATA TCB_t *volatile pxCurrentTCB = NULL;
+#else
+/* The task running on each core.  A task can move to another core whenever
+it is switched out, so the current TCB is only read with the interrupts of
+the calling core masked. */
+PRIVILEGED_DATA TCB_t *volatile pxCurrentTCBs[ configNUMBER_OF_CORES ];
+#define pxCurrentTCB ( ( TCB_t * ) xTaskGetCurrentTaskHandle() )
+#endif
 
 /* Lists for ready and blocked tasks. --------------------*/
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/* The delayed tasks are referenced from a hierarchical timing wheel rather
+than from sorted lists, so blocking and unblocking a task does not depend on
+the number of delayed tasks.  A slot of level n spans taskWHEEL_SLOTS^n ticks,
+a task is appended to the slot of its wake time on the lowest level that spans
+the time to it, and the slots of the upper levels are cascaded down a level
+once the wheel time reaches them. */
+#define taskWHEEL_BITS      ( 6 )
+#define taskWHEEL_SLOTS     ( 1 << taskWHEEL_BITS )
+#define taskWHEEL_MASK      ( ( UBaseType_t ) taskWHEEL_SLOTS - 1 )
+#define taskWHEEL_LEVELS    ( ( ( sizeof( TickType_t ) * 8 ) + taskWHEEL_BITS - 1 ) / taskWHEEL_BITS )
+
+PRIVILEGED_DATA static List_t xDelayedTaskWheel[ taskWHEEL_LEVELS * taskWHEEL_SLOTS ];  /*< Delayed tasks, the slots of each level in turn. */
+PRIVILEGED_DATA static uint64_t ullDelayedTaskWheelOccupied[ taskWHEEL_LEVELS ];     /*< A bit per slot that may reference delayed tasks.  Cleared lazily, as tasks leave the slots wherever they are unblocked. */
+PRIVILEGED_DATA static TickType_t xDelayedTaskWheelTime = (TickType_t) 0U;            /*< The next tick the wheel has to process. */
+
+#else
+
 PRIVILEGED_DATA static List_t xDelayedTaskList1;                        /*< Delayed tasks. */
 PRIVILEGED_DATA static List_t xDelayedTaskList2;                        /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t *volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
 PRIVILEGED_DATA static List_t *volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 PRIVILEGED_DATA static List_t xPendingReadyList;                        /*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if( INCLUDE_vTaskDelete == 1 )
@@ -397,11 +480,21 @@ PRIVILEGED_DATA static volatile TickType_t xTickCount               = (TickType_
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority      = tskIDLE_PRIORITY;
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning        = pdFALSE;
 PRIVILEGED_DATA static volatile UBaseType_t uxPendedTicks           = (UBaseType_t) 0U;
+#if ( configNUMBER_OF_CORES == 1 )
 PRIVILEGED_DATA static volatile BaseType_t xYieldPending            = pdFALSE;
+#else
+PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ];
+#define xYieldPending xYieldPendings[ portGET_CORE_ID() ]
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows          = (BaseType_t) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber                     = (UBaseType_t) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime     = (TickType_t) 0U;   /* Initialised to portMAX_DELAY before the scheduler starts. */
+#if ( configNUMBER_OF_CORES == 1 )
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle                 = NULL;         /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#else
+PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ];      /*< One idle task per core, only the first calls the idle hook. */
+#define xIdleTaskHandle xIdleTaskHandles[ 0 ]
+#endif
 
 /* Context switches are held pending while the scheduler is suspended.  Also,
 interrupts must not manipulate the xStateListItem of a TCB, or any of the
@@ -415,8 +508,13 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended    = (UBaseType
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL; /*< Holds the value of a timer/counter the last time a task was switched in. */
-PRIVILEGED_DATA static uint32_t ulTotalRunTime = 0UL;       /*< Holds the total amount of execution time as defined by the run time counter clock. */
+#if ( configNUMBER_OF_CORES == 1 )
+PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL; /*< Holds the value of a timer/counter the last time a task was switched in. */
+#else
+PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTimes[ configNUMBER_OF_CORES ];
+#define ulTaskSwitchedInTime ulTaskSwitchedInTimes[ portGET_CORE_ID() ]
+#endif
+PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL;       /*< Holds the total amount of execution time as defined by the run time counter clock. */
 
 #endif
 
@@ -435,6 +533,11 @@ extern void vApplicationTickHook(void);
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
 extern void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize);
+#if( configNUMBER_OF_CORES > 1 )
+/* Called for the idle task of each core but the first, with xPassiveIdleTaskIndex
+counting from 0 for core 1. */
+extern void vApplicationGetPassiveIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex);
+#endif
 #endif
 
 /* File private functions. --------------------------------*/
@@ -467,6 +570,40 @@ static void prvInitialiseTaskLists(void) PRIVILEGED_FUNCTION;
  */
 static portTASK_FUNCTION_PROTO(prvIdleTask, pvParameters);
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * The idle task of every core but the first.  It frees deleted tasks like
+ * prvIdleTask() but does not call the idle hook.
+ */
+static portTASK_FUNCTION_PROTO(prvPassiveIdleTask, pvParameters);
+
+/*
+ * Selects the task that core xCoreID runs next: the highest priority ready
+ * task that is not running on another core.  Tasks of equal priority are
+ * selected in turn.
+ */
+static void prvSelectHighestPriorityTask(BaseType_t xCoreID) PRIVILEGED_FUNCTION;
+
+/*
+ * Makes core xCoreID select a task to run, at once if it is the calling core
+ * once the critical section is left.
+ */
+static void prvYieldCore(BaseType_t xCoreID) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when pxTCB has become ready, yields the core running the lowest
+ * priority task if that is of lower priority than pxTCB.
+ */
+static void prvYieldForTask(const TCB_t *pxTCB) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if pxTCB is the idle task of one of the cores.
+ */
+static BaseType_t prvIsIdleTask(const TCB_t *pxTCB) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES */
+
 /*
  * Utility to free all memory allocated by the scheduler to hold a TCB,
  * including the stack pointed to by the TCB.
@@ -522,7 +659,7 @@ static TCB_t *prvSearchForNameWithinSingleList(List_t *pxList, const char pcName
  * This function determines the 'high water mark' of the task stack by
  * determining how much of the stack remains at the original preset value.
  */
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+#if ( ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) && !defined( portGET_STACK_HIGH_WATER_MARK ) )
 
 static uint16_t prvTaskCheckFreeStackSpace(const uint8_t *pucStackByte) PRIVILEGED_FUNCTION;
 
@@ -549,6 +686,31 @@ static TickType_t prvGetExpectedIdleTime(void) PRIVILEGED_FUNCTION;
  */
 static void prvResetNextTaskUnblockTime(void);
 
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/*
+ * Append the task to the slot of the delayed task wheel that holds the wake
+ * time its state list item is set to, relative to the wheel time.
+ */
+static void prvInsertTaskInDelayedTaskWheel(TCB_t *const pxTCB) PRIVILEGED_FUNCTION;
+
+/*
+ * Set *pxNextTime to the next tick at which the delayed task wheel has to be
+ * processed, that is the wake time of the first occupied level 0 slot or the
+ * time at which the first occupied slot of an upper level has to be cascaded.
+ * Returns pdFALSE if no task is delayed.
+ */
+static BaseType_t prvGetNextDelayedTaskWheelTime(TickType_t *const pxNextTime) PRIVILEGED_FUNCTION;
+
+/*
+ * Advance the delayed task wheel up to xTimeNow, and return the next task
+ * whose wake time has been reached, or NULL once there is none.  The task is
+ * left in the wheel for the caller to remove.
+ */
+static TCB_t *prvGetDelayedTaskToUnblock(const TickType_t xTimeNow) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 /*
@@ -561,16 +723,18 @@ static char *prvWriteNameToBuffer(char *pcBuffer, const char *pcTaskName) PRIVIL
 
 /*
  * Called after a Task_t structure has been allocated either statically or
- * dynamically to fill in the structure's members.
+ * dynamically to fill in the structure's members.  Returns pdFAIL if the port
+ * could not create the task's context, in which case the task must not be
+ * added to the ready list.
  */
-static void prvInitialiseNewTask(TaskFunction_t pxTaskCode,
-                                 const char *const pcName,
-                                 const uint32_t ulStackDepth,
-                                 void *const pvParameters,
-                                 UBaseType_t uxPriority,
-                                 TaskHandle_t *const pxCreatedTask,
-                                 TCB_t *pxNewTCB,
-                                 const MemoryRegion_t *const xRegions) PRIVILEGED_FUNCTION;   /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+static BaseType_t prvInitialiseNewTask(TaskFunction_t pxTaskCode,
+                                       const char *const pcName,
+                                       const uint32_t ulStackDepth,
+                                       void *const pvParameters,
+                                       UBaseType_t uxPriority,
+                                       TaskHandle_t *const pxCreatedTask,
+                                       TCB_t *pxNewTCB,
+                                       const MemoryRegion_t *const xRegions) PRIVILEGED_FUNCTION;   /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 
 /*
  * Called after a new task has been created and initialised to place the task
@@ -591,7 +755,7 @@ TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode,
                                StaticTask_t *const pxTaskBuffer)   /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 {
     TCB_t *pxNewTCB;
-    TaskHandle_t xReturn;
+    TaskHandle_t xReturn = NULL;
 
     configASSERT(puxStackBuffer != NULL);
     configASSERT(pxTaskBuffer != NULL);
@@ -610,8 +774,14 @@ TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode,
         }
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 
-        prvInitialiseNewTask(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL);
-        prvAddNewTaskToReadyList(pxNewTCB);
+        if (prvInitialiseNewTask(pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL) != pdFAIL) {
+            prvAddNewTaskToReadyList(pxNewTCB);
+        }
+        else {
+            /* The buffers belong to the application, which may use them
+            again. */
+            traceTASK_CREATE_FAILED();
+        }
     }
     else {
         xReturn = NULL;
@@ -636,7 +806,7 @@ BaseType_t xTaskCreateRestricted(const TaskParameters_t *const pxTaskDefinition,
         /* Allocate space for the TCB.  Where the memory comes from depends
         on the implementation of the port malloc function and whether or
         not static allocation is being used. */
-        pxNewTCB = (TCB_t *) pvPortMalloc(sizeof(TCB_t));
+        pxNewTCB = (TCB_t *) pvObjectPoolAllocate(eTaskPool, sizeof(TCB_t));
 
         if (pxNewTCB != NULL) {
             /* Store the stack location in the TCB. */
@@ -647,16 +817,20 @@ BaseType_t xTaskCreateRestricted(const TaskParameters_t *const pxTaskDefinition,
             later deleted.  The TCB was allocated dynamically. */
             pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_ONLY;
 
-            prvInitialiseNewTask(pxTaskDefinition->pvTaskCode,
-                                 pxTaskDefinition->pcName,
-                                 (uint32_t) pxTaskDefinition->usStackDepth,
-                                 pxTaskDefinition->pvParameters,
-                                 pxTaskDefinition->uxPriority,
-                                 pxCreatedTask, pxNewTCB,
-                                 pxTaskDefinition->xRegions);
-
-            prvAddNewTaskToReadyList(pxNewTCB);
-            xReturn = pdPASS;
+            if (prvInitialiseNewTask(pxTaskDefinition->pvTaskCode,
+                                     pxTaskDefinition->pcName,
+                                     (uint32_t) pxTaskDefinition->usStackDepth,
+                                     pxTaskDefinition->pvParameters,
+                                     pxTaskDefinition->uxPriority,
+                                     pxCreatedTask, pxNewTCB,
+                                     pxTaskDefinition->xRegions) != pdFAIL) {
+                prvAddNewTaskToReadyList(pxNewTCB);
+                xReturn = pdPASS;
+            }
+            else {
+                vObjectPoolFree(eTaskPool, pxNewTCB);
+                traceTASK_CREATE_FAILED();
+            }
         }
     }
 
@@ -686,17 +860,17 @@ BaseType_t xTaskCreate(TaskFunction_t pxTaskCode,
         /* Allocate space for the TCB.  Where the memory comes from depends on
         the implementation of the port malloc function and whether or not static
         allocation is being used. */
-        pxNewTCB = (TCB_t *) pvPortMalloc(sizeof(TCB_t));
+        pxNewTCB = (TCB_t *) pvObjectPoolAllocate(eTaskPool, sizeof(TCB_t));
 
         if (pxNewTCB != NULL) {
             /* Allocate space for the stack used by the task being created.
             The base of the stack memory stored in the TCB so the task can
             be deleted later if required. */
-            pxNewTCB->pxStack = (StackType_t *) pvPortMalloc((((size_t) usStackDepth) * sizeof(StackType_t)));             /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            pxNewTCB->pxStack = (StackType_t *) pvObjectPoolAllocate(eStackPool, (((size_t) usStackDepth) * sizeof(StackType_t)));             /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
             if (pxNewTCB->pxStack == NULL) {
                 /* Could not allocate the stack.  Delete the allocated TCB. */
-                vPortFree(pxNewTCB);
+                vObjectPoolFree(eTaskPool, pxNewTCB);
                 pxNewTCB = NULL;
             }
         }
@@ -706,11 +880,11 @@ BaseType_t xTaskCreate(TaskFunction_t pxTaskCode,
         StackType_t *pxStack;
 
         /* Allocate space for the stack used by the task being created. */
-        pxStack = (StackType_t *) pvPortMalloc((((size_t) usStackDepth) * sizeof(StackType_t)));             /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+        pxStack = (StackType_t *) pvObjectPoolAllocate(eStackPool, (((size_t) usStackDepth) * sizeof(StackType_t)));             /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
         if (pxStack != NULL) {
             /* Allocate space for the TCB. */
-            pxNewTCB = (TCB_t *) pvPortMalloc(sizeof(TCB_t));       /*lint !e961 MISRA exception as the casts are only redundant for some paths. */
+            pxNewTCB = (TCB_t *) pvObjectPoolAllocate(eTaskPool, sizeof(TCB_t));       /*lint !e961 MISRA exception as the casts are only redundant for some paths. */
 
             if (pxNewTCB != NULL) {
                 /* Store the stack location in the TCB. */
@@ -719,7 +893,7 @@ BaseType_t xTaskCreate(TaskFunction_t pxTaskCode,
             else {
                 /* The stack cannot be used as the TCB was not created.  Free
                 it again. */
-                vPortFree(pxStack);
+                vObjectPoolFree(eStackPool, pxStack);
             }
         }
         else {
@@ -737,11 +911,21 @@ BaseType_t xTaskCreate(TaskFunction_t pxTaskCode,
         }
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
-        prvInitialiseNewTask(pxTaskCode, pcName, (uint32_t) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL);
-        prvAddNewTaskToReadyList(pxNewTCB);
-        xReturn = pdPASS;
+        if (prvInitialiseNewTask(pxTaskCode, pcName, (uint32_t) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL) != pdFAIL) {
+            prvAddNewTaskToReadyList(pxNewTCB);
+            xReturn = pdPASS;
+        }
+        else {
+            /* The port could not create the task's context, the stack and
+            TCB are not used by anything else yet. */
+            vObjectPoolFree(eStackPool, pxNewTCB->pxStack);
+            vObjectPoolFree(eTaskPool, pxNewTCB);
+            traceTASK_CREATE_FAILED();
+            xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+        }
     }
     else {
+        traceTASK_CREATE_FAILED();
         xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
     }
 
@@ -751,17 +935,18 @@ BaseType_t xTaskCreate(TaskFunction_t pxTaskCode,
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseNewTask(TaskFunction_t pxTaskCode,
-                                 const char *const pcName,
-                                 const uint32_t ulStackDepth,
-                                 void *const pvParameters,
-                                 UBaseType_t uxPriority,
-                                 TaskHandle_t *const pxCreatedTask,
-                                 TCB_t *pxNewTCB,
-                                 const MemoryRegion_t *const xRegions)   /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+static BaseType_t prvInitialiseNewTask(TaskFunction_t pxTaskCode,
+                                       const char *const pcName,
+                                       const uint32_t ulStackDepth,
+                                       void *const pvParameters,
+                                       UBaseType_t uxPriority,
+                                       TaskHandle_t *const pxCreatedTask,
+                                       TCB_t *pxNewTCB,
+                                       const MemoryRegion_t *const xRegions)   /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 {
     StackType_t *pxTopOfStack;
     UBaseType_t x;
+    BaseType_t xReturn;
 
 #if( portUSING_MPU_WRAPPERS == 1 )
     /* Should the task be created in privileged mode? */
@@ -775,8 +960,9 @@ static void prvInitialiseNewTask(TaskFunction_t pxTaskCode,
     uxPriority &= ~portPRIVILEGE_BIT;
 #endif /* portUSING_MPU_WRAPPERS == 1 */
 
-    /* Avoid dependency on memset() if it is not required. */
-#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+    /* Avoid dependency on memset() if it is not required. A port that
+    measures the stacks its tasks run on does not need this one filled. */
+#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) && !defined( portGET_STACK_HIGH_WATER_MARK ) ) )
     {
         /* Fill the stack with a known value to assist debugging. */
         (void) memset(pxNewTCB->pxStack, (int) tskSTACK_FILL_BYTE, (size_t) ulStackDepth * sizeof(StackType_t));
@@ -837,6 +1023,11 @@ static void prvInitialiseNewTask(TaskFunction_t pxTaskCode,
     }
 
     pxNewTCB->uxPriority = uxPriority;
+#if ( configNUMBER_OF_CORES > 1 )
+    {
+        pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+    }
+#endif /* configNUMBER_OF_CORES */
 #if ( configUSE_MUTEXES == 1 )
     {
         pxNewTCB->uxBasePriority = uxPriority;
@@ -920,20 +1111,45 @@ static void prvInitialiseNewTask(TaskFunction_t pxTaskCode,
     {
         pxNewTCB->pxTopOfStack = pxPortInitialiseStack(pxTopOfStack, pxTaskCode, pvParameters, xRunPrivileged);
     }
+#elif( portHAS_STACK_OVERFLOW_CHECKING == 1 )
+    {
+        /* The port also needs the end of the stack to bound the task's
+        stack. */
+#if( portSTACK_GROWTH < 0 )
+        {
+            pxNewTCB->pxTopOfStack = pxPortInitialiseStack(pxTopOfStack, pxNewTCB->pxStack, pxTaskCode, pvParameters);
+        }
+#else /* portSTACK_GROWTH */
+        {
+            pxNewTCB->pxTopOfStack = pxPortInitialiseStack(pxTopOfStack, pxNewTCB->pxEndOfStack, pxTaskCode, pvParameters);
+        }
+#endif /* portSTACK_GROWTH */
+    }
 #else /* portUSING_MPU_WRAPPERS */
     {
         pxNewTCB->pxTopOfStack = pxPortInitialiseStack(pxTopOfStack, pxTaskCode, pvParameters);
     }
 #endif /* portUSING_MPU_WRAPPERS */
 
-    if ((void *) pxCreatedTask != NULL) {
-        /* Pass the handle out in an anonymous way.  The handle can be used to
-        change the created task's priority, delete the created task, etc.*/
-        *pxCreatedTask = (TaskHandle_t) pxNewTCB;
+    if (pxNewTCB->pxTopOfStack == NULL) {
+        /* A port that runs each task on a host thread or host stack of its
+        own returns NULL if it could not create one. */
+        xReturn = pdFAIL;
     }
     else {
-        mtCOVERAGE_TEST_MARKER();
+        if ((void *) pxCreatedTask != NULL) {
+            /* Pass the handle out in an anonymous way.  The handle can be used to
+            change the created task's priority, delete the created task, etc.*/
+            *pxCreatedTask = (TaskHandle_t) pxNewTCB;
+        }
+        else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
     }
+
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
@@ -944,6 +1160,16 @@ static void prvAddNewTaskToReadyList(TCB_t *pxNewTCB)
     taskENTER_CRITICAL();
     {
         uxCurrentNumberOfTasks++;
+#if ( configNUMBER_OF_CORES > 1 )
+        if (uxCurrentNumberOfTasks == (UBaseType_t) 1) {
+            /* This is the first task to be created.  The task each core
+            runs first is only selected once the scheduler starts. */
+            prvInitialiseTaskLists();
+        }
+        else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+#else
         if (pxCurrentTCB == NULL) {
             /* There are no other tasks, or all the other tasks are in
             the suspended state - make this the current task. */
@@ -975,6 +1201,7 @@ static void prvAddNewTaskToReadyList(TCB_t *pxNewTCB)
                 mtCOVERAGE_TEST_MARKER();
             }
         }
+#endif /* configNUMBER_OF_CORES */
 
         uxTaskNumber++;
 
@@ -992,19 +1219,25 @@ static void prvAddNewTaskToReadyList(TCB_t *pxNewTCB)
     }
     taskEXIT_CRITICAL();
 
-    if (xSchedulerRunning != pdFALSE) {
-        /* If the created task is of a higher priority than the current task
-        then it should run now. */
-        if (pxCurrentTCB->uxPriority < pxNewTCB->uxPriority) {
-            taskYIELD_IF_USING_PREEMPTION();
+#if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* With more than one core prvAddTaskToReadyList() has yielded the
+        core to run the task on, which may already have deleted it. */
+        if (xSchedulerRunning != pdFALSE) {
+            /* If the created task is of a higher priority than the current
+            task then it should run now. */
+            if (pxCurrentTCB->uxPriority < pxNewTCB->uxPriority) {
+                taskYIELD_IF_USING_PREEMPTION();
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else {
             mtCOVERAGE_TEST_MARKER();
         }
     }
-    else {
-        mtCOVERAGE_TEST_MARKER();
-    }
+#endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -1062,6 +1295,15 @@ void vTaskDelete(TaskHandle_t xTaskToDelete)
             required. */
             portPRE_TASK_DELETE_HOOK(pxTCB, &xYieldPending);
         }
+#if ( configNUMBER_OF_CORES > 1 )
+        else if (pxTCB->xTaskRunState != taskTASK_NOT_RUNNING) {
+            /* The task is running on another core.  It is freed by the idle
+            task once that core has switched away from it. */
+            vListInsertEnd(&xTasksWaitingTermination, &(pxTCB->xStateListItem));
+            ++uxDeletedTasksWaitingCleanUp;
+            prvYieldCore(pxTCB->xTaskRunState);
+        }
+#endif /* configNUMBER_OF_CORES */
         else {
             --uxCurrentNumberOfTasks;
             prvDeleteTCB(pxTCB);
@@ -1220,6 +1462,12 @@ eTaskState eTaskGetState(TaskHandle_t xTask)
         /* The task calling this function is querying its own state. */
         eReturn = eRunning;
     }
+#if ( configNUMBER_OF_CORES > 1 )
+    else if (pxTCB->xTaskRunState != taskTASK_NOT_RUNNING) {
+        /* The task is running on another core. */
+        eReturn = eRunning;
+    }
+#endif
     else {
         taskENTER_CRITICAL();
         {
@@ -1227,7 +1475,7 @@ eTaskState eTaskGetState(TaskHandle_t xTask)
         }
         taskEXIT_CRITICAL();
 
-        if ((pxStateList == pxDelayedTaskList) || (pxStateList == pxOverflowDelayedTaskList)) {
+        if (taskLIST_IS_DELAYED_LIST(pxStateList)) {
             /* The task being queried is referenced from one of the Blocked
             lists. */
             eReturn = eBlocked;
@@ -1394,6 +1642,12 @@ void vTaskPrioritySet(TaskHandle_t xTask, UBaseType_t uxNewPriority)
                 is ready to execute. */
                 xYieldRequired = pdTRUE;
             }
+#if ( configNUMBER_OF_CORES > 1 )
+            else if (pxTCB->xTaskRunState != taskTASK_NOT_RUNNING) {
+                /* The same holds for a task running on another core. */
+                prvYieldCore(pxTCB->xTaskRunState);
+            }
+#endif
             else {
                 /* Setting the priority of any other task down does not
                 require a yield as the running task must be above the
@@ -1507,6 +1761,16 @@ void vTaskSuspend(TaskHandle_t xTaskToSuspend)
         }
 
         vListInsertEnd(&xSuspendedTaskList, &(pxTCB->xStateListItem));
+
+#if ( configNUMBER_OF_CORES > 1 )
+        {
+            /* A task running on another core stops once that core has
+            selected another task. */
+            if ((pxTCB->xTaskRunState != taskTASK_NOT_RUNNING) && (pxTCB != pxCurrentTCB)) {
+                prvYieldCore(pxTCB->xTaskRunState);
+            }
+        }
+#endif /* configNUMBER_OF_CORES */
     }
     taskEXIT_CRITICAL();
 
@@ -1529,6 +1793,7 @@ void vTaskSuspend(TaskHandle_t xTaskToSuspend)
             configASSERT(uxSchedulerSuspended == 0);
             portYIELD_WITHIN_API();
         }
+#if ( configNUMBER_OF_CORES == 1 )
         else {
             /* The scheduler is not running, but the task that was pointed
             to by pxCurrentTCB has just been suspended and pxCurrentTCB
@@ -1544,6 +1809,7 @@ void vTaskSuspend(TaskHandle_t xTaskToSuspend)
                 vTaskSwitchContext();
             }
         }
+#endif /* configNUMBER_OF_CORES */
     }
     else {
         mtCOVERAGE_TEST_MARKER();
@@ -1747,6 +2013,50 @@ void vTaskStartScheduler(void)
     }
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+#if ( configNUMBER_OF_CORES > 1 )
+    {
+        BaseType_t xCoreID;
+        char cIdleName[] = "IDLE0";
+
+        /* Every other core gets an idle task of its own, the name only
+        tells the idle tasks apart. */
+        for (xCoreID = 1; (xCoreID < (BaseType_t) configNUMBER_OF_CORES) && (xReturn == pdPASS); xCoreID++) {
+            cIdleName[ 4 ] = (char)('0' + (xCoreID % 10));
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                StaticTask_t *pxIdleTaskTCBBuffer = NULL;
+                StackType_t *pxIdleTaskStackBuffer = NULL;
+                uint32_t ulIdleTaskStackSize;
+
+                vApplicationGetPassiveIdleTaskMemory(&pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize, xCoreID - 1);
+                xIdleTaskHandles[ xCoreID ] = xTaskCreateStatic(prvPassiveIdleTask,
+                                                                cIdleName,
+                                                                ulIdleTaskStackSize,
+                                                                (void *) NULL,
+                                                                (tskIDLE_PRIORITY | portPRIVILEGE_BIT),
+                                                                pxIdleTaskStackBuffer,
+                                                                pxIdleTaskTCBBuffer);
+
+                if (xIdleTaskHandles[ xCoreID ] != NULL) {
+                    xReturn = pdPASS;
+                }
+                else {
+                    xReturn = pdFAIL;
+                }
+            }
+#else
+            {
+                xReturn = xTaskCreate(prvPassiveIdleTask,
+                                      cIdleName, configMINIMAL_STACK_SIZE,
+                                      (void *) NULL,
+                                      (tskIDLE_PRIORITY | portPRIVILEGE_BIT),
+                                      &xIdleTaskHandles[ xCoreID ]);
+            }
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+        }
+    }
+#endif /* configNUMBER_OF_CORES */
+
 #if ( configUSE_TIMERS == 1 )
     {
         if (xReturn == pdPASS) {
@@ -1766,6 +2076,23 @@ void vTaskStartScheduler(void)
         starts to run. */
         portDISABLE_INTERRUPTS();
 
+#if ( configNUMBER_OF_CORES > 1 )
+        {
+            BaseType_t xCoreID;
+
+            /* Each core starts out running its idle task, then selects the
+            highest priority task no core before it has selected. */
+            for (xCoreID = 0; xCoreID < (BaseType_t) configNUMBER_OF_CORES; xCoreID++) {
+                pxCurrentTCBs[ xCoreID ] = (TCB_t *) xIdleTaskHandles[ xCoreID ];
+                pxCurrentTCBs[ xCoreID ]->xTaskRunState = xCoreID;
+            }
+
+            for (xCoreID = 0; xCoreID < (BaseType_t) configNUMBER_OF_CORES; xCoreID++) {
+                prvSelectHighestPriorityTask(xCoreID);
+            }
+        }
+#endif /* configNUMBER_OF_CORES */
+
 #if ( configUSE_NEWLIB_REENTRANT == 1 )
         {
             /* Switch Newlib's _impure_ptr variable to point to the _reent
@@ -1823,7 +2150,24 @@ void vTaskSuspendAll(void)
     BaseType_t.  Please read Richard Barry's reply in the following link to a
     post in the FreeRTOS support forum before reporting this as a bug! -
     http://goo.gl/wu4acr */
-    ++uxSchedulerSuspended;
+#if ( configNUMBER_OF_CORES > 1 )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* Other cores wait for the task lock instead of changing the task
+        lists while the scheduler is suspended. This core's interrupts are
+        masked until the scheduler is marked suspended, so that the calling
+        task cannot be switched out while holding the lock. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+        portGET_TASK_LOCK();
+        ++uxSchedulerSuspended;
+        portCLEAR_INTERRUPT_MASK(uxSavedInterruptStatus);
+    }
+#else
+    {
+        ++uxSchedulerSuspended;
+    }
+#endif /* configNUMBER_OF_CORES */
 }
 /*----------------------------------------------------------*/
 
@@ -1974,6 +2318,12 @@ BaseType_t xTaskResumeAll(void)
         else {
             mtCOVERAGE_TEST_MARKER();
         }
+
+#if ( configNUMBER_OF_CORES > 1 )
+        {
+            portRELEASE_TASK_LOCK();
+        }
+#endif /* configNUMBER_OF_CORES */
     }
     taskEXIT_CRITICAL();
 
@@ -2127,13 +2477,23 @@ TaskHandle_t xTaskGetHandle(const char *pcNameToQuery)   /*lint !e971 Unqualifie
         while (uxQueue > (UBaseType_t) tskIDLE_PRIORITY);      /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
         /* Search the delayed lists. */
-        if (pxTCB == NULL) {
-            pxTCB = prvSearchForNameWithinSingleList((List_t *) pxDelayedTaskList, pcNameToQuery);
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+        {
+            for (uxQueue = 0; (uxQueue < (UBaseType_t)(taskWHEEL_LEVELS * taskWHEEL_SLOTS)) && (pxTCB == NULL); uxQueue++) {
+                pxTCB = prvSearchForNameWithinSingleList(&(xDelayedTaskWheel[ uxQueue ]), pcNameToQuery);
+            }
         }
+#else
+        {
+            if (pxTCB == NULL) {
+                pxTCB = prvSearchForNameWithinSingleList((List_t *) pxDelayedTaskList, pcNameToQuery);
+            }
 
-        if (pxTCB == NULL) {
-            pxTCB = prvSearchForNameWithinSingleList((List_t *) pxOverflowDelayedTaskList, pcNameToQuery);
+            if (pxTCB == NULL) {
+                pxTCB = prvSearchForNameWithinSingleList((List_t *) pxOverflowDelayedTaskList, pcNameToQuery);
+            }
         }
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 
 #if ( INCLUDE_vTaskSuspend == 1 )
         {
@@ -2163,7 +2523,7 @@ TaskHandle_t xTaskGetHandle(const char *pcNameToQuery)   /*lint !e971 Unqualifie
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
-UBaseType_t uxTaskGetSystemState(TaskStatus_t *const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t *const pulTotalRunTime)
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE *const pulTotalRunTime)
 {
     UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
 
@@ -2182,8 +2542,18 @@ UBaseType_t uxTaskGetSystemState(TaskStatus_t *const pxTaskStatusArray, const UB
 
             /* Fill in an TaskStatus_t structure with information on each
             task in the Blocked state. */
-            uxTask += prvListTasksWithinSingleList(&(pxTaskStatusArray[ uxTask ]), (List_t *) pxDelayedTaskList, eBlocked);
-            uxTask += prvListTasksWithinSingleList(&(pxTaskStatusArray[ uxTask ]), (List_t *) pxOverflowDelayedTaskList, eBlocked);
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+            {
+                for (uxQueue = 0; uxQueue < (UBaseType_t)(taskWHEEL_LEVELS * taskWHEEL_SLOTS); uxQueue++) {
+                    uxTask += prvListTasksWithinSingleList(&(pxTaskStatusArray[ uxTask ]), &(xDelayedTaskWheel[ uxQueue ]), eBlocked);
+                }
+            }
+#else
+            {
+                uxTask += prvListTasksWithinSingleList(&(pxTaskStatusArray[ uxTask ]), (List_t *) pxDelayedTaskList, eBlocked);
+                uxTask += prvListTasksWithinSingleList(&(pxTaskStatusArray[ uxTask ]), (List_t *) pxOverflowDelayedTaskList, eBlocked);
+            }
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 
 #if( INCLUDE_vTaskDelete == 1 )
             {
@@ -2308,7 +2678,7 @@ BaseType_t xTaskAbortDelay(TaskHandle_t xTask)
                 /* Preemption is on, but a context switch should only be
                 performed if the unblocked task has a priority that is
                 equal to or higher than the currently executing task. */
-                if (pxTCB->uxPriority > pxCurrentTCB->uxPriority) {
+                if (taskYIELD_REQUIRED_FOR(pxTCB)) {
                     /* Pend the yield to be performed when the scheduler
                     is unsuspended. */
                     xYieldPending = pdTRUE;
@@ -2334,7 +2704,9 @@ BaseType_t xTaskAbortDelay(TaskHandle_t xTask)
 BaseType_t xTaskIncrementTick(void)
 {
     TCB_t *pxTCB;
+#if( configUSE_DELAYED_TASK_WHEEL == 0 )
     TickType_t xItemValue;
+#endif
     BaseType_t xSwitchRequired = pdFALSE;
 
     /* Called by the portable layer each time a tick interrupt occurs.
@@ -2363,69 +2735,88 @@ BaseType_t xTaskIncrementTick(void)
         look any further down the list. */
         if (xConstTickCount >= xNextTaskUnblockTime) {
             for (;;) {
-                if (listLIST_IS_EMPTY(pxDelayedTaskList) != pdFALSE) {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                    to the maximum possible value so it is extremely
-                    unlikely that the
-                    if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                    next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    break;
-                }
-                else {
-                    /* The delayed list is not empty, get the value of the
-                    item at the head of the delayed list.  This is the time
-                    at which the task at the head of the delayed list must
-                    be removed from the Blocked state. */
-                    pxTCB = (TCB_t *) listGET_OWNER_OF_HEAD_ENTRY(pxDelayedTaskList);
-                    xItemValue = listGET_LIST_ITEM_VALUE(&(pxTCB->xStateListItem));
-
-                    if (xConstTickCount < xItemValue) {
-                        /* It is not time to unblock this item yet, but the
-                        item value is the time at which the task at the head
-                        of the blocked list must be removed from the Blocked
-                        state - so record the item value in
-                        xNextTaskUnblockTime. */
-                        xNextTaskUnblockTime = xItemValue;
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+                {
+                    /* Take the tasks whose wake time has been reached from
+                    the delayed task wheel one at a time, then set
+                    xNextTaskUnblockTime to the next time the wheel has to be
+                    processed. */
+                    pxTCB = prvGetDelayedTaskToUnblock(xConstTickCount);
+                    if (pxTCB == NULL) {
+                        prvResetNextTaskUnblockTime();
                         break;
                     }
                     else {
                         mtCOVERAGE_TEST_MARKER();
                     }
-
-                    /* It is time to remove the item from the Blocked state. */
-                    (void) uxListRemove(&(pxTCB->xStateListItem));
-
-                    /* Is the task waiting on an event also?  If so remove
-                    it from the event list. */
-                    if (listLIST_ITEM_CONTAINER(&(pxTCB->xEventListItem)) != NULL) {
-                        (void) uxListRemove(&(pxTCB->xEventListItem));
+                }
+#else
+                {
+                    if (listLIST_IS_EMPTY(pxDelayedTaskList) != pdFALSE) {
+                        /* The delayed list is empty.  Set xNextTaskUnblockTime
+                        to the maximum possible value so it is extremely
+                        unlikely that the
+                        if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                        next time through. */
+                        xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                        break;
                     }
                     else {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* Place the unblocked task into the appropriate ready
-                    list. */
-                    prvAddTaskToReadyList(pxTCB);
-
-                    /* A task being unblocked cannot cause an immediate
-                    context switch if preemption is turned off. */
-#if (  configUSE_PREEMPTION == 1 )
-                    {
-                        /* Preemption is on, but a context switch should
-                        only be performed if the unblocked task has a
-                        priority that is equal to or higher than the
-                        currently executing task. */
-                        if (pxTCB->uxPriority >= pxCurrentTCB->uxPriority) {
-                            xSwitchRequired = pdTRUE;
+                        /* The delayed list is not empty, get the value of the
+                        item at the head of the delayed list.  This is the time
+                        at which the task at the head of the delayed list must
+                        be removed from the Blocked state. */
+                        pxTCB = (TCB_t *) listGET_OWNER_OF_HEAD_ENTRY(pxDelayedTaskList);
+                        xItemValue = listGET_LIST_ITEM_VALUE(&(pxTCB->xStateListItem));
+
+                        if (xConstTickCount < xItemValue) {
+                            /* It is not time to unblock this item yet, but the
+                            item value is the time at which the task at the head
+                            of the blocked list must be removed from the Blocked
+                            state - so record the item value in
+                            xNextTaskUnblockTime. */
+                            xNextTaskUnblockTime = xItemValue;
+                            break;
                         }
                         else {
                             mtCOVERAGE_TEST_MARKER();
                         }
                     }
-#endif /* configUSE_PREEMPTION */
                 }
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
+                /* It is time to remove the item from the Blocked state. */
+                (void) uxListRemove(&(pxTCB->xStateListItem));
+
+                /* Is the task waiting on an event also?  If so remove
+                it from the event list. */
+                if (listLIST_ITEM_CONTAINER(&(pxTCB->xEventListItem)) != NULL) {
+                    (void) uxListRemove(&(pxTCB->xEventListItem));
+                }
+                else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Place the unblocked task into the appropriate ready
+                list. */
+                prvAddTaskToReadyList(pxTCB);
+
+                /* A task being unblocked cannot cause an immediate
+                context switch if preemption is turned off. */
+#if (  configUSE_PREEMPTION == 1 )
+                {
+                    /* Preemption is on, but a context switch should
+                    only be performed if the unblocked task has a
+                    priority that is equal to or higher than the
+                    currently executing task. */
+                    if (pxTCB->uxPriority >= pxCurrentTCB->uxPriority) {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+#endif /* configUSE_PREEMPTION */
             }
         }
 
@@ -2434,12 +2825,37 @@ BaseType_t xTaskIncrementTick(void)
         writer has not explicitly turned time slicing off. */
 #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
         {
+#if ( configNUMBER_OF_CORES == 1 )
             if (listCURRENT_LIST_LENGTH(&(pxReadyTasksLists[ pxCurrentTCB->uxPriority ])) > (UBaseType_t) 1) {
                 xSwitchRequired = pdTRUE;
             }
             else {
                 mtCOVERAGE_TEST_MARKER();
             }
+#else
+            BaseType_t xCoreID, xOtherCoreID;
+            UBaseType_t uxPriority, uxRunning;
+
+            /* A core only shares its time with ready tasks of the same
+            priority that no other core is running. */
+            for (xCoreID = 0; xCoreID < (BaseType_t) configNUMBER_OF_CORES; xCoreID++) {
+                uxPriority = pxCurrentTCBs[ xCoreID ]->uxPriority;
+                uxRunning = 0;
+
+                for (xOtherCoreID = 0; xOtherCoreID < (BaseType_t) configNUMBER_OF_CORES; xOtherCoreID++) {
+                    if (pxCurrentTCBs[ xOtherCoreID ]->uxPriority == uxPriority) {
+                        uxRunning++;
+                    }
+                }
+
+                if (listCURRENT_LIST_LENGTH(&(pxReadyTasksLists[ uxPriority ])) > uxRunning) {
+                    prvYieldCore(xCoreID);
+                }
+                else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+#endif /* configNUMBER_OF_CORES */
         }
 #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
@@ -2606,7 +3022,11 @@ void vTaskSwitchContext(void)
 
         /* Select a new task to run using either the generic C or port
         optimised asm code. */
+#if ( configNUMBER_OF_CORES == 1 )
         taskSELECT_HIGHEST_PRIORITY_TASK();
+#else
+        prvSelectHighestPriorityTask(portGET_CORE_ID());
+#endif
         traceTASK_SWITCHED_IN();
 
 #if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -2620,6 +3040,135 @@ void vTaskSwitchContext(void)
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+static void prvSelectHighestPriorityTask(BaseType_t xCoreID)
+{
+    UBaseType_t uxTopPriority = uxTopReadyPriority;
+    BaseType_t xLowerTopPriority = pdTRUE;
+    UBaseType_t uxTasks;
+    TCB_t *pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+    TCB_t *pxTCB = NULL;
+    TCB_t *pxCandidateTCB;
+
+    /* The task this core has been running may be selected again. */
+    if (pxPreviousTCB->xTaskRunState == xCoreID) {
+        pxPreviousTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+    }
+
+    while (pxTCB == NULL) {
+        if (listLIST_IS_EMPTY(&(pxReadyTasksLists[ uxTopPriority ])) == pdFALSE) {
+            /* Tasks ready at this priority may all be running on other
+            cores, in which case uxTopReadyPriority must not drop below
+            it. */
+            xLowerTopPriority = pdFALSE;
+
+            /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the
+            tasks of the same priority get an equal share of the cores. */
+            uxTasks = listCURRENT_LIST_LENGTH(&(pxReadyTasksLists[ uxTopPriority ]));
+            while ((pxTCB == NULL) && (uxTasks-- > (UBaseType_t) 0)) {
+                listGET_OWNER_OF_NEXT_ENTRY(pxCandidateTCB, &(pxReadyTasksLists[ uxTopPriority ]));
+
+                if (pxCandidateTCB->xTaskRunState == taskTASK_NOT_RUNNING) {
+                    pxTCB = pxCandidateTCB;
+                }
+            }
+        }
+        else if (xLowerTopPriority != pdFALSE) {
+            configASSERT(uxTopPriority);
+            uxTopReadyPriority = uxTopPriority - 1;
+        }
+
+        if (pxTCB == NULL) {
+            /* There is always an idle task that is not running on another
+            core. */
+            configASSERT(uxTopPriority);
+            --uxTopPriority;
+        }
+    }
+
+    pxTCB->xTaskRunState = xCoreID;
+    pxCurrentTCBs[ xCoreID ] = pxTCB;
+
+#if ( INCLUDE_vTaskDelete == 1 )
+    {
+        BaseType_t xOtherCoreID;
+
+        /* A task deleted while it ran here can only be freed now.  Unless
+        this core is about to run an idle task, wake a core that waits in
+        its idle task to do so. */
+        if ((listLIST_ITEM_CONTAINER(&(pxPreviousTCB->xStateListItem)) == &xTasksWaitingTermination) && (prvIsIdleTask(pxTCB) == pdFALSE)) {
+            for (xOtherCoreID = 0; xOtherCoreID < (BaseType_t) configNUMBER_OF_CORES; xOtherCoreID++) {
+                if ((prvIsIdleTask(pxCurrentTCBs[ xOtherCoreID ]) != pdFALSE) && (xYieldPendings[ xOtherCoreID ] == pdFALSE)) {
+                    prvYieldCore(xOtherCoreID);
+                    break;
+                }
+            }
+        }
+    }
+#endif /* INCLUDE_vTaskDelete */
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldCore(BaseType_t xCoreID)
+{
+    /* The pending yield also keeps prvYieldForTask() from picking the same
+    core for another task before it has selected one. */
+    xYieldPendings[ xCoreID ] = pdTRUE;
+    portYIELD_CORE(xCoreID);
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldForTask(const TCB_t *pxTCB)
+{
+    BaseType_t xCoreID, xLowestCoreID = -1;
+    BaseType_t xLowestPriority = (BaseType_t) pxTCB->uxPriority - 1;
+    BaseType_t xCorePriority;
+
+    if ((xSchedulerRunning != pdFALSE) && (pxTCB->xTaskRunState == taskTASK_NOT_RUNNING)) {
+        for (xCoreID = 0; xCoreID < (BaseType_t) configNUMBER_OF_CORES; xCoreID++) {
+            xCorePriority = (BaseType_t) pxCurrentTCBs[ xCoreID ]->uxPriority;
+
+            /* Prefer a core running an idle task to one running another task
+            of the idle priority. */
+            if (prvIsIdleTask(pxCurrentTCBs[ xCoreID ]) != pdFALSE) {
+                xCorePriority--;
+            }
+
+            /* A core that is about to select a task anyway will select the
+            highest priority one. */
+            if ((xCorePriority <= xLowestPriority) && (xYieldPendings[ xCoreID ] == pdFALSE)) {
+                xLowestPriority = xCorePriority;
+                xLowestCoreID = xCoreID;
+            }
+        }
+
+        if (xLowestCoreID >= 0) {
+            prvYieldCore(xLowestCoreID);
+        }
+        else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsIdleTask(const TCB_t *pxTCB)
+{
+    BaseType_t xCoreID;
+
+    for (xCoreID = 0; xCoreID < (BaseType_t) configNUMBER_OF_CORES; xCoreID++) {
+        if (pxTCB == (TCB_t *) xIdleTaskHandles[ xCoreID ]) {
+            return pdTRUE;
+        }
+    }
+
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configNUMBER_OF_CORES */
+
 void vTaskPlaceOnEventList(List_t *const pxEventList, const TickType_t xTicksToWait)
 {
     configASSERT(pxEventList);
@@ -2725,7 +3274,7 @@ BaseType_t xTaskRemoveFromEventList(const List_t *const pxEventList)
         vListInsertEnd(&(xPendingReadyList), &(pxUnblockedTCB->xEventListItem));
     }
 
-    if (pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority) {
+    if (taskYIELD_REQUIRED_FOR(pxUnblockedTCB)) {
         /* Return true if the task removed from the event list has a higher
         priority than the calling task.  This allows the calling task to know if
         it should force a context switch now. */
@@ -2781,7 +3330,7 @@ BaseType_t xTaskRemoveFromUnorderedEventList(ListItem_t *pxEventListItem, const
     (void) uxListRemove(&(pxUnblockedTCB->xStateListItem));
     prvAddTaskToReadyList(pxUnblockedTCB);
 
-    if (pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority) {
+    if (taskYIELD_REQUIRED_FOR(pxUnblockedTCB)) {
         /* Return true if the task removed from the event list has
         a higher priority than the calling task.  This allows
         the calling task to know if it should force a context
@@ -2948,9 +3497,10 @@ static portTASK_FUNCTION(prvIdleTask, pvParameters)
 
             A critical region is not required here as we are just reading from
             the list, and an occasional incorrect value will not matter.  If
-            the ready list at the idle priority contains more than one task
-            then a task other than the idle task is ready to execute. */
-            if (listCURRENT_LIST_LENGTH(&(pxReadyTasksLists[ tskIDLE_PRIORITY ])) > (UBaseType_t) 1) {
+            the ready list at the idle priority contains more tasks than
+            there are idle tasks then a task other than an idle task is ready
+            to execute. */
+            if (listCURRENT_LIST_LENGTH(&(pxReadyTasksLists[ tskIDLE_PRIORITY ])) > (UBaseType_t) configNUMBER_OF_CORES) {
                 taskYIELD();
             }
             else {
@@ -2972,6 +3522,30 @@ static portTASK_FUNCTION(prvIdleTask, pvParameters)
         }
 #endif /* configUSE_IDLE_HOOK */
 
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+        {
+            /* Rather than spin, wait until a task is readied for this core.
+            While a deleted task is still being switched away from by another
+            core keep checking instead, to free it. */
+            BaseType_t xWait = pdTRUE;
+
+#if ( INCLUDE_vTaskDelete == 1 )
+            {
+                if (uxDeletedTasksWaitingCleanUp > (UBaseType_t) 0U) {
+                    xWait = pdFALSE;
+                }
+            }
+#endif /* INCLUDE_vTaskDelete */
+
+            if ((xWait != pdFALSE) && (listCURRENT_LIST_LENGTH(&(pxReadyTasksLists[ tskIDLE_PRIORITY ])) <= (UBaseType_t) configNUMBER_OF_CORES)) {
+                portWAIT_FOR_INTERRUPT();
+            }
+            else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+#endif /* configNUMBER_OF_CORES */
+
         /* This conditional compilation should use inequality to 0, not equality
         to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
         user defined low power mode implementations require
@@ -3016,6 +3590,48 @@ static portTASK_FUNCTION(prvIdleTask, pvParameters)
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+static portTASK_FUNCTION(prvPassiveIdleTask, pvParameters)
+{
+    /* Stop warnings. */
+    (void) pvParameters;
+
+    for (;;) {
+        /* Any idle task frees deleted tasks, the core that ran a task last
+        may not be the one running prvIdleTask(). */
+        prvCheckTasksWaitingTermination();
+
+#if ( configUSE_PREEMPTION == 0 )
+        {
+            /* Without preemption no other core makes this one switch task,
+            so keep looking for a task to run. */
+            taskYIELD();
+        }
+#else
+        {
+            if (listCURRENT_LIST_LENGTH(&(pxReadyTasksLists[ tskIDLE_PRIORITY ])) > (UBaseType_t) configNUMBER_OF_CORES) {
+                /* A task that shares the idle priority is ready to run. */
+                taskYIELD();
+            }
+#if ( INCLUDE_vTaskDelete == 1 )
+            else if (uxDeletedTasksWaitingCleanUp > (UBaseType_t) 0U) {
+                /* A deleted task is still being switched away from. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+#endif /* INCLUDE_vTaskDelete */
+            else {
+                /* Wait until a task is readied for this core. */
+                portWAIT_FOR_INTERRUPT();
+            }
+        }
+#endif /* configUSE_PREEMPTION */
+    }
+}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
 #if( configUSE_TICKLESS_IDLE != 0 )
 
 eSleepModeStatus eTaskConfirmSleepModeStatus(void)
@@ -3111,8 +3727,20 @@ static void prvInitialiseTaskLists(void)
         vListInitialise(&(pxReadyTasksLists[ uxPriority ]));
     }
 
-    vListInitialise(&xDelayedTaskList1);
-    vListInitialise(&xDelayedTaskList2);
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+    {
+        UBaseType_t uxSlot;
+
+        for (uxSlot = (UBaseType_t) 0U; uxSlot < (UBaseType_t)(taskWHEEL_LEVELS * taskWHEEL_SLOTS); uxSlot++) {
+            vListInitialise(&(xDelayedTaskWheel[ uxSlot ]));
+        }
+    }
+#else
+    {
+        vListInitialise(&xDelayedTaskList1);
+        vListInitialise(&xDelayedTaskList2);
+    }
+#endif /* configUSE_DELAYED_TASK_WHEEL */
     vListInitialise(&xPendingReadyList);
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -3127,10 +3755,14 @@ static void prvInitialiseTaskLists(void)
     }
 #endif /* INCLUDE_vTaskSuspend */
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-    using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+    {
+        /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+        using list2. */
+        pxDelayedTaskList = &xDelayedTaskList1;
+        pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    }
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
@@ -3139,7 +3771,37 @@ static void prvCheckTasksWaitingTermination(void)
 
     /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
 
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( ( INCLUDE_vTaskDelete == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+    {
+        TCB_t *pxTCB;
+
+        while (uxDeletedTasksWaitingCleanUp > (UBaseType_t) 0U) {
+            taskENTER_CRITICAL();
+            {
+                /* A task deleted while it was running on another core is only
+                freed once that core has switched away from it. */
+                pxTCB = NULL;
+                if (listLIST_IS_EMPTY(&xTasksWaitingTermination) == pdFALSE) {
+                    pxTCB = (TCB_t *) listGET_OWNER_OF_HEAD_ENTRY((&xTasksWaitingTermination));
+                    if (pxTCB->xTaskRunState == taskTASK_NOT_RUNNING) {
+                        (void) uxListRemove(&(pxTCB->xStateListItem));
+                        --uxCurrentNumberOfTasks;
+                        --uxDeletedTasksWaitingCleanUp;
+                    }
+                    else {
+                        pxTCB = NULL;
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if (pxTCB == NULL) {
+                break;
+            }
+            prvDeleteTCB(pxTCB);
+        }
+    }
+#elif ( INCLUDE_vTaskDelete == 1 )
     {
         BaseType_t xListIsEmpty;
 
@@ -3240,7 +3902,12 @@ void vTaskGetInfo(TaskHandle_t xTask, TaskStatus_t *pxTaskStatus, BaseType_t xGe
     /* Obtaining the stack space takes some time, so the xGetFreeStackSpace
     parameter is provided to allow it to be skipped. */
     if (xGetFreeStackSpace != pdFALSE) {
-#if ( portSTACK_GROWTH > 0 )
+#if defined( portGET_STACK_HIGH_WATER_MARK )
+        {
+            /* The port's tasks run on stacks of its own. */
+            pxTaskStatus->usStackHighWaterMark = (uint16_t) portGET_STACK_HIGH_WATER_MARK(pxTCB->pxTopOfStack);
+        }
+#elif ( portSTACK_GROWTH > 0 )
         {
             pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace((uint8_t *) pxTCB->pxEndOfStack);
         }
@@ -3289,7 +3956,7 @@ static UBaseType_t prvListTasksWithinSingleList(TaskStatus_t *pxTaskStatusArray,
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+#if ( ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) && !defined( portGET_STACK_HIGH_WATER_MARK ) )
 
 static uint16_t prvTaskCheckFreeStackSpace(const uint8_t *pucStackByte)
 {
@@ -3305,7 +3972,7 @@ static uint16_t prvTaskCheckFreeStackSpace(const uint8_t *pucStackByte)
     return (uint16_t) ulCount;
 }
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) */
+#endif /* ( ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) && !defined( portGET_STACK_HIGH_WATER_MARK ) ) */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
@@ -3313,22 +3980,31 @@ static uint16_t prvTaskCheckFreeStackSpace(const uint8_t *pucStackByte)
 UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t xTask)
 {
     TCB_t *pxTCB;
-    uint8_t *pucEndOfStack;
     UBaseType_t uxReturn;
 
     pxTCB = prvGetTCBFromHandle(xTask);
 
-#if portSTACK_GROWTH < 0
+#if defined( portGET_STACK_HIGH_WATER_MARK )
     {
-        pucEndOfStack = (uint8_t *) pxTCB->pxStack;
+        uxReturn = (UBaseType_t) portGET_STACK_HIGH_WATER_MARK(pxTCB->pxTopOfStack);
     }
 #else
     {
-        pucEndOfStack = (uint8_t *) pxTCB->pxEndOfStack;
-    }
+        uint8_t *pucEndOfStack;
+
+#if portSTACK_GROWTH < 0
+        {
+            pucEndOfStack = (uint8_t *) pxTCB->pxStack;
+        }
+#else
+        {
+            pucEndOfStack = (uint8_t *) pxTCB->pxEndOfStack;
+        }
 #endif
 
-    uxReturn = (UBaseType_t) prvTaskCheckFreeStackSpace(pucEndOfStack);
+        uxReturn = (UBaseType_t) prvTaskCheckFreeStackSpace(pucEndOfStack);
+    }
+#endif
 
     return uxReturn;
 }
@@ -3357,8 +4033,8 @@ static void prvDeleteTCB(TCB_t *pxTCB)
     {
         /* The task can only have been allocated dynamically - free both
         the stack and TCB. */
-        vPortFree(pxTCB->pxStack);
-        vPortFree(pxTCB);
+        vObjectPoolFree(eStackPool, pxTCB->pxStack);
+        vObjectPoolFree(eTaskPool, pxTCB);
     }
 #elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE == 1 )
     {
@@ -3368,13 +4044,13 @@ static void prvDeleteTCB(TCB_t *pxTCB)
         if (pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB) {
             /* Both the stack and TCB were allocated dynamically, so both
             must be freed. */
-            vPortFree(pxTCB->pxStack);
-            vPortFree(pxTCB);
+            vObjectPoolFree(eStackPool, pxTCB->pxStack);
+            vObjectPoolFree(eTaskPool, pxTCB);
         }
         else if (pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY) {
             /* Only the stack was statically allocated, so the TCB is the
             only memory that must be freed. */
-            vPortFree(pxTCB);
+            vObjectPoolFree(eTaskPool, pxTCB);
         }
         else {
             /* Neither the stack nor the TCB were allocated dynamically, so
@@ -3389,6 +4065,145 @@ static void prvDeleteTCB(TCB_t *pxTCB)
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+static void prvResetNextTaskUnblockTime(void)
+{
+    TickType_t xNextTime;
+
+    if (prvGetNextDelayedTaskWheelTime(&xNextTime) == pdFALSE) {
+        /* No task is delayed.  Set xNextTaskUnblockTime to the maximum
+        possible value so it is extremely unlikely that the
+        if( xTickCount >= xNextTaskUnblockTime ) test will pass until a task
+        is delayed. */
+        xNextTaskUnblockTime = portMAX_DELAY;
+    }
+    else if ((xNextTime < xTickCount) && ((TickType_t)(xNextTime - xDelayedTaskWheelTime) > (TickType_t)(xTickCount - xDelayedTaskWheelTime))) {
+        /* The wheel next has to be processed after the tick count overflows.
+        As for a task in the overflow delayed list, xNextTaskUnblockTime is
+        set once the tick count has overflowed. */
+        xNextTaskUnblockTime = portMAX_DELAY;
+    }
+    else {
+        xNextTaskUnblockTime = xNextTime;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertTaskInDelayedTaskWheel(TCB_t *const pxTCB)
+{
+    const TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE(&(pxTCB->xStateListItem));
+    const TickType_t xTicksToWake = (TickType_t)(xTimeToWake - xDelayedTaskWheelTime);
+    UBaseType_t uxLevel = 0, uxSlot;
+
+    /* Use the lowest level that spans the time to the wake time. */
+    while ((uxLevel < (UBaseType_t)(taskWHEEL_LEVELS - 1)) && ((xTicksToWake >> (taskWHEEL_BITS * (uxLevel + 1))) != (TickType_t) 0U)) {
+        uxLevel++;
+    }
+
+    uxSlot = (UBaseType_t)(xTimeToWake >> (taskWHEEL_BITS * uxLevel)) & taskWHEEL_MASK;
+    vListInsertEnd(&(xDelayedTaskWheel[ (uxLevel << taskWHEEL_BITS) + uxSlot ]), &(pxTCB->xStateListItem));
+    ullDelayedTaskWheelOccupied[ uxLevel ] |= ((uint64_t) 1U) << uxSlot;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvGetNextDelayedTaskWheelTime(TickType_t *const pxNextTime)
+{
+    TickType_t xTicksToNext = portMAX_DELAY, xSpan, xLevelTime, xTicks;
+    BaseType_t xFound = pdFALSE, xLevelFound;
+    UBaseType_t uxLevel, uxFirst, uxOffset, uxSlot;
+    uint64_t ullOccupied;
+
+    for (uxLevel = 0; uxLevel < (UBaseType_t) taskWHEEL_LEVELS; uxLevel++) {
+        /* The first slot boundary of this level at or after the wheel time,
+        and its slot. */
+        xSpan = ((TickType_t) 1U) << (taskWHEEL_BITS * uxLevel);
+        xLevelTime = (TickType_t)((xDelayedTaskWheelTime + (xSpan - (TickType_t) 1U)) & (TickType_t) ~(xSpan - (TickType_t) 1U));
+        uxFirst = (UBaseType_t)(xLevelTime / xSpan) & taskWHEEL_MASK;
+        xLevelFound = pdFALSE;
+
+        while ((xLevelFound == pdFALSE) && (ullDelayedTaskWheelOccupied[ uxLevel ] != (uint64_t) 0U)) {
+            /* Rotate the occupied slots so that bit 0 is the first slot. */
+            ullOccupied = ullDelayedTaskWheelOccupied[ uxLevel ];
+            if (uxFirst != (UBaseType_t) 0U) {
+                ullOccupied = (ullOccupied >> uxFirst) | (ullOccupied << (taskWHEEL_SLOTS - uxFirst));
+            }
+
+            uxOffset = (UBaseType_t) __builtin_ctzll(ullOccupied);
+            uxSlot = (uxFirst + uxOffset) & taskWHEEL_MASK;
+
+            if (listLIST_IS_EMPTY(&(xDelayedTaskWheel[ (uxLevel << taskWHEEL_BITS) + uxSlot ])) != pdFALSE) {
+                /* The tasks of the slot have been unblocked, or have been
+                removed from it for another reason, since the bit was set. */
+                ullDelayedTaskWheelOccupied[ uxLevel ] &= ~(((uint64_t) 1U) << uxSlot);
+            }
+            else {
+                /* The distance to a slot of the top level may wrap the tick
+                count, which gives the right distance as the top level only
+                spans the tick count range once. */
+                xTicks = (TickType_t)((TickType_t)(xLevelTime - xDelayedTaskWheelTime) + ((TickType_t) uxOffset * xSpan));
+                if (xTicks < xTicksToNext) {
+                    xTicksToNext = xTicks;
+                }
+
+                xFound = pdTRUE;
+                xLevelFound = pdTRUE;
+            }
+        }
+    }
+
+    *pxNextTime = xDelayedTaskWheelTime + xTicksToNext;
+
+    return xFound;
+}
+/*-----------------------------------------------------------*/
+
+static TCB_t *prvGetDelayedTaskToUnblock(const TickType_t xTimeNow)
+{
+    TCB_t *pxTCB = NULL;
+    TickType_t xNextTime, xSpan;
+    UBaseType_t uxLevel;
+    List_t *pxSlot;
+
+    while ((pxTCB == NULL) && (xDelayedTaskWheelTime != (TickType_t)(xTimeNow + (TickType_t) 1U))) {
+        if ((prvGetNextDelayedTaskWheelTime(&xNextTime) == pdFALSE) || ((TickType_t)(xNextTime - xDelayedTaskWheelTime) > (TickType_t)(xTimeNow - xDelayedTaskWheelTime))) {
+            /* No slot is due up to xTimeNow. */
+            xDelayedTaskWheelTime = xTimeNow + (TickType_t) 1U;
+        }
+        else {
+            xDelayedTaskWheelTime = xNextTime;
+
+            /* Cascade the slot the wheel time has reached on each level whose
+            slot boundary the wheel time is on, nearest level first.  Once
+            cascaded a slot stays empty until the wheel time has moved on, so
+            it does not matter that this is repeated for each task unblocked
+            at the same time. */
+            for (uxLevel = 1, xSpan = (TickType_t) taskWHEEL_SLOTS; (uxLevel < (UBaseType_t) taskWHEEL_LEVELS) && ((xDelayedTaskWheelTime & (TickType_t)(xSpan - (TickType_t) 1U)) == (TickType_t) 0U); uxLevel++, xSpan <<= taskWHEEL_BITS) {
+                pxSlot = &(xDelayedTaskWheel[ (uxLevel << taskWHEEL_BITS) + ((UBaseType_t)(xDelayedTaskWheelTime / xSpan) & taskWHEEL_MASK) ]);
+                while (listLIST_IS_EMPTY(pxSlot) == pdFALSE) {
+                    pxTCB = (TCB_t *) listGET_OWNER_OF_HEAD_ENTRY(pxSlot);
+                    (void) uxListRemove(&(pxTCB->xStateListItem));
+                    prvInsertTaskInDelayedTaskWheel(pxTCB);
+                }
+            }
+
+            /* The tasks in the level 0 slot of the wheel time are due. */
+            pxSlot = &(xDelayedTaskWheel[ (UBaseType_t) xDelayedTaskWheelTime & taskWHEEL_MASK ]);
+            if (listLIST_IS_EMPTY(pxSlot) == pdFALSE) {
+                pxTCB = (TCB_t *) listGET_OWNER_OF_HEAD_ENTRY(pxSlot);
+            }
+            else {
+                pxTCB = NULL;
+                xDelayedTaskWheelTime++;
+            }
+        }
+    }
+
+    return pxTCB;
+}
+
+#else
+
 static void prvResetNextTaskUnblockTime(void)
 {
     TCB_t *pxTCB;
@@ -3409,23 +4224,39 @@ static void prvResetNextTaskUnblockTime(void)
         xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE(&((pxTCB)->xStateListItem));
     }
 }
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) )
 
 TaskHandle_t xTaskGetCurrentTaskHandle(void)
 {
     TaskHandle_t xReturn;
 
-    /* A critical section is not required as this is not called from
-    an interrupt and the current TCB will always be the same for any
-    individual execution thread. */
-    xReturn = pxCurrentTCB;
+#if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* A critical section is not required as this is not called from
+        an interrupt and the current TCB will always be the same for any
+        individual execution thread. */
+        xReturn = pxCurrentTCB;
+    }
+#else
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* Masking the interrupts of this core keeps the calling task from
+        moving to another core between reading the core ID and the TCB. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK();
+        xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+        portCLEAR_INTERRUPT_MASK(uxSavedInterruptStatus);
+    }
+#endif /* configNUMBER_OF_CORES */
 
     return xReturn;
 }
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) ) */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
@@ -3660,7 +4491,7 @@ static char *prvWriteNameToBuffer(char *pcBuffer, const char *pcTaskName)
 #endif /* ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
 void vTaskList(char *pcWriteBuffer)
 {
@@ -3700,9 +4531,7 @@ void vTaskList(char *pcWriteBuffer)
     function is executing. */
     uxArraySize = uxCurrentNumberOfTasks;
 
-    /* Allocate an array index for each task.  NOTE!  if
-    configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
-    equate to NULL. */
+    /* Allocate an array index for each task. */
     pxTaskStatusArray = pvPortMalloc(uxCurrentNumberOfTasks * sizeof(TaskStatus_t));
 
     if (pxTaskStatusArray != NULL) {
@@ -3739,8 +4568,7 @@ void vTaskList(char *pcWriteBuffer)
             pcWriteBuffer += strlen(pcWriteBuffer);
         }
 
-        /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-        is 0 then vPortFree() will be #defined to nothing. */
+        /* Free the array again. */
         vPortFree(pxTaskStatusArray);
     }
     else {
@@ -3748,16 +4576,16 @@ void vTaskList(char *pcWriteBuffer)
     }
 }
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*----------------------------------------------------------*/
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
 void vTaskGetRunTimeStats(char *pcWriteBuffer)
 {
     TaskStatus_t *pxTaskStatusArray;
     volatile UBaseType_t uxArraySize, x;
-    uint32_t ulTotalTime, ulStatsAsPercentage;
+    configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
 
 #if( configUSE_TRACE_FACILITY != 1 )
     {
@@ -3797,9 +4625,7 @@ void vTaskGetRunTimeStats(char *pcWriteBuffer)
     function is executing. */
     uxArraySize = uxCurrentNumberOfTasks;
 
-    /* Allocate an array index for each task.  NOTE!  If
-    configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
-    equate to NULL. */
+    /* Allocate an array index for each task. */
     pxTaskStatusArray = pvPortMalloc(uxCurrentNumberOfTasks * sizeof(TaskStatus_t));
 
     if (pxTaskStatusArray != NULL) {
@@ -3826,7 +4652,7 @@ void vTaskGetRunTimeStats(char *pcWriteBuffer)
                 if (ulStatsAsPercentage > 0UL) {
 #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
                     {
-                        sprintf(pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage);
+                        sprintf(pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", (unsigned long) pxTaskStatusArray[ x ].ulRunTimeCounter, (unsigned long) ulStatsAsPercentage);
                     }
 #else
                     {
@@ -3841,7 +4667,7 @@ void vTaskGetRunTimeStats(char *pcWriteBuffer)
                     consumed less than 1% of the total run time. */
 #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
                     {
-                        sprintf(pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter);
+                        sprintf(pcWriteBuffer, "\t%lu\t\t<1%%\r\n", (unsigned long) pxTaskStatusArray[ x ].ulRunTimeCounter);
                     }
 #else
                     {
@@ -3859,8 +4685,7 @@ void vTaskGetRunTimeStats(char *pcWriteBuffer)
             mtCOVERAGE_TEST_MARKER();
         }
 
-        /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-        is 0 then vPortFree() will be #defined to nothing. */
+        /* Free the array again. */
         vPortFree(pxTaskStatusArray);
     }
     else {
@@ -3868,7 +4693,7 @@ void vTaskGetRunTimeStats(char *pcWriteBuffer)
     }
 }
 
-#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
 TickType_t uxTaskResetEventItemValue(void)
@@ -4111,7 +4936,7 @@ BaseType_t xTaskGenericNotify(TaskHandle_t xTaskToNotify, uint32_t ulValue, eNot
             }
 #endif
 
-            if (pxTCB->uxPriority > pxCurrentTCB->uxPriority) {
+            if (taskYIELD_REQUIRED_FOR(pxTCB)) {
                 /* The notified task has a priority above the currently
                 executing task so a yield is required. */
                 taskYIELD_IF_USING_PREEMPTION();
@@ -4219,7 +5044,7 @@ BaseType_t xTaskGenericNotifyFromISR(TaskHandle_t xTaskToNotify, uint32_t ulValu
                 vListInsertEnd(&(xPendingReadyList), &(pxTCB->xEventListItem));
             }
 
-            if (pxTCB->uxPriority > pxCurrentTCB->uxPriority) {
+            if (taskYIELD_REQUIRED_FOR(pxTCB)) {
                 /* The notified task has a priority above the currently
                 executing task so a yield is required. */
                 if (pxHigherPriorityTaskWoken != NULL) {
@@ -4302,7 +5127,7 @@ void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPrio
                 vListInsertEnd(&(xPendingReadyList), &(pxTCB->xEventListItem));
             }
 
-            if (pxTCB->uxPriority > pxCurrentTCB->uxPriority) {
+            if (taskYIELD_REQUIRED_FOR(pxTCB)) {
                 /* The notified task has a priority above the currently
                 executing task so a yield is required. */
                 if (pxHigherPriorityTaskWoken != NULL) {
@@ -4399,26 +5224,45 @@ static void prvAddCurrentTaskToDelayedList(TickType_t xTicksToWait, const BaseTy
             /* The list item will be inserted in wake time order. */
             listSET_LIST_ITEM_VALUE(&(pxCurrentTCB->xStateListItem), xTimeToWake);
 
-            if (xTimeToWake < xConstTickCount) {
-                /* Wake time has overflowed.  Place this item in the overflow
-                list. */
-                vListInsert(pxOverflowDelayedTaskList, &(pxCurrentTCB->xStateListItem));
-            }
-            else {
-                /* The wake time has not overflowed, so the current block list
-                is used. */
-                vListInsert(pxDelayedTaskList, &(pxCurrentTCB->xStateListItem));
-
-                /* If the task entering the blocked state was placed at the
-                head of the list of blocked tasks then xNextTaskUnblockTime
-                needs to be updated too. */
-                if (xTimeToWake < xNextTaskUnblockTime) {
-                    xNextTaskUnblockTime = xTimeToWake;
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+            {
+                /* Unless the tick count has been stepped onto
+                xNextTaskUnblockTime, no slot of the delayed task wheel is due
+                up to the tick count, so the wheel can skip to it. */
+                if (xConstTickCount < xNextTaskUnblockTime) {
+                    xDelayedTaskWheelTime = xConstTickCount + (TickType_t) 1U;
                 }
                 else {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                prvInsertTaskInDelayedTaskWheel(pxCurrentTCB);
+                prvResetNextTaskUnblockTime();
             }
+#else
+            {
+                if (xTimeToWake < xConstTickCount) {
+                    /* Wake time has overflowed.  Place this item in the overflow
+                    list. */
+                    vListInsert(pxOverflowDelayedTaskList, &(pxCurrentTCB->xStateListItem));
+                }
+                else {
+                    /* The wake time has not overflowed, so the current block list
+                    is used. */
+                    vListInsert(pxDelayedTaskList, &(pxCurrentTCB->xStateListItem));
+
+                    /* If the task entering the blocked state was placed at the
+                    head of the list of blocked tasks then xNextTaskUnblockTime
+                    needs to be updated too. */
+                    if (xTimeToWake < xNextTaskUnblockTime) {
+                        xNextTaskUnblockTime = xTimeToWake;
+                    }
+                    else {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+#endif /* configUSE_DELAYED_TASK_WHEEL */
         }
     }
 #else /* INCLUDE_vTaskSuspend */
@@ -4431,30 +5275,81 @@ static void prvAddCurrentTaskToDelayedList(TickType_t xTicksToWait, const BaseTy
         /* The list item will be inserted in wake time order. */
         listSET_LIST_ITEM_VALUE(&(pxCurrentTCB->xStateListItem), xTimeToWake);
 
-        if (xTimeToWake < xConstTickCount) {
-            /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert(pxOverflowDelayedTaskList, &(pxCurrentTCB->xStateListItem));
-        }
-        else {
-            /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert(pxDelayedTaskList, &(pxCurrentTCB->xStateListItem));
-
-            /* If the task entering the blocked state was placed at the head of the
-            list of blocked tasks then xNextTaskUnblockTime needs to be updated
-            too. */
-            if (xTimeToWake < xNextTaskUnblockTime) {
-                xNextTaskUnblockTime = xTimeToWake;
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+        {
+            /* Unless the tick count has been stepped onto
+            xNextTaskUnblockTime, no slot of the delayed task wheel is due
+            up to the tick count, so the wheel can skip to it. */
+            if (xConstTickCount < xNextTaskUnblockTime) {
+                xDelayedTaskWheelTime = xConstTickCount + (TickType_t) 1U;
             }
             else {
                 mtCOVERAGE_TEST_MARKER();
             }
+
+            prvInsertTaskInDelayedTaskWheel(pxCurrentTCB);
+            prvResetNextTaskUnblockTime();
+        }
+#else
+        {
+            if (xTimeToWake < xConstTickCount) {
+                /* Wake time has overflowed.  Place this item in the overflow list. */
+                vListInsert(pxOverflowDelayedTaskList, &(pxCurrentTCB->xStateListItem));
+            }
+            else {
+                /* The wake time has not overflowed, so the current block list is used. */
+                vListInsert(pxDelayedTaskList, &(pxCurrentTCB->xStateListItem));
+
+                /* If the task entering the blocked state was placed at the head of the
+                list of blocked tasks then xNextTaskUnblockTime needs to be updated
+                too. */
+                if (xTimeToWake < xNextTaskUnblockTime) {
+                    xNextTaskUnblockTime = xTimeToWake;
+                }
+                else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
         }
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 
         /* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
         (void) xCanBlockIndefinitely;
     }
 #endif /* INCLUDE_vTaskSuspend */
 }
+/*-----------------------------------------------------------*/
+
+#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configKERNEL_PROVIDED_STATIC_MEMORY == 1 ) )
+
+/* The buffers are at file scope as portREMOVE_STATIC_QUALIFIER would turn
+static variables within the functions into locals. */
+PRIVILEGED_DATA static StaticTask_t xIdleTaskTCBBuffer;
+PRIVILEGED_DATA static StackType_t uxIdleTaskStackBuffer[ configMINIMAL_STACK_SIZE ];
+
+void vApplicationGetIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize)
+{
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCBBuffer;
+    *ppxIdleTaskStackBuffer = uxIdleTaskStackBuffer;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+PRIVILEGED_DATA static StaticTask_t xPassiveIdleTaskTCBBuffers[ configNUMBER_OF_CORES - 1 ];
+PRIVILEGED_DATA static StackType_t uxPassiveIdleTaskStackBuffers[ configNUMBER_OF_CORES - 1 ][ configMINIMAL_STACK_SIZE ];
+
+void vApplicationGetPassiveIdleTaskMemory(StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex)
+{
+    *ppxIdleTaskTCBBuffer = &xPassiveIdleTaskTCBBuffers[ xPassiveIdleTaskIndex ];
+    *ppxIdleTaskStackBuffer = uxPassiveIdleTaskStackBuffers[ xPassiveIdleTaskIndex ];
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+#endif /* configNUMBER_OF_CORES */
+
+#endif /* configKERNEL_PROVIDED_STATIC_MEMORY */
 
 
 #ifdef FREERTOS_MODULE_TEST
@@ -79,6 +79,7 @@ task.h is included from an application file. */
 #include "task.h"
 #include "queue.h"
 #include "timers.h"
+#include "object_pool.h"
 
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
 #error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
@@ -100,6 +101,10 @@ configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
 /* Misc definitions. */
 #define tmrNO_DELAY     ( TickType_t ) 0U
 
+/* The number of commands the timer service task receives from the timer queue
+at a time. */
+#define tmrCOMMAND_BATCH_LENGTH ( ( UBaseType_t ) 8U )
+
 /* The definition of the timers themselves. */
 typedef struct tmrTimerControl {
     const char              *pcTimerName;       /*<< Text name.  This is not used by the kernel, it is included simply to make debugging easier. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
@@ -156,6 +161,32 @@ typedef struct tmrTimerQueueMessage {
 /*lint -e956 A manual analysis and inspection has been used to determine which
 static variables must be declared volatile. */
 
+#if( configUSE_TIMER_WHEEL == 1 )
+
+/* The hierarchical timer wheel in which active timers are stored.  A slot of
+level n spans tmrWHEEL_SLOTS^n ticks, so level 0 holds the timers that expire
+within the next tmrWHEEL_SLOTS ticks, one slot per tick, and every further
+level holds the timers that expire tmrWHEEL_SLOTS times further out.  Timers
+are appended to the slot of their expiry time, and the slots of the upper
+levels are cascaded down a level once the wheel time reaches them, so
+inserting, removing and expiring a timer does not depend on the number of
+active timers.  A bit per slot records which slots are occupied.  Only the
+timer service task is allowed to access the wheel. */
+#define tmrWHEEL_BITS       ( 6 )
+#define tmrWHEEL_SLOTS      ( 1 << tmrWHEEL_BITS )
+#define tmrWHEEL_MASK       ( ( UBaseType_t ) tmrWHEEL_SLOTS - 1 )
+#define tmrWHEEL_LEVELS     ( ( ( sizeof( TickType_t ) * 8 ) + tmrWHEEL_BITS - 1 ) / tmrWHEEL_BITS )
+
+PRIVILEGED_DATA static List_t xTimerWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+PRIVILEGED_DATA static uint64_t ullWheelOccupied[ tmrWHEEL_LEVELS ];
+PRIVILEGED_DATA static UBaseType_t uxWheelTimers = (UBaseType_t) 0U;
+
+/* The next tick the wheel has to process.  Every tick before it has been
+processed. */
+PRIVILEGED_DATA static TickType_t xWheelTime = (TickType_t) 0U;
+
+#else
+
 /* The list in which active timers are stored.  Timers are referenced in expire
 time order, with the nearest expiry time at the front of the list.  Only the
 timer service task is allowed to access these lists. */
@@ -164,6 +195,8 @@ PRIVILEGED_DATA static List_t xActiveTimerList2;
 PRIVILEGED_DATA static List_t *pxCurrentTimerList;
 PRIVILEGED_DATA static List_t *pxOverflowTimerList;
 
+#endif /* configUSE_TIMER_WHEEL */
+
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
 PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
@@ -203,10 +236,33 @@ static void prvProcessReceivedCommands(void) PRIVILEGED_FUNCTION;
 
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * depending on if the expire time causes a timer counter overflow, or into the
+ * timer wheel if configUSE_TIMER_WHEEL is 1.
  */
 static BaseType_t prvInsertTimerInActiveList(Timer_t *const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime) PRIVILEGED_FUNCTION;
 
+/*
+ * Remove the timer from the active timers it is referenced from.
+ */
+static void prvRemoveTimerFromActiveList(Timer_t *const pxTimer) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Append the timer to the slot of the timer wheel that holds its expiry time,
+ * relative to the wheel time.
+ */
+static void prvInsertTimerInWheel(Timer_t *const pxTimer) PRIVILEGED_FUNCTION;
+
+/*
+ * Process every tick of the timer wheel up to and including xTimeNow.  Skips
+ * the ticks at which no slot is due, cascades the slots of the upper levels
+ * the wheel time reaches, and expires the timers of the level 0 slots.
+ */
+static void prvAdvanceTimerWheel(const TickType_t xTimeNow) PRIVILEGED_FUNCTION;
+
+#else
+
 /*
  * An active timer has reached its expire time.  Reload the timer if it is an
  * auto reload timer, then call its callback.
@@ -219,6 +275,8 @@ static void prvProcessExpiredTimer(const TickType_t xNextExpireTime, const TickT
  */
 static void prvSwitchTimerLists(void) PRIVILEGED_FUNCTION;
 
+#endif /* configUSE_TIMER_WHEEL */
+
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
  * if a tick count overflow occurred since prvSampleTimeNow() was last called.
@@ -312,7 +370,7 @@ TimerHandle_t xTimerCreate(const char *const pcTimerName,
 {
     Timer_t *pxNewTimer;
 
-    pxNewTimer = (Timer_t *) pvPortMalloc(sizeof(Timer_t));
+    pxNewTimer = (Timer_t *) pvObjectPoolAllocate(eTimerPool, sizeof(Timer_t));
 
     if (pxNewTimer != NULL) {
         prvInitialiseNewTimer(pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer);
@@ -479,6 +537,8 @@ const char *pcTimerGetName(TimerHandle_t xTimer)    /*lint !e971 Unqualified cha
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 0 )
+
 static void prvProcessExpiredTimer(const TickType_t xNextExpireTime, const TickType_t xTimeNow)
 {
     BaseType_t xResult;
@@ -513,6 +573,8 @@ static void prvProcessExpiredTimer(const TickType_t xNextExpireTime, const TickT
     /* Call the timer callback. */
     pxTimer->pxCallbackFunction((TimerHandle_t) pxTimer);
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvTimerTask(void *pvParameters)
@@ -565,10 +627,17 @@ static void prvProcessTimerOrBlockTask(const TickType_t xNextExpireTime, BaseTyp
         xTimeNow = prvSampleTimeNow(&xTimerListsWereSwitched);
         if (xTimerListsWereSwitched == pdFALSE) {
             /* The tick count has not overflowed, has the timer expired? */
+#if( configUSE_TIMER_WHEEL == 1 )
+            if ((xListWasEmpty == pdFALSE) && ((TickType_t)(xNextExpireTime - xWheelTime) < (TickType_t)((xTimeNow + (TickType_t) 1U) - xWheelTime))) {
+                (void) xTaskResumeAll();
+                prvAdvanceTimerWheel(xTimeNow);
+            }
+#else
             if ((xListWasEmpty == pdFALSE) && (xNextExpireTime <= xTimeNow)) {
                 (void) xTaskResumeAll();
                 prvProcessExpiredTimer(xNextExpireTime, xTimeNow);
             }
+#endif /* configUSE_TIMER_WHEEL */
             else {
                 /* The tick count has not overflowed, and the next expire
                 time has not been reached yet.  This task should therefore
@@ -576,11 +645,13 @@ static void prvProcessTimerOrBlockTask(const TickType_t xNextExpireTime, BaseTyp
                 received - whichever comes first.  The following line cannot
                 be reached unless xNextExpireTime > xTimeNow, except in the
                 case when the current timer list is empty. */
+#if( configUSE_TIMER_WHEEL == 0 )
                 if (xListWasEmpty != pdFALSE) {
                     /* The current timer list is empty - is the overflow list
                     also empty? */
                     xListWasEmpty = listLIST_IS_EMPTY(pxOverflowTimerList);
                 }
+#endif /* configUSE_TIMER_WHEEL */
 
                 vQueueWaitForMessageRestricted(xTimerQueue, (xNextExpireTime - xTimeNow), xListWasEmpty);
 
@@ -603,6 +674,54 @@ static void prvProcessTimerOrBlockTask(const TickType_t xNextExpireTime, BaseTyp
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 1 )
+
+static TickType_t prvGetNextExpireTime(BaseType_t *const pxListWasEmpty)
+{
+    TickType_t xNextExpireTime, xTicksToNext = portMAX_DELAY, xTicks, xSpan, xLevelTime;
+    UBaseType_t uxLevel, uxSlot;
+    uint64_t ullOccupied;
+
+    /* The wheel has to be processed next at the expiry time of the first
+    occupied level 0 slot, or at the time the first occupied slot of an upper
+    level has to be cascaded, whichever comes first.  As for the timer lists,
+    the next expire time is 0 if there are no active timers. */
+    *pxListWasEmpty = (uxWheelTimers == (UBaseType_t) 0U) ? pdTRUE : pdFALSE;
+    if (*pxListWasEmpty == pdFALSE) {
+        for (uxLevel = 0; uxLevel < (UBaseType_t) tmrWHEEL_LEVELS; uxLevel++) {
+            ullOccupied = ullWheelOccupied[ uxLevel ];
+            if (ullOccupied != (uint64_t) 0U) {
+                /* Rotate the occupied slots so that bit 0 is the slot of the
+                first slot boundary of this level at or after the wheel time.
+                The distance to a slot of the top level may wrap the tick
+                count, which gives the right distance as the top level only
+                spans the tick count range once. */
+                xSpan = ((TickType_t) 1U) << (tmrWHEEL_BITS * uxLevel);
+                xLevelTime = (TickType_t)((xWheelTime + (xSpan - (TickType_t) 1U)) & (TickType_t) ~(xSpan - (TickType_t) 1U));
+                uxSlot = (UBaseType_t)(xLevelTime / xSpan) & tmrWHEEL_MASK;
+                if (uxSlot != (UBaseType_t) 0U) {
+                    ullOccupied = (ullOccupied >> uxSlot) | (ullOccupied << (tmrWHEEL_SLOTS - uxSlot));
+                }
+
+                xTicks = (TickType_t)((TickType_t)(xLevelTime - xWheelTime) + ((TickType_t) __builtin_ctzll(ullOccupied) * xSpan));
+                if (xTicks < xTicksToNext) {
+                    xTicksToNext = xTicks;
+                }
+            }
+        }
+
+        xNextExpireTime = xWheelTime + xTicksToNext;
+    }
+    else {
+        /* Ensure the task blocks until a command is received. */
+        xNextExpireTime = (TickType_t) 0U;
+    }
+
+    return xNextExpireTime;
+}
+
+#else
+
 static TickType_t prvGetNextExpireTime(BaseType_t *const pxListWasEmpty)
 {
     TickType_t xNextExpireTime;
@@ -625,24 +744,47 @@ static TickType_t prvGetNextExpireTime(BaseType_t *const pxListWasEmpty)
 
     return xNextExpireTime;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static TickType_t prvSampleTimeNow(BaseType_t *const pxTimerListsWereSwitched)
 {
     TickType_t xTimeNow;
+#if( configUSE_TIMER_WHEEL == 0 )
     PRIVILEGED_DATA static TickType_t xLastTime = (TickType_t) 0U;   /*lint !e956 Variable is only accessible to one task. */
+#endif
 
     xTimeNow = xTaskGetTickCount();
 
-    if (xTimeNow < xLastTime) {
-        prvSwitchTimerLists();
-        *pxTimerListsWereSwitched = pdTRUE;
-    }
-    else {
+#if( configUSE_TIMER_WHEEL == 1 )
+    {
+        /* The wheel counts the ticks modulo the tick count range, so there
+        are no lists to switch when the tick count overflows.  The wheel is
+        not advanced while no timer is active, bring it up to the time now so
+        that the next timer is inserted relative to it. */
+        if (uxWheelTimers == (UBaseType_t) 0U) {
+            xWheelTime = xTimeNow + (TickType_t) 1U;
+        }
+        else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
         *pxTimerListsWereSwitched = pdFALSE;
     }
+#else
+    {
+        if (xTimeNow < xLastTime) {
+            prvSwitchTimerLists();
+            *pxTimerListsWereSwitched = pdTRUE;
+        }
+        else {
+            *pxTimerListsWereSwitched = pdFALSE;
+        }
 
-    xLastTime = xTimeNow;
+        xLastTime = xTimeNow;
+    }
+#endif /* configUSE_TIMER_WHEEL */
 
     return xTimeNow;
 }
@@ -655,168 +797,300 @@ static BaseType_t prvInsertTimerInActiveList(Timer_t *const pxTimer, const TickT
     listSET_LIST_ITEM_VALUE(&(pxTimer->xTimerListItem), xNextExpiryTime);
     listSET_LIST_ITEM_OWNER(&(pxTimer->xTimerListItem), pxTimer);
 
-    if (xNextExpiryTime <= xTimeNow) {
-        /* Has the expiry time elapsed between the command to start/reset a
-        timer was issued, and the time the command was processed? */
+#if( configUSE_TIMER_WHEEL == 1 )
+    {
+        /* The wheel counts the ticks modulo the tick count range, so it only
+        has to be checked whether the expiry time elapsed between the command
+        to start/reset the timer being issued and being processed. */
         if (((TickType_t)(xTimeNow - xCommandTime)) >= pxTimer->xTimerPeriodInTicks) {       /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-            /* The time between a command being issued and the command being
-            processed actually exceeds the timers period.  */
             xProcessTimerNow = pdTRUE;
         }
         else {
-            vListInsert(pxOverflowTimerList, &(pxTimer->xTimerListItem));
+            prvInsertTimerInWheel(pxTimer);
         }
     }
-    else {
-        if ((xTimeNow < xCommandTime) && (xNextExpiryTime >= xCommandTime)) {
-            /* If, since the command was issued, the tick count has overflowed
-            but the expiry time has not, then the timer must have already passed
-            its expiry time and should be processed immediately. */
-            xProcessTimerNow = pdTRUE;
+#else
+    {
+        if (xNextExpiryTime <= xTimeNow) {
+            /* Has the expiry time elapsed between the command to start/reset a
+            timer was issued, and the time the command was processed? */
+            if (((TickType_t)(xTimeNow - xCommandTime)) >= pxTimer->xTimerPeriodInTicks) {       /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                /* The time between a command being issued and the command being
+                processed actually exceeds the timers period.  */
+                xProcessTimerNow = pdTRUE;
+            }
+            else {
+                vListInsert(pxOverflowTimerList, &(pxTimer->xTimerListItem));
+            }
         }
         else {
-            vListInsert(pxCurrentTimerList, &(pxTimer->xTimerListItem));
+            if ((xTimeNow < xCommandTime) && (xNextExpiryTime >= xCommandTime)) {
+                /* If, since the command was issued, the tick count has overflowed
+                but the expiry time has not, then the timer must have already passed
+                its expiry time and should be processed immediately. */
+                xProcessTimerNow = pdTRUE;
+            }
+            else {
+                vListInsert(pxCurrentTimerList, &(pxTimer->xTimerListItem));
+            }
         }
     }
+#endif /* configUSE_TIMER_WHEEL */
 
     return xProcessTimerNow;
 }
 /*-----------------------------------------------------------*/
 
+static void prvRemoveTimerFromActiveList(Timer_t *const pxTimer)
+{
+#if( configUSE_TIMER_WHEEL == 1 )
+    {
+        /* The index of the slot the timer is referenced from, counted from the
+        first slot of level 0. */
+        const UBaseType_t uxSlot = (UBaseType_t)((List_t *) listLIST_ITEM_CONTAINER(&(pxTimer->xTimerListItem)) - &(xTimerWheel[ 0 ][ 0 ]));
+
+        if (uxListRemove(&(pxTimer->xTimerListItem)) == (UBaseType_t) 0U) {
+            ullWheelOccupied[ uxSlot / tmrWHEEL_SLOTS ] &= ~(((uint64_t) 1U) << (uxSlot & tmrWHEEL_MASK));
+        }
+        else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxWheelTimers--;
+    }
+#else
+    {
+        (void) uxListRemove(&(pxTimer->xTimerListItem));
+    }
+#endif /* configUSE_TIMER_WHEEL */
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+static void prvInsertTimerInWheel(Timer_t *const pxTimer)
+{
+    const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE(&(pxTimer->xTimerListItem));
+    const TickType_t xTicksToExpiry = (TickType_t)(xExpiryTime - xWheelTime);
+    UBaseType_t uxLevel = 0, uxSlot;
+
+    /* Use the lowest level that spans the time to the expiry.  A timer that
+    expires at the wheel time goes into the level 0 slot about to be
+    processed. */
+    while ((uxLevel < (UBaseType_t)(tmrWHEEL_LEVELS - 1)) && ((xTicksToExpiry >> (tmrWHEEL_BITS * (uxLevel + 1))) != (TickType_t) 0U)) {
+        uxLevel++;
+    }
+
+    uxSlot = (UBaseType_t)(xExpiryTime >> (tmrWHEEL_BITS * uxLevel)) & tmrWHEEL_MASK;
+    vListInsertEnd(&(xTimerWheel[ uxLevel ][ uxSlot ]), &(pxTimer->xTimerListItem));
+    ullWheelOccupied[ uxLevel ] |= ((uint64_t) 1U) << uxSlot;
+    uxWheelTimers++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAdvanceTimerWheel(const TickType_t xTimeNow)
+{
+    TickType_t xNextTime;
+    BaseType_t xWheelWasEmpty;
+    UBaseType_t uxLevel, uxShift;
+    List_t *pxSlot;
+    Timer_t *pxTimer;
+
+    while (xWheelTime != (TickType_t)(xTimeNow + (TickType_t) 1U)) {
+        /* Skip the ticks at which no slot is due. */
+        xNextTime = prvGetNextExpireTime(&xWheelWasEmpty);
+        if ((xWheelWasEmpty != pdFALSE) || ((TickType_t)(xNextTime - xWheelTime) > (TickType_t)(xTimeNow - xWheelTime))) {
+            xWheelTime = xTimeNow + (TickType_t) 1U;
+        }
+        else {
+            xWheelTime = xNextTime;
+
+            /* Cascade the slot the wheel time has reached on each level whose
+            slot boundary the wheel time is on, nearest level first.  The
+            timers in it expire less than a slot of that level from now, so
+            all go into lower levels. */
+            for (uxLevel = 1, uxShift = tmrWHEEL_BITS; (uxLevel < (UBaseType_t) tmrWHEEL_LEVELS) && ((xWheelTime & (TickType_t)((((TickType_t) 1U) << uxShift) - (TickType_t) 1U)) == (TickType_t) 0U); uxLevel++, uxShift += tmrWHEEL_BITS) {
+                pxSlot = &(xTimerWheel[ uxLevel ][ (UBaseType_t)(xWheelTime >> uxShift) & tmrWHEEL_MASK ]);
+                while (listLIST_IS_EMPTY(pxSlot) == pdFALSE) {
+                    pxTimer = (Timer_t *) listGET_OWNER_OF_HEAD_ENTRY(pxSlot);
+                    prvRemoveTimerFromActiveList(pxTimer);
+                    prvInsertTimerInWheel(pxTimer);
+                }
+            }
+
+            /* Every timer in the level 0 slot of the wheel time expires now. */
+            pxSlot = &(xTimerWheel[ 0 ][ (UBaseType_t) xWheelTime & tmrWHEEL_MASK ]);
+            while (listLIST_IS_EMPTY(pxSlot) == pdFALSE) {
+                pxTimer = (Timer_t *) listGET_OWNER_OF_HEAD_ENTRY(pxSlot);
+                prvRemoveTimerFromActiveList(pxTimer);
+                traceTIMER_EXPIRED(pxTimer);
+
+                /* An auto reload timer is reloaded relative to the time it
+                expired, which never puts it back into the same slot. */
+                if (pxTimer->uxAutoReload == (UBaseType_t) pdTRUE) {
+                    listSET_LIST_ITEM_VALUE(&(pxTimer->xTimerListItem), (xWheelTime + pxTimer->xTimerPeriodInTicks));
+                    prvInsertTimerInWheel(pxTimer);
+                }
+                else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Call the timer callback. */
+                pxTimer->pxCallbackFunction((TimerHandle_t) pxTimer);
+            }
+
+            xWheelTime++;
+        }
+    }
+}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
 static void prvProcessReceivedCommands(void)
 {
-    DaemonTaskMessage_t xMessage;
+    DaemonTaskMessage_t xMessages[ tmrCOMMAND_BATCH_LENGTH ];
+    const DaemonTaskMessage_t *pxMessage;
+    UBaseType_t uxMessage, uxMessages;
     Timer_t *pxTimer;
     BaseType_t xTimerListsWereSwitched, xResult;
     TickType_t xTimeNow;
 
-    while (xQueueReceive(xTimerQueue, &xMessage, tmrNO_DELAY) != pdFAIL) {  /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+    /* Receive the commands a batch at a time, which takes the queue's critical
+    section once per batch rather than once per command. */
+    while ((uxMessages = (UBaseType_t) xQueueReceiveMultiple(xTimerQueue, xMessages, tmrCOMMAND_BATCH_LENGTH, tmrNO_DELAY)) != (UBaseType_t) 0U) {
+        for (uxMessage = 0; uxMessage < uxMessages; uxMessage++) {
+            pxMessage = &(xMessages[ uxMessage ]);
+
 #if ( INCLUDE_xTimerPendFunctionCall == 1 )
-        {
-            /* Negative commands are pended function calls rather than timer
-            commands. */
-            if (xMessage.xMessageID < (BaseType_t) 0) {
-                const CallbackParameters_t *const pxCallback = &(xMessage.u.xCallbackParameters);
+            {
+                /* Negative commands are pended function calls rather than timer
+                commands. */
+                if (pxMessage->xMessageID < (BaseType_t) 0) {
+                    const CallbackParameters_t *const pxCallback = &(pxMessage->u.xCallbackParameters);
 
-                /* The timer uses the xCallbackParameters member to request a
-                callback be executed.  Check the callback is not NULL. */
-                configASSERT(pxCallback);
+                    /* The timer uses the xCallbackParameters member to request a
+                    callback be executed.  Check the callback is not NULL. */
+                    configASSERT(pxCallback);
 
-                /* Call the function. */
-                pxCallback->pxCallbackFunction(pxCallback->pvParameter1, pxCallback->ulParameter2);
-            }
-            else {
-                mtCOVERAGE_TEST_MARKER();
+                    /* Call the function. */
+                    pxCallback->pxCallbackFunction(pxCallback->pvParameter1, pxCallback->ulParameter2);
+                }
+                else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-        }
 #endif /* INCLUDE_xTimerPendFunctionCall */
 
-        /* Commands that are positive are timer commands rather than pended
-        function calls. */
-        if (xMessage.xMessageID >= (BaseType_t) 0) {
-            /* The messages uses the xTimerParameters member to work on a
-            software timer. */
-            pxTimer = xMessage.u.xTimerParameters.pxTimer;
+            /* Commands that are positive are timer commands rather than pended
+            function calls. */
+            if (pxMessage->xMessageID >= (BaseType_t) 0) {
+                /* The messages uses the xTimerParameters member to work on a
+                software timer. */
+                pxTimer = pxMessage->u.xTimerParameters.pxTimer;
 
-            if (listIS_CONTAINED_WITHIN(NULL, &(pxTimer->xTimerListItem)) == pdFALSE) {
-                /* The timer is in a list, remove it. */
-                (void) uxListRemove(&(pxTimer->xTimerListItem));
-            }
-            else {
-                mtCOVERAGE_TEST_MARKER();
-            }
+                if (listIS_CONTAINED_WITHIN(NULL, &(pxTimer->xTimerListItem)) == pdFALSE) {
+                    /* The timer is in a list, remove it. */
+                    prvRemoveTimerFromActiveList(pxTimer);
+                }
+                else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-            traceTIMER_COMMAND_RECEIVED(pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue);
-
-            /* In this case the xTimerListsWereSwitched parameter is not used, but
-            it must be present in the function call.  prvSampleTimeNow() must be
-            called after the message is received from xTimerQueue so there is no
-            possibility of a higher priority task adding a message to the message
-            queue with a time that is ahead of the timer daemon task (because it
-            pre-empted the timer daemon task after the xTimeNow value was set). */
-            xTimeNow = prvSampleTimeNow(&xTimerListsWereSwitched);
-
-            switch (xMessage.xMessageID) {
-                case tmrCOMMAND_START :
-                case tmrCOMMAND_START_FROM_ISR :
-                case tmrCOMMAND_RESET :
-                case tmrCOMMAND_RESET_FROM_ISR :
-                case tmrCOMMAND_START_DONT_TRACE :
-                    /* Start or restart a timer. */
-                    if (prvInsertTimerInActiveList(pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue) != pdFALSE) {
-                        /* The timer expired before it was added to the active
-                        timer list.  Process it now. */
-                        pxTimer->pxCallbackFunction((TimerHandle_t) pxTimer);
-                        traceTIMER_EXPIRED(pxTimer);
-
-                        if (pxTimer->uxAutoReload == (UBaseType_t) pdTRUE) {
-                            xResult = xTimerGenericCommand(pxTimer, tmrCOMMAND_START_DONT_TRACE, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY);
-                            configASSERT(xResult);
-                            (void) xResult;
+                traceTIMER_COMMAND_RECEIVED(pxTimer, pxMessage->xMessageID, pxMessage->u.xTimerParameters.xMessageValue);
+
+                /* In this case the xTimerListsWereSwitched parameter is not used, but
+                it must be present in the function call.  prvSampleTimeNow() must be
+                called after the message is received from xTimerQueue so there is no
+                possibility of a higher priority task adding a message to the message
+                queue with a time that is ahead of the timer daemon task (because it
+                pre-empted the timer daemon task after the xTimeNow value was set). */
+                xTimeNow = prvSampleTimeNow(&xTimerListsWereSwitched);
+
+                switch (pxMessage->xMessageID) {
+                    case tmrCOMMAND_START :
+                    case tmrCOMMAND_START_FROM_ISR :
+                    case tmrCOMMAND_RESET :
+                    case tmrCOMMAND_RESET_FROM_ISR :
+                    case tmrCOMMAND_START_DONT_TRACE :
+                        /* Start or restart a timer. */
+                        if (prvInsertTimerInActiveList(pxTimer,  pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, pxMessage->u.xTimerParameters.xMessageValue) != pdFALSE) {
+                            /* The timer expired before it was added to the active
+                            timer list.  Process it now. */
+                            pxTimer->pxCallbackFunction((TimerHandle_t) pxTimer);
+                            traceTIMER_EXPIRED(pxTimer);
+
+                            if (pxTimer->uxAutoReload == (UBaseType_t) pdTRUE) {
+                                xResult = xTimerGenericCommand(pxTimer, tmrCOMMAND_START_DONT_TRACE, pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, NULL, tmrNO_DELAY);
+                                configASSERT(xResult);
+                                (void) xResult;
+                            }
+                            else {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
                         }
                         else {
                             mtCOVERAGE_TEST_MARKER();
                         }
-                    }
-                    else {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                    break;
-
-                case tmrCOMMAND_STOP :
-                case tmrCOMMAND_STOP_FROM_ISR :
-                    /* The timer has already been removed from the active list.
-                    There is nothing to do here. */
-                    break;
-
-                case tmrCOMMAND_CHANGE_PERIOD :
-                case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
-                    pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-                    configASSERT((pxTimer->xTimerPeriodInTicks > 0));
-
-                    /* The new period does not really have a reference, and can
-                    be longer or shorter than the old one.  The command time is
-                    therefore set to the current time, and as the period cannot
-                    be zero the next expiry time can only be in the future,
-                    meaning (unlike for the xTimerStart() case above) there is
-                    no fail case that needs to be handled here. */
-                    (void) prvInsertTimerInActiveList(pxTimer, (xTimeNow + pxTimer->xTimerPeriodInTicks), xTimeNow, xTimeNow);
-                    break;
-
-                case tmrCOMMAND_DELETE :
-                    /* The timer has already been removed from the active list,
-                    just free up the memory if the memory was dynamically
-                    allocated. */
+                        break;
+
+                    case tmrCOMMAND_STOP :
+                    case tmrCOMMAND_STOP_FROM_ISR :
+                        /* The timer has already been removed from the active list.
+                        There is nothing to do here. */
+                        break;
+
+                    case tmrCOMMAND_CHANGE_PERIOD :
+                    case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
+                        pxTimer->xTimerPeriodInTicks = pxMessage->u.xTimerParameters.xMessageValue;
+                        configASSERT((pxTimer->xTimerPeriodInTicks > 0));
+
+                        /* The new period does not really have a reference, and can
+                        be longer or shorter than the old one.  The command time is
+                        therefore set to the current time, and as the period cannot
+                        be zero the next expiry time can only be in the future,
+                        meaning (unlike for the xTimerStart() case above) there is
+                        no fail case that needs to be handled here. */
+                        (void) prvInsertTimerInActiveList(pxTimer, (xTimeNow + pxTimer->xTimerPeriodInTicks), xTimeNow, xTimeNow);
+                        break;
+
+                    case tmrCOMMAND_DELETE :
+                        /* The timer has already been removed from the active list,
+                        just free up the memory if the memory was dynamically
+                        allocated. */
 #if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-                    {
-                        /* The timer can only have been allocated dynamically -
-                        free it again. */
-                        vPortFree(pxTimer);
-                    }
-#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-                    {
-                        /* The timer could have been allocated statically or
-                        dynamically, so check before attempting to free the
-                        memory. */
-                        if (pxTimer->ucStaticallyAllocated == (uint8_t) pdFALSE) {
-                            vPortFree(pxTimer);
+                        {
+                            /* The timer can only have been allocated dynamically -
+                            free it again. */
+                            vObjectPoolFree(eTimerPool, pxTimer);
                         }
-                        else {
-                            mtCOVERAGE_TEST_MARKER();
+#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+                        {
+                            /* The timer could have been allocated statically or
+                            dynamically, so check before attempting to free the
+                            memory. */
+                            if (pxTimer->ucStaticallyAllocated == (uint8_t) pdFALSE) {
+                                vObjectPoolFree(eTimerPool, pxTimer);
+                            }
+                            else {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
                         }
-                    }
 #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-                    break;
+                        break;
 
-                default :
-                    /* Don't expect to get here. */
-                    break;
+                    default :
+                        /* Don't expect to get here. */
+                        break;
+                }
             }
         }
     }
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 0 )
+
 static void prvSwitchTimerLists(void)
 {
     TickType_t xNextExpireTime, xReloadTime;
@@ -869,6 +1143,8 @@ static void prvSwitchTimerLists(void)
     pxCurrentTimerList = pxOverflowTimerList;
     pxOverflowTimerList = pxTemp;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue(void)
@@ -879,10 +1155,24 @@ static void prvCheckForValidListAndQueue(void)
     taskENTER_CRITICAL();
     {
         if (xTimerQueue == NULL) {
-            vListInitialise(&xActiveTimerList1);
-            vListInitialise(&xActiveTimerList2);
-            pxCurrentTimerList = &xActiveTimerList1;
-            pxOverflowTimerList = &xActiveTimerList2;
+#if( configUSE_TIMER_WHEEL == 1 )
+            {
+                UBaseType_t uxLevel, uxSlot;
+
+                for (uxLevel = 0; uxLevel < (UBaseType_t) tmrWHEEL_LEVELS; uxLevel++) {
+                    for (uxSlot = 0; uxSlot < (UBaseType_t) tmrWHEEL_SLOTS; uxSlot++) {
+                        vListInitialise(&(xTimerWheel[ uxLevel ][ uxSlot ]));
+                    }
+                }
+            }
+#else
+            {
+                vListInitialise(&xActiveTimerList1);
+                vListInitialise(&xActiveTimerList2);
+                pxCurrentTimerList = &xActiveTimerList1;
+                pxOverflowTimerList = &xActiveTimerList2;
+            }
+#endif /* configUSE_TIMER_WHEEL */
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
             {
@@ -1023,6 +1313,21 @@ BaseType_t xTimerPendFunctionCall(PendedFunction_t xFunctionToPend, void *pvPara
 #endif /* INCLUDE_xTimerPendFunctionCall */
 /*-----------------------------------------------------------*/
 
+#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configKERNEL_PROVIDED_STATIC_MEMORY == 1 ) )
+
+void vApplicationGetTimerTaskMemory(StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize)
+{
+    static StaticTask_t xTimerTaskTCB;
+    static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+    *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+    *ppxTimerTaskStackBuffer = uxTimerTaskStack;
+    *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+
+#endif /* configKERNEL_PROVIDED_STATIC_MEMORY */
+/*-----------------------------------------------------------*/
+
 /* This entire source file will be skipped if the application is not configured
 to include software timer functionality.  If you want to include software timer
 functionality then ensure configUSE_TIMERS is set to 1 in FreeRTOSConfig.h. */
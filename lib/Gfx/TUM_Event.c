@@ -23,10 +23,12 @@
 
 #include <linux/unistd.h>
 #include <assert.h>
+#include <string.h>
 
 #include "TUM_Event.h"
 #include "task.h"
 #include "semphr.h"
+#include "block_pool.h"
 
 #include "SDL2/SDL.h"
 #include "SDL2/SDL_mouse.h"
@@ -43,7 +45,22 @@ typedef struct mouse {
     signed short y;
 } mouse_t;
 
+/* One table held by the queue, one being filled and one per receiving task */
+#define BUTTON_INPUT_BLOCKS 8
+
 QueueHandle_t buttonInputQueue = NULL;
+BlockPoolHandle_t buttonInputPool = NULL;
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+static StaticSemaphore_t mouse_lock_buffer;
+static StaticSemaphore_t fetch_lock_buffer;
+static uint8_t button_input_pool_storage[poolSTORAGE_SIZE_BYTES(
+            sizeof(unsigned char) * SDL_NUM_SCANCODES, BUTTON_INPUT_BLOCKS)]
+    __attribute__((aligned(portBYTE_ALIGNMENT)));
+static StaticBlockPool_t button_input_pool_buffer;
+static uint8_t button_input_queue_storage[sizeof(void *)];
+static StaticQueue_t button_input_queue_buffer;
+#endif // configSUPPORT_STATIC_ALLOCATION
 
 mouse_t mouse;
 
@@ -51,12 +68,20 @@ xSemaphoreHandle fetch_lock;
 
 static int initMouse(void)
 {
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    mouse.lock = xSemaphoreCreateMutexStatic(&mouse_lock_buffer);
+#else
     mouse.lock = xSemaphoreCreateMutex();
+#endif // configSUPPORT_STATIC_ALLOCATION
     if (!mouse.lock) {
         return -1;
     }
 
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    fetch_lock = xSemaphoreCreateMutexStatic(&fetch_lock_buffer);
+#else
     fetch_lock = xSemaphoreCreateMutex();
+#endif // configSUPPORT_STATIC_ALLOCATION
     if (!fetch_lock) {
         return -1;
     }
@@ -68,7 +93,8 @@ static void SDLFetchEvents(void)
 {
     SDL_Event event = { 0 };
     static unsigned char buttons[SDL_NUM_SCANCODES] = { 0 };
-    unsigned char send = 0;
+    static unsigned char send = 0;
+    unsigned char *table;
 
     while (SDL_PollEvent(&event)) {
         if ((event.type == SDL_QUIT) ||
@@ -132,8 +158,16 @@ static void SDLFetchEvents(void)
     }
 
     if (send) {
-        xQueueOverwrite(buttonInputQueue, &buttons);
-        send = 0;
+        // Retried on the next fetch if all tables are still held by receivers
+        table = pvBlockPoolAllocate(buttonInputPool, 0);
+        if (table) {
+            memcpy(table, buttons, SDL_NUM_SCANCODES);
+            table = pvQueueOverwriteReference(buttonInputQueue, table);
+            if (table) {
+                vBlockPoolFree(buttonInputPool, table);
+            }
+            send = 0;
+        }
     }
 }
 
@@ -233,8 +267,29 @@ int tumEventInit(void)
         goto err_init_mouse;
     }
 
-    buttonInputQueue =
-        xQueueCreate(1, sizeof(unsigned char) * SDL_NUM_SCANCODES);
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    buttonInputPool =
+        xBlockPoolCreateStatic(sizeof(unsigned char) * SDL_NUM_SCANCODES,
+                               BUTTON_INPUT_BLOCKS, button_input_pool_storage,
+                               &button_input_pool_buffer);
+#else
+    buttonInputPool =
+        xBlockPoolCreate(sizeof(unsigned char) * SDL_NUM_SCANCODES,
+                         BUTTON_INPUT_BLOCKS);
+#endif // configSUPPORT_STATIC_ALLOCATION
+
+    if (!buttonInputPool) {
+        PRINT_ERROR("Creating button table pool failed");
+        goto err_pool;
+    }
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    buttonInputQueue = xQueueCreateByReferenceStatic(
+                           1, button_input_queue_storage,
+                           &button_input_queue_buffer);
+#else
+    buttonInputQueue = xQueueCreateByReference(1);
+#endif // configSUPPORT_STATIC_ALLOCATION
 
     if (!buttonInputQueue) {
         PRINT_ERROR("Creating mouse queue failed");
@@ -249,6 +304,8 @@ int tumEventInit(void)
     return 0;
 
 err_queue:
+    vBlockPoolDelete(buttonInputPool);
+err_pool:
     vSemaphoreDelete(mouse.lock);
 err_init_mouse:
     return -1;
@@ -257,5 +314,6 @@ err_init_mouse:
 void tumEventExit(void)
 {
     vQueueDelete(buttonInputQueue);
+    vBlockPoolDelete(buttonInputPool);
     vSemaphoreDelete(mouse.lock);
 }
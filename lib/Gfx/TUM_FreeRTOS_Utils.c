@@ -27,85 +27,122 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 0)
+// Without a heap the lists are only printed while there are at most this
+// many tasks
+#define FUTIL_MAX_TASKS 64
+
+static TaskStatus_t status_buf[FUTIL_MAX_TASKS];
+#endif // configSUPPORT_DYNAMIC_ALLOCATION
+
+static void putTaskStatusList(TaskStatus_t *status_list)
+{
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    vPortFree(status_list);
+#else
+    (void)status_list;
+#endif // configSUPPORT_DYNAMIC_ALLOCATION
+}
+
+// Returns the status of every task, which must be released with
+// putTaskStatusList(), or NULL
+static TaskStatus_t *getTaskStatusList(UBaseType_t *num_tasks,
+                                       configRUN_TIME_COUNTER_TYPE *run_time)
+{
+    TaskStatus_t *status_list;
+
+    *num_tasks = uxTaskGetNumberOfTasks();
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 1)
+    status_list =
+        (TaskStatus_t *)pvPortMalloc(sizeof(TaskStatus_t) * *num_tasks);
+    if (status_list == NULL) {
+        return NULL;
+    }
+#else
+    if (*num_tasks > FUTIL_MAX_TASKS) {
+        return NULL;
+    }
+    status_list = status_buf;
+#endif // configSUPPORT_DYNAMIC_ALLOCATION
+
+    // Fails if a task was created in the meantime
+    *num_tasks = uxTaskGetSystemState(status_list, *num_tasks, run_time);
+    if (*num_tasks == 0) {
+        putTaskStatusList(status_list);
+        return NULL;
+    }
+
+    return status_list;
+}
+
 #define STATE_LIST_HEADER ("NAME         STATE   PRIORITY  STACK   NUM\n")
 
 void tumFUtilPrintTaskStateList(void)
 {
-    UBaseType_t num_tasks = uxTaskGetNumberOfTasks();
-    if (!(int)num_tasks) {
-        return;
-    }
+    static const char state_chars[] = { [eRunning] = 'X', [eReady] = 'R',
+                                        [eBlocked] = 'B', [eSuspended] = 'S',
+                                        [eDeleted] = 'D'
+                                      };
+    configRUN_TIME_COUNTER_TYPE ulTotalRunTime;
+    UBaseType_t num_tasks, x;
+    TaskStatus_t *status_list =
+        getTaskStatusList(&num_tasks, &ulTotalRunTime);
 
-    char *print_buf = (char *)pvPortMalloc((int)num_tasks * 50);
-    if (print_buf == NULL) {
+    if (status_list == NULL) {
         return;
     }
-    char *print_buf_head = print_buf;
 
-    sprintf(print_buf, "%s", STATE_LIST_HEADER);
-    print_buf_head += strlen(STATE_LIST_HEADER);
+    printf("%s", STATE_LIST_HEADER);
+    for (x = 0; x < num_tasks; x++) {
+        printf("%-*s\t%c\t%u\t%u\t%u\n", configMAX_TASK_NAME_LEN - 1,
+               status_list[x].pcTaskName,
+               state_chars[status_list[x].eCurrentState],
+               (unsigned)status_list[x].uxCurrentPriority,
+               (unsigned)status_list[x].usStackHighWaterMark,
+               (unsigned)status_list[x].xTaskNumber);
+    }
+    printf("\n");
 
-    vTaskList(print_buf_head);
-    printf("%s\n", print_buf);
-    vPortFree(print_buf);
+    putTaskStatusList(status_list);
 }
 
-#define UTIL_LIST_HEADER ("NAME              RUN TIME  \%\n")
+#define UTIL_LIST_HEADER ("NAME                 RUN TIME [us]  \%\n")
 
 void tumFUtilPrintTaskUtils(void)
 {
-    char *buff = (char *)pvPortMalloc(sizeof(char) * 2000);
-    if (buff == NULL) {
-        return;
-    }
-
-    char *buff_head = buff;
-    volatile UBaseType_t num_tasks = uxTaskGetNumberOfTasks(), x;
-    unsigned int ulTotalRunTime;
+    configRUN_TIME_COUNTER_TYPE ulTotalRunTime;
     float ulStatsAsPercentage;
+    UBaseType_t num_tasks, x;
+    TaskStatus_t *status_list =
+        getTaskStatusList(&num_tasks, &ulTotalRunTime);
 
-    TaskStatus_t *status_list = (TaskStatus_t *)pvPortMalloc(
-                                    sizeof(TaskStatus_t) * (int)num_tasks);
     if (status_list == NULL) {
-        goto err_stat_list;
-    }
-
-    UBaseType_t ret = uxTaskGetSystemState(
-                          status_list, (const UBaseType_t)num_tasks, &ulTotalRunTime);
-    if (ret != num_tasks) {
-        goto err_inval_status_num;
+        return;
     }
 
     /** ulTotalRunTime /= 100UL; */
 
     if (ulTotalRunTime > 0) {
-        sprintf(buff, "%s", UTIL_LIST_HEADER);
-        buff += strlen(UTIL_LIST_HEADER);
+        printf("%s", UTIL_LIST_HEADER);
         for (x = 0; x < num_tasks; x++) {
             ulStatsAsPercentage = status_list[x].ulRunTimeCounter /
                                   (float)ulTotalRunTime * 100.0;
 
             if (ulStatsAsPercentage > 0UL) {
-                sprintf(buff, "%-20s %5u  %.2f\n",
-                        status_list[x].pcTaskName,
-                        status_list[x].ulRunTimeCounter,
-                        ulStatsAsPercentage);
+                printf("%-20s %13llu  %.2f\n", status_list[x].pcTaskName,
+                       (unsigned long long)status_list[x].ulRunTimeCounter /
+                       1000,
+                       ulStatsAsPercentage);
             }
             else {
-                sprintf(buff, "%-20s %5u\n",
-                        status_list[x].pcTaskName,
-                        status_list[x].ulRunTimeCounter);
+                printf("%-20s %13llu\n", status_list[x].pcTaskName,
+                       (unsigned long long)status_list[x].ulRunTimeCounter /
+                       1000);
             }
-
-            buff += strlen((char *)buff);
         }
-        printf("%s\n", buff_head);
+        printf("\n");
     }
 
-err_stat_list:
-    vPortFree(buff_head);
-err_inval_status_num:
-    vPortFree(status_list);
-
-    return;
+    putTaskStatusList(status_list);
 }
@@ -25,12 +25,9 @@
 #include <stdarg.h>
 
 #include "FreeRTOS.h"
-#include "queue.h"
 #include "task.h"
-#include "semphr.h"
 
 #include "TUM_Print.h"
-#include "TUM_Utils.h"
 
 struct error_print_msg {
 #ifdef SAFE_PRINT_DEBUG
@@ -40,57 +37,97 @@ struct error_print_msg {
     char msg[SAFE_PRINT_MAX_MSG_LEN];
 };
 
-char rbuf_buffer[sizeof(struct error_print_msg) *
-                               SAFE_PRINT_INPUT_BUFFER_COUNT] = { 0 };
+// prints may be called from host threads that are not tasks, eg. AsyncIO
+// callbacks, so messages are passed to the print task through a lock free
+// queue. A slot's sequence number equals the position it is next filled at
+// while it is free and that position plus one once it holds a message.
+struct print_slot {
+    unsigned long seq;
+    struct error_print_msg msg;
+};
+
+static struct print_slot print_slots[SAFE_PRINT_QUEUE_LEN];
+static unsigned long print_head = 0; // Next position to fill
+static unsigned long print_tail = 0; // Next position to print, task only
 
 #ifdef SAFE_PRINT_DEBUG
-xSemaphoreHandle input_debug_count = NULL;
+static UBaseType_t input_debug_count = 0;
 #endif // SAFE_PRINT_DEBUG
 
-rbuf_handle_t input_rbuf = NULL;
-
-xQueueHandle safePrintQueue = NULL;
 xTaskHandle safePrintTaskHandle = NULL;
 
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+static StaticTask_t safe_print_task_buffer;
+static StackType_t safe_print_task_stack[SAFE_PRINT_STACK_SIZE];
+#endif // configSUPPORT_STATIC_ALLOCATION
+
+static struct print_slot *claimPrintSlot(void)
+{
+    unsigned long pos = __atomic_load_n(&print_head, __ATOMIC_RELAXED);
+    struct print_slot *slot;
+    long diff;
+
+    for (;;) {
+        slot = &print_slots[pos % SAFE_PRINT_QUEUE_LEN];
+        diff = (long)(__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&print_head, &pos, pos + 1, 0,
+                                            __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED)) {
+                return slot;
+            }
+        }
+        else if (diff < 0) {
+            return NULL; // Full, the message is dropped
+        }
+        else {
+            pos = __atomic_load_n(&print_head, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static uint32_t safePrintISR(void)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    vTaskNotifyGiveFromISR(safePrintTaskHandle, &xHigherPriorityTaskWoken);
+
+    return xHigherPriorityTaskWoken;
+}
+
 static void vfprints(FILE *__restrict __stream, const char *__format,
                      va_list args)
 {
-    struct error_print_msg *tmp_msg;
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    struct print_slot *slot;
 
     if ((__stream == NULL) || (__format == NULL)) {
         return;
     }
 
-    // Queue is not ready, lets risk it and just print
-    if (safePrintQueue == NULL) {
+    // Task is not ready, lets risk it and just print
+    if (safePrintTaskHandle == NULL) {
         vfprintf(__stream, __format, args);
         return;
     }
 
-    tmp_msg = (struct error_print_msg *)rbuf_get_buffer(input_rbuf);
+    slot = claimPrintSlot();
 
-#ifdef SAFE_PRINT_DEBUG
-    if (xSemaphoreGive(input_debug_count) == pdTRUE) {
-        tmp_msg->debug_id = uxSemaphoreGetCount(input_debug_count);
-    }
-    else {
-        tmp_msg->debug_id = -1;
-    }
-#endif // SAFE_PRINT_DEBUG
-
-    if (tmp_msg == NULL) {
+    if (slot == NULL) {
         return;
     }
 
-    tmp_msg->stream = __stream;
-    vsnprintf((char *)tmp_msg->msg, SAFE_PRINT_MAX_MSG_LEN, __format, args);
-
-    xQueueSendFromISR(safePrintQueue, tmp_msg, &xHigherPriorityTaskWoken);
+#ifdef SAFE_PRINT_DEBUG
+    slot->msg.debug_id =
+        __atomic_add_fetch(&input_debug_count, 1, __ATOMIC_RELAXED);
+#endif // SAFE_PRINT_DEBUG
 
-    rbuf_put_buffer(input_rbuf);
+    slot->msg.stream = __stream;
+    vsnprintf((char *)slot->msg.msg, SAFE_PRINT_MAX_MSG_LEN, __format, args);
 
-    portEND_SWITCHING_ISR(xHigherPriorityTaskWoken);
+    // Publish the message, then let the print task know through an
+    // interrupt as the caller may not be a task
+    __atomic_store_n(&slot->seq, slot->seq + 1, __ATOMIC_RELEASE);
+    vPortGenerateSimulatedInterrupt(SAFE_PRINT_INTERRUPT);
 }
 
 void fprints(FILE *__restrict __stream, const char *__format, ...)
@@ -111,55 +148,59 @@ void prints(const char *__format, ...)
 
 static void safePrintTask(void *pvParameters)
 {
-    struct error_print_msg msgToPrint = { 0 };
+    struct print_slot *slot;
 
     while (1) {
-        if (safePrintQueue)
-            if (xQueueReceive(safePrintQueue, &msgToPrint,
-                              portMAX_DELAY) == pdTRUE) {
-                fprintf(msgToPrint.stream, "%s",
-                        msgToPrint.msg);
-            }
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        slot = &print_slots[print_tail % SAFE_PRINT_QUEUE_LEN];
+        while (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) ==
+               print_tail + 1) {
+            fprintf(slot->msg.stream, "%s", slot->msg.msg);
+
+            // Free the slot for the position one lap ahead
+            __atomic_store_n(&slot->seq, print_tail + SAFE_PRINT_QUEUE_LEN,
+                             __ATOMIC_RELEASE);
+            print_tail++;
+            slot = &print_slots[print_tail % SAFE_PRINT_QUEUE_LEN];
+        }
     }
 }
 
 int safePrintInit(void)
 {
-    safePrintQueue =
-        xQueueCreate(SAFE_PRINT_QUEUE_LEN, SAFE_PRINT_MAX_MSG_LEN);
+    unsigned long i;
 
-    if (safePrintQueue == NULL) {
-        return -1;
+    for (i = 0; i < SAFE_PRINT_QUEUE_LEN; i++) {
+        print_slots[i].seq = i;
     }
 
+    vPortSetInterruptHandler(SAFE_PRINT_INTERRUPT, safePrintISR);
+
+#if (configSUPPORT_STATIC_ALLOCATION == 1)
+    safePrintTaskHandle = xTaskCreateStatic(
+                              safePrintTask, "Print", SAFE_PRINT_STACK_SIZE, NULL,
+                              SAFE_PRINT_PRIORITY, safe_print_task_stack,
+                              &safe_print_task_buffer);
+#else
     xTaskCreate(safePrintTask, "Print", SAFE_PRINT_STACK_SIZE, NULL,
                 SAFE_PRINT_PRIORITY, &safePrintTaskHandle);
+#endif // configSUPPORT_STATIC_ALLOCATION
 
     if (safePrintTaskHandle == NULL) {
+        vPortSetInterruptHandler(SAFE_PRINT_INTERRUPT, NULL);
         return -1;
     }
 
-    input_rbuf = rbuf_init_static(sizeof(struct error_print_msg),
-                                  SAFE_PRINT_INPUT_BUFFER_COUNT, (void *)rbuf_buffer);
-
-    if (input_rbuf == NULL) {
-        return -1;
-    }
-
-#ifdef SAFE_PRINT_DEBUG
-    input_debug_count = xQueueCreateCountingSemaphore(0xFFFF, 0);
-
-    if (input_debug_count == NULL) {
-        return -1;
-    }
-#endif // SAFE_PRINT_DEBUG
-
     return 0;
 }
 
 void safePrintExit(void)
 {
-    vTaskDelete(safePrintTaskHandle);
+    xTaskHandle task = safePrintTaskHandle;
+
+    safePrintTaskHandle = NULL;
+    vPortSetInterruptHandler(SAFE_PRINT_INTERRUPT, NULL);
 
-    vQueueDelete(safePrintQueue);
+    vTaskDelete(task);
 }
@@ -26,6 +26,7 @@
 
 #include "FreeRTOS.h"
 #include "queue.h"
+#include "block_pool.h"
 
 /**
  * @defgroup tum_event TUM Event API
@@ -38,10 +39,11 @@
  * retriving the most recent copy of the button status lookup table exposed
  * through the FreeRTOS queue @ref buttonInputQueue.
  *
- * @ref buttonInputQueue holds a single array of unsigned chars of the length
- * SDL_NUM_SCANCODES. The scancodes that are defind in the SDL header
- * SDL_scancode.h are used as the indicies when accessing the stored data in
- * the table.
+ * @ref buttonInputQueue holds a pointer to a single array of unsigned chars
+ * of the length SDL_NUM_SCANCODES, allocated from @ref buttonInputPool, so the
+ * table is not copied through the queue. The scancodes that are defind in the
+ * SDL header SDL_scancode.h are used as the indicies when accessing the stored
+ * data in the table.
  *
  * @{
  */
@@ -145,10 +147,18 @@ int tumEventFetchEvents(int flags);
 /*!<
  * @brief FreeRTOS queue used to obtain a current copy of the keyboard lookup table
  *
- * Sends an unsigned char array of length SDL_NUM_SCANCODES. Acts as a lookup
- * table using the SDL scancodes defined in <SDL2/SDL_scancode.h>
+ * Sends an unsigned char array of length SDL_NUM_SCANCODES by reference, see
+ * pvQueueReceiveReference(). Acts as a lookup table using the SDL scancodes
+ * defined in <SDL2/SDL_scancode.h>. The receiving task owns the table it
+ * received and must return it to @ref buttonInputPool with vBlockPoolFree()
+ * once it holds a newer one.
  */
 extern QueueHandle_t buttonInputQueue;
 
+/*!<
+ * @brief Block pool the tables sent through @ref buttonInputQueue come from
+ */
+extern BlockPoolHandle_t buttonInputPool;
+
 /** @} */
 #endif
@@ -43,6 +43,11 @@
  * The functions also allow writing to any IO stream, `prints` is simply a call
  * to `fprints` where the IO stream is fixed to `stdout`,
  *
+ * Both may also be called from host threads that are not FreeRTOS tasks, such
+ * as AsyncIO callbacks. Messages are passed to the printing task through a
+ * lock free queue and the task is notified through the simulated interrupt
+ * `SAFE_PRINT_INTERRUPT`. Messages that do not fit into the queue are dropped.
+ *
  * @{
  */
 
@@ -66,9 +71,9 @@
 #ifndef SAFE_PRINT_PRIORITY
 #define SAFE_PRINT_PRIORITY tskIDLE_PRIORITY
 #endif // SAFE_PRINT_PRIORITY
-#ifndef SAFE_PRINT_INPUT_BUFFER_COUNT
-#define SAFE_PRINT_INPUT_BUFFER_COUNT 10
-#endif // SAFE_PRINT_INPUT_BUFFER_COUNT
+#ifndef SAFE_PRINT_INTERRUPT
+#define SAFE_PRINT_INTERRUPT 31
+#endif // SAFE_PRINT_INTERRUPT
 //Uncomment to embed print debug ID's into messages
 // #define SAFE_PRINT_DEBUG
 /** @} */
@@ -1,6 +1,7 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <SDL2/SDL_scancode.h>
 
@@ -8,6 +9,9 @@
 #include "queue.h"
 #include "semphr.h"
 #include "task.h"
+#include "block_pool.h"
+#include "message_buffer.h"
+#include "event_groups.h"
 
 #include "TUM_Ball.h"
 #include "TUM_Draw.h"
@@ -37,6 +41,9 @@
 
 #define STATE_DEBOUNCE_DELAY 300
 
+#define DRAW_SIGNAL_BIT (1 << 0) // A new frame can be drawn
+#define BUTTONS_UPDATED_BIT (1 << 1) // A new button table was received
+
 #define KEYCODE(CHAR) SDL_SCANCODE_##CHAR
 #define CAVE_SIZE_X SCREEN_WIDTH / 2
 #define CAVE_SIZE_Y SCREEN_HEIGHT / 2
@@ -45,6 +52,7 @@
 #define CAVE_THICKNESS 25
 #define LOGO_FILENAME "freertos.jpg"
 #define UDP_BUFFER_SIZE 2000
+#define UDP_MESSAGE_BUFFER_SIZE 4096
 #define UDP_TEST_PORT_1 1234
 #define UDP_TEST_PORT_2 4321
 #define MSG_QUEUE_BUFFER_SIZE 1000
@@ -77,18 +85,64 @@ static TaskHandle_t MQDemoTask = NULL;
 static TaskHandle_t DemoSendTask = NULL;
 
 static QueueHandle_t StateQueue = NULL;
-static SemaphoreHandle_t DrawSignal = NULL;
+static EventGroupHandle_t DemoEvents = NULL;
 static SemaphoreHandle_t ScreenLock = NULL;
 
 static image_handle_t logo_image = NULL;
 
 typedef struct buttons_buffer {
-    unsigned char buttons[SDL_NUM_SCANCODES];
+    unsigned char *buttons; // Latest table received from buttonInputQueue
     SemaphoreHandle_t lock;
 } buttons_buffer_t;
 
 static buttons_buffer_t buttons = { 0 };
 
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 0)
+// Without a heap, as built with STATIC_ALLOCATION_ONLY=ON, the demo's kernel
+// objects are created in these buffers instead
+#define DEMO_TASK_COUNT 8
+#define DEMO_TASK_STACK_SIZE (mainGENERIC_STACK_SIZE * 2)
+
+static StaticTask_t task_buffers[DEMO_TASK_COUNT];
+static StackType_t task_stacks[DEMO_TASK_COUNT][DEMO_TASK_STACK_SIZE];
+static unsigned int task_count = 0;
+static StaticSemaphore_t buttons_lock_buffer;
+static StaticSemaphore_t screen_lock_buffer;
+static StaticEventGroup_t demo_events_buffer;
+static StaticQueue_t state_queue_buffer;
+static uint8_t state_queue_storage[STATE_QUEUE_LENGTH * sizeof(unsigned char)];
+static StaticMessageBuffer_t udp_messages_buffer;
+// Message buffers hold one byte less than their storage
+static uint8_t udp_messages_storage[UDP_MESSAGE_BUFFER_SIZE + 1];
+#endif // configSUPPORT_DYNAMIC_ALLOCATION
+
+// Creates a task as xTaskCreate() does, in the buffers above without a heap
+static BaseType_t xDemoTaskCreate(TaskFunction_t code, const char *name,
+                                  unsigned short stack_depth,
+                                  UBaseType_t priority, TaskHandle_t *handle)
+{
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 0)
+    TaskHandle_t task;
+
+    if ((task_count == DEMO_TASK_COUNT) ||
+        (stack_depth > DEMO_TASK_STACK_SIZE)) {
+        return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+    }
+
+    task = xTaskCreateStatic(code, name, stack_depth, NULL, priority,
+                             task_stacks[task_count],
+                             &task_buffers[task_count]);
+    task_count++;
+    if (handle) {
+        *handle = task;
+    }
+
+    return task ? pdPASS : errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+#else
+    return xTaskCreate(code, name, stack_depth, NULL, priority, handle);
+#endif // configSUPPORT_DYNAMIC_ALLOCATION
+}
+
 void checkDraw(unsigned char status, const char *msg)
 {
     if (status) {
@@ -186,6 +240,19 @@ initial_state:
     }
 }
 
+void xGetButtonInput(void)
+{
+    unsigned char *latest = pvQueueReceiveReference(buttonInputQueue, 0);
+
+    if (latest) {
+        xSemaphoreTake(buttons.lock, portMAX_DELAY);
+        vBlockPoolFree(buttonInputPool, buttons.buttons);
+        buttons.buttons = latest;
+        xSemaphoreGive(buttons.lock);
+        xEventGroupSetBits(DemoEvents, BUTTONS_UPDATED_BIT);
+    }
+}
+
 void vSwapBuffers(void *pvParameters)
 {
     TickType_t xLastWakeTime;
@@ -199,21 +266,14 @@ void vSwapBuffers(void *pvParameters)
             tumDrawUpdateScreen();
             tumEventFetchEvents(FETCH_EVENT_BLOCK);
             xSemaphoreGive(ScreenLock);
-            xSemaphoreGive(DrawSignal);
+            xGetButtonInput(); // Update global input
+            xEventGroupSetBits(DemoEvents, DRAW_SIGNAL_BIT);
             vTaskDelayUntil(&xLastWakeTime,
                             pdMS_TO_TICKS(frameratePeriod));
         }
     }
 }
 
-void xGetButtonInput(void)
-{
-    if (xSemaphoreTake(buttons.lock, 0) == pdTRUE) {
-        xQueueReceive(buttonInputQueue, &buttons.buttons, 0);
-        xSemaphoreGive(buttons.lock);
-    }
-}
-
 void vDrawCaveBoundingBox(void)
 {
     checkDraw(tumDrawFilledBox(CAVE_X - CAVE_THICKNESS,
@@ -353,52 +413,47 @@ void vDrawButtonText(void)
     checkDraw(tumDrawText(str, 10, DEFAULT_FONT_SIZE * 0.5, Black),
               __FUNCTION__);
 
-    if (xSemaphoreTake(buttons.lock, 0) == pdTRUE) {
-        sprintf(str, "W: %d | S: %d | A: %d | D: %d",
-                buttons.buttons[KEYCODE(W)],
-                buttons.buttons[KEYCODE(S)],
-                buttons.buttons[KEYCODE(A)],
-                buttons.buttons[KEYCODE(D)]);
-        xSemaphoreGive(buttons.lock);
-        checkDraw(tumDrawText(str, 10, DEFAULT_FONT_SIZE * 2, Black),
-                  __FUNCTION__);
-    }
+    xSemaphoreTake(buttons.lock, portMAX_DELAY);
+    sprintf(str, "W: %d | S: %d | A: %d | D: %d",
+            buttons.buttons[KEYCODE(W)],
+            buttons.buttons[KEYCODE(S)],
+            buttons.buttons[KEYCODE(A)],
+            buttons.buttons[KEYCODE(D)]);
+    xSemaphoreGive(buttons.lock);
+    checkDraw(tumDrawText(str, 10, DEFAULT_FONT_SIZE * 2, Black),
+              __FUNCTION__);
 
-    if (xSemaphoreTake(buttons.lock, 0) == pdTRUE) {
-        sprintf(str, "UP: %d | DOWN: %d | LEFT: %d | RIGHT: %d",
-                buttons.buttons[KEYCODE(UP)],
-                buttons.buttons[KEYCODE(DOWN)],
-                buttons.buttons[KEYCODE(LEFT)],
-                buttons.buttons[KEYCODE(RIGHT)]);
-        xSemaphoreGive(buttons.lock);
-        checkDraw(tumDrawText(str, 10, DEFAULT_FONT_SIZE * 3.5, Black),
-                  __FUNCTION__);
-    }
+    xSemaphoreTake(buttons.lock, portMAX_DELAY);
+    sprintf(str, "UP: %d | DOWN: %d | LEFT: %d | RIGHT: %d",
+            buttons.buttons[KEYCODE(UP)],
+            buttons.buttons[KEYCODE(DOWN)],
+            buttons.buttons[KEYCODE(LEFT)],
+            buttons.buttons[KEYCODE(RIGHT)]);
+    xSemaphoreGive(buttons.lock);
+    checkDraw(tumDrawText(str, 10, DEFAULT_FONT_SIZE * 3.5, Black),
+              __FUNCTION__);
 }
 
 static int vCheckStateInput(void)
 {
-    if (xSemaphoreTake(buttons.lock, 0) == pdTRUE) {
-        if (buttons.buttons[KEYCODE(C)]) {
-            buttons.buttons[KEYCODE(C)] = 0;
-            if (StateQueue) {
-                xSemaphoreGive(buttons.lock);
-                xQueueSend(StateQueue, &next_state_signal, 0);
-                return 0;
-            }
-            return -1;
+    unsigned char pressed;
+
+    xSemaphoreTake(buttons.lock, portMAX_DELAY);
+    pressed = buttons.buttons[KEYCODE(C)];
+    buttons.buttons[KEYCODE(C)] = 0;
+    xSemaphoreGive(buttons.lock);
+
+    if (pressed) {
+        if (StateQueue) {
+            xQueueSend(StateQueue, &next_state_signal, 0);
+            return 0;
         }
-        xSemaphoreGive(buttons.lock);
+        return -1;
     }
 
     return 0;
 }
 
-void UDPHandlerOne(size_t read_size, char *buffer, void *args)
-{
-    prints("UDP Recv in first handler: %s\n", buffer);
-}
-
 void UDPHandlerTwo(size_t read_size, char *buffer, void *args)
 {
     prints("UDP Recv in second handler: %s\n", buffer);
@@ -406,11 +461,31 @@ void UDPHandlerTwo(size_t read_size, char *buffer, void *args)
 
 void vUDPDemoTask(void *pvParameters)
 {
+    static char recv_buffer[UDP_BUFFER_SIZE + 1];
     char *addr = NULL; // Loopback
     in_port_t port = UDP_TEST_PORT_1;
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 0)
+    MessageBufferHandle_t udp_messages = xMessageBufferCreateStatic(
+            UDP_MESSAGE_BUFFER_SIZE, udp_messages_storage, &udp_messages_buffer);
+#else
+    MessageBufferHandle_t udp_messages =
+        xMessageBufferCreate(UDP_MESSAGE_BUFFER_SIZE);
+#endif // configSUPPORT_DYNAMIC_ALLOCATION
+    size_t recv_size;
+
+    if (!udp_messages) {
+        PRINT_ERROR("Failed to create UDP message buffer");
+        vTaskDelete(NULL);
+    }
 
+    // The first socket's datagrams are received by this task, one message each
     udp_soc_one = aIOOpenUDPSocket(addr, port, UDP_BUFFER_SIZE,
-                                   UDPHandlerOne, NULL);
+                                   aIOStreamBufferCallback, udp_messages);
+    if (!udp_soc_one) {
+        PRINT_ERROR("Failed to open UDP socket on port %d", port);
+        vMessageBufferDelete(udp_messages);
+        vTaskDelete(NULL);
+    }
 
     prints("UDP socket opened on port %d\n", port);
     prints("Demo UDP Socket can be tested using\n");
@@ -420,13 +495,22 @@ void vUDPDemoTask(void *pvParameters)
 
     udp_soc_two = aIOOpenUDPSocket(addr, port, UDP_BUFFER_SIZE,
                                    UDPHandlerTwo, NULL);
-
-    prints("UDP socket opened on port %d\n", port);
-    prints("Demo UDP Socket can be tested using\n");
-    prints("*** netcat -vv localhost %d -u ***\n", port);
+    if (udp_soc_two) {
+        prints("UDP socket opened on port %d\n", port);
+        prints("Demo UDP Socket can be tested using\n");
+        prints("*** netcat -vv localhost %d -u ***\n", port);
+    }
+    else {
+        PRINT_ERROR("Failed to open UDP socket on port %d", port);
+    }
 
     while (1) {
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        recv_size = xMessageBufferReceive(udp_messages, recv_buffer,
+                                          UDP_BUFFER_SIZE, portMAX_DELAY);
+        if (recv_size) {
+            recv_buffer[recv_size] = '\0';
+            prints("UDP Recv in first socket task: %s\n", recv_buffer);
+        }
     }
 }
 
@@ -522,40 +606,45 @@ void vDemoTask1(void *pvParameters)
         tumDrawAnimationSequenceInstantiate(ball_animation, "REVERSE",
                                             40);
     TickType_t xLastFrameTime = xTaskGetTickCount();
+    EventBits_t events;
 
     while (1) {
-        if (DrawSignal)
-            if (xSemaphoreTake(DrawSignal, portMAX_DELAY) ==
-                pdTRUE) {
-                tumEventFetchEvents(FETCH_EVENT_BLOCK |
-                                    FETCH_EVENT_NO_GL_CHECK);
-                xGetButtonInput(); // Update global input
-
-                xSemaphoreTake(ScreenLock, portMAX_DELAY);
-
-                // Clear screen
-                checkDraw(tumDrawClear(White), __FUNCTION__);
-                vDrawStaticItems();
-                vDrawCave(tumEventGetMouseLeft());
-                vDrawButtonText();
-                tumDrawAnimationDrawFrame(forward_sequence,
-                                          xTaskGetTickCount() -
-                                          xLastFrameTime,
-                                          SCREEN_WIDTH - 50, SCREEN_HEIGHT - 60);
-                tumDrawAnimationDrawFrame(reverse_sequence,
-                                          xTaskGetTickCount() -
-                                          xLastFrameTime,
-                                          SCREEN_WIDTH - 50 - 40, SCREEN_HEIGHT - 60);
-                xLastFrameTime = xTaskGetTickCount();
-
-                // Draw FPS in lower right corner
-                vDrawFPS();
-
-                xSemaphoreGive(ScreenLock);
-
-                // Get input and check for state change
-                vCheckStateInput();
-            }
+        // Woken by whichever comes first, a new frame or new button input
+        events = xEventGroupWaitBits(DemoEvents,
+                                     DRAW_SIGNAL_BIT | BUTTONS_UPDATED_BIT,
+                                     pdTRUE, pdFALSE, portMAX_DELAY);
+
+        if (events & DRAW_SIGNAL_BIT) {
+            tumEventFetchEvents(FETCH_EVENT_BLOCK |
+                                FETCH_EVENT_NO_GL_CHECK);
+
+            xSemaphoreTake(ScreenLock, portMAX_DELAY);
+
+            // Clear screen
+            checkDraw(tumDrawClear(White), __FUNCTION__);
+            vDrawStaticItems();
+            vDrawCave(tumEventGetMouseLeft());
+            vDrawButtonText();
+            tumDrawAnimationDrawFrame(forward_sequence,
+                                      xTaskGetTickCount() -
+                                      xLastFrameTime,
+                                      SCREEN_WIDTH - 50, SCREEN_HEIGHT - 60);
+            tumDrawAnimationDrawFrame(reverse_sequence,
+                                      xTaskGetTickCount() -
+                                      xLastFrameTime,
+                                      SCREEN_WIDTH - 50 - 40, SCREEN_HEIGHT - 60);
+            xLastFrameTime = xTaskGetTickCount();
+
+            // Draw FPS in lower right corner
+            vDrawFPS();
+
+            xSemaphoreGive(ScreenLock);
+        }
+
+        if (events & BUTTONS_UPDATED_BIT) {
+            // Check for state change
+            vCheckStateInput();
+        }
     }
 }
 
@@ -593,78 +682,82 @@ void vDemoTask2(void *pvParameters)
                    CAVE_SIZE_X + CAVE_THICKNESS * 2, CAVE_THICKNESS,
                    0.2, Blue, NULL, NULL);
     unsigned char collisions = 0;
+    EventBits_t events;
 
     prints("Task 1 init'd\n");
 
     while (1) {
-        if (DrawSignal)
-            if (xSemaphoreTake(DrawSignal, portMAX_DELAY) ==
-                pdTRUE) {
-                xLastWakeTime = xTaskGetTickCount();
-
-                xGetButtonInput(); // Update global button data
-
-                xSemaphoreTake(ScreenLock, portMAX_DELAY);
-                // Clear screen
-                checkDraw(tumDrawClear(White), __FUNCTION__);
-
-                vDrawStaticItems();
-
-                // Draw the walls
-                checkDraw(tumDrawFilledBox(
-                              left_wall->x1, left_wall->y1,
-                              left_wall->w, left_wall->h,
-                              left_wall->colour),
-                          __FUNCTION__);
-                checkDraw(tumDrawFilledBox(right_wall->x1,
-                                           right_wall->y1,
-                                           right_wall->w,
-                                           right_wall->h,
-                                           right_wall->colour),
-                          __FUNCTION__);
-                checkDraw(tumDrawFilledBox(
-                              top_wall->x1, top_wall->y1,
-                              top_wall->w, top_wall->h,
-                              top_wall->colour),
-                          __FUNCTION__);
-                checkDraw(tumDrawFilledBox(bottom_wall->x1,
-                                           bottom_wall->y1,
-                                           bottom_wall->w,
-                                           bottom_wall->h,
-                                           bottom_wall->colour),
-                          __FUNCTION__);
-
-                // Check if ball has made a collision
-                collisions = checkBallCollisions(my_ball, NULL,
-                                                 NULL);
-                if (collisions) {
-                    prints("Collision\n");
-                }
+        // Woken by whichever comes first, a new frame or new button input
+        events = xEventGroupWaitBits(DemoEvents,
+                                     DRAW_SIGNAL_BIT | BUTTONS_UPDATED_BIT,
+                                     pdTRUE, pdFALSE, portMAX_DELAY);
+
+        if (events & DRAW_SIGNAL_BIT) {
+            xLastWakeTime = xTaskGetTickCount();
+
+            xSemaphoreTake(ScreenLock, portMAX_DELAY);
+            // Clear screen
+            checkDraw(tumDrawClear(White), __FUNCTION__);
+
+            vDrawStaticItems();
+
+            // Draw the walls
+            checkDraw(tumDrawFilledBox(
+                          left_wall->x1, left_wall->y1,
+                          left_wall->w, left_wall->h,
+                          left_wall->colour),
+                      __FUNCTION__);
+            checkDraw(tumDrawFilledBox(right_wall->x1,
+                                       right_wall->y1,
+                                       right_wall->w,
+                                       right_wall->h,
+                                       right_wall->colour),
+                      __FUNCTION__);
+            checkDraw(tumDrawFilledBox(
+                          top_wall->x1, top_wall->y1,
+                          top_wall->w, top_wall->h,
+                          top_wall->colour),
+                      __FUNCTION__);
+            checkDraw(tumDrawFilledBox(bottom_wall->x1,
+                                       bottom_wall->y1,
+                                       bottom_wall->w,
+                                       bottom_wall->h,
+                                       bottom_wall->colour),
+                      __FUNCTION__);
+
+            // Check if ball has made a collision
+            collisions = checkBallCollisions(my_ball, NULL,
+                                             NULL);
+            if (collisions) {
+                prints("Collision\n");
+            }
 
-                // Update the balls position now that possible collisions have
-                // updated its speeds
-                updateBallPosition(
-                    my_ball, xLastWakeTime - prevWakeTime);
+            // Update the balls position now that possible collisions have
+            // updated its speeds
+            updateBallPosition(
+                my_ball, xLastWakeTime - prevWakeTime);
 
-                // Draw the ball
-                checkDraw(tumDrawCircle(my_ball->x, my_ball->y,
-                                        my_ball->radius,
-                                        my_ball->colour),
-                          __FUNCTION__);
+            // Draw the ball
+            checkDraw(tumDrawCircle(my_ball->x, my_ball->y,
+                                    my_ball->radius,
+                                    my_ball->colour),
+                      __FUNCTION__);
 
-                // Draw FPS in lower right corner
-                vDrawFPS();
+            // Draw FPS in lower right corner
+            vDrawFPS();
 
-                xSemaphoreGive(ScreenLock);
+            xSemaphoreGive(ScreenLock);
 
-                // Check for state change
-                vCheckStateInput();
+            // Keep track of when task last ran so that you know how many ticks
+            //(in our case miliseconds) have passed so that the balls position
+            // can be updated appropriatley
+            prevWakeTime = xLastWakeTime;
+        }
 
-                // Keep track of when task last ran so that you know how many ticks
-                //(in our case miliseconds) have passed so that the balls position
-                // can be updated appropriatley
-                prevWakeTime = xLastWakeTime;
-            }
+        if (events & BUTTONS_UPDATED_BIT) {
+            // Check for state change
+            vCheckStateInput();
+        }
     }
 }
 
@@ -718,66 +811,90 @@ int main(int argc, char *argv[])
     //Load a second font for fun
     tumFontLoadFont(FPS_FONT, DEFAULT_FONT_SIZE);
 
+    buttons.buttons = pvBlockPoolAllocate(buttonInputPool, 0);
+    if (!buttons.buttons) {
+        PRINT_ERROR("Failed to allocate buttons table");
+        goto err_buttons_table;
+    }
+    memset(buttons.buttons, 0, SDL_NUM_SCANCODES);
+
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 0)
+    buttons.lock = xSemaphoreCreateMutexStatic(&buttons_lock_buffer);
+#else
     buttons.lock = xSemaphoreCreateMutex(); // Locking mechanism
+#endif // configSUPPORT_DYNAMIC_ALLOCATION
     if (!buttons.lock) {
         PRINT_ERROR("Failed to create buttons lock");
         goto err_buttons_lock;
     }
 
-    DrawSignal = xSemaphoreCreateBinary(); // Screen buffer locking
-    if (!DrawSignal) {
-        PRINT_ERROR("Failed to create draw signal");
-        goto err_draw_signal;
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 0)
+    DemoEvents = xEventGroupCreateStatic(&demo_events_buffer);
+#else
+    DemoEvents = xEventGroupCreate(); // New frames and button input
+#endif // configSUPPORT_DYNAMIC_ALLOCATION
+    if (!DemoEvents) {
+        PRINT_ERROR("Failed to create demo events");
+        goto err_demo_events;
     }
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 0)
+    ScreenLock = xSemaphoreCreateMutexStatic(&screen_lock_buffer);
+#else
     ScreenLock = xSemaphoreCreateMutex();
+#endif // configSUPPORT_DYNAMIC_ALLOCATION
     if (!ScreenLock) {
         PRINT_ERROR("Failed to create screen lock");
         goto err_screen_lock;
     }
 
     // Message sending
+#if (configSUPPORT_DYNAMIC_ALLOCATION == 0)
+    StateQueue = xQueueCreateStatic(STATE_QUEUE_LENGTH, sizeof(unsigned char),
+                                    state_queue_storage, &state_queue_buffer);
+#else
     StateQueue = xQueueCreate(STATE_QUEUE_LENGTH, sizeof(unsigned char));
+#endif // configSUPPORT_DYNAMIC_ALLOCATION
     if (!StateQueue) {
         PRINT_ERROR("Could not open state queue");
         goto err_state_queue;
     }
 
-    if (xTaskCreate(basicSequentialStateMachine, "StateMachine",
-                    mainGENERIC_STACK_SIZE * 2, NULL,
-                    configMAX_PRIORITIES - 1, StateMachine) != pdPASS) {
+    if (xDemoTaskCreate(basicSequentialStateMachine, "StateMachine",
+                        mainGENERIC_STACK_SIZE * 2, configMAX_PRIORITIES - 1,
+                        &StateMachine) != pdPASS) {
         PRINT_TASK_ERROR("StateMachine");
         goto err_statemachine;
     }
-    if (xTaskCreate(vSwapBuffers, "BufferSwapTask",
-                    mainGENERIC_STACK_SIZE * 2, NULL, configMAX_PRIORITIES,
-                    BufferSwap) != pdPASS) {
+    if (xDemoTaskCreate(vSwapBuffers, "BufferSwapTask",
+                        mainGENERIC_STACK_SIZE * 2, configMAX_PRIORITIES,
+                        &BufferSwap) != pdPASS) {
         PRINT_TASK_ERROR("BufferSwapTask");
         goto err_bufferswap;
     }
 
     /** Demo Tasks */
-    if (xTaskCreate(vDemoTask1, "DemoTask1", mainGENERIC_STACK_SIZE * 2,
-                    NULL, mainGENERIC_PRIORITY, &DemoTask1) != pdPASS) {
+    if (xDemoTaskCreate(vDemoTask1, "DemoTask1", mainGENERIC_STACK_SIZE * 2,
+                        mainGENERIC_PRIORITY, &DemoTask1) != pdPASS) {
         PRINT_TASK_ERROR("DemoTask1");
         goto err_demotask1;
     }
-    if (xTaskCreate(vDemoTask2, "DemoTask2", mainGENERIC_STACK_SIZE * 2,
-                    NULL, mainGENERIC_PRIORITY, &DemoTask2) != pdPASS) {
+    if (xDemoTaskCreate(vDemoTask2, "DemoTask2", mainGENERIC_STACK_SIZE * 2,
+                        mainGENERIC_PRIORITY, &DemoTask2) != pdPASS) {
         PRINT_TASK_ERROR("DemoTask2");
         goto err_demotask2;
     }
 
     /** SOCKETS */
-    xTaskCreate(vUDPDemoTask, "UDPTask", mainGENERIC_STACK_SIZE * 2, NULL,
-                configMAX_PRIORITIES - 1, &UDPDemoTask);
-    xTaskCreate(vTCPDemoTask, "TCPTask", mainGENERIC_STACK_SIZE, NULL,
-                configMAX_PRIORITIES - 1, &TCPDemoTask);
+    xDemoTaskCreate(vUDPDemoTask, "UDPTask", mainGENERIC_STACK_SIZE * 2,
+                    configMAX_PRIORITIES - 1, &UDPDemoTask);
+    xDemoTaskCreate(vTCPDemoTask, "TCPTask", mainGENERIC_STACK_SIZE,
+                    configMAX_PRIORITIES - 1, &TCPDemoTask);
 
     /** POSIX MESSAGE QUEUES */
-    xTaskCreate(vMQDemoTask, "MQTask", mainGENERIC_STACK_SIZE * 2, NULL,
-                configMAX_PRIORITIES - 1, &MQDemoTask);
-    xTaskCreate(vDemoSendTask, "SendTask", mainGENERIC_STACK_SIZE * 2, NULL,
-                configMAX_PRIORITIES - 1, &DemoSendTask);
+    xDemoTaskCreate(vMQDemoTask, "MQTask", mainGENERIC_STACK_SIZE * 2,
+                    configMAX_PRIORITIES - 1, &MQDemoTask);
+    xDemoTaskCreate(vDemoSendTask, "SendTask", mainGENERIC_STACK_SIZE * 2,
+                    configMAX_PRIORITIES - 1, &DemoSendTask);
 
     vTaskSuspend(DemoTask1);
     vTaskSuspend(DemoTask2);
@@ -799,10 +916,12 @@ err_statemachine:
 err_state_queue:
     vSemaphoreDelete(ScreenLock);
 err_screen_lock:
-    vSemaphoreDelete(DrawSignal);
-err_draw_signal:
+    vEventGroupDelete(DemoEvents);
+err_demo_events:
     vSemaphoreDelete(buttons.lock);
 err_buttons_lock:
+    vBlockPoolFree(buttonInputPool, buttons.buttons);
+err_buttons_table:
     tumSoundExit();
 err_init_audio:
     tumEventExit();
@@ -823,7 +942,8 @@ __attribute__((unused)) void vMainQueueSendPassed(void)
 // cppcheck-suppress unusedFunction
 __attribute__((unused)) void vApplicationIdleHook(void)
 {
-#ifdef __GCC_POSIX__
+    /* With tickless idle the port already sleeps until the next task is due. */
+#if defined(__GCC_POSIX__) && (configUSE_TICKLESS_IDLE == 0)
     struct timespec xTimeToSleep, xTimeSlept;
     /* Makes the process more agreeable when using the Posix simulator. */
     xTimeToSleep.tv_sec = 1;